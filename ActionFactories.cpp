@@ -1,14 +1,23 @@
 #include "ActionFactories.h"
 
+#include "Common/Context.h"
+
 #include "Generators/GeneratorsFactory.h"
 
-#include "Rules/Rule.h"
 #include "Rules/RulesFactory.h"
 
+#include <clang/AST/ASTContext.h>
 #include <clang/ASTMatchers/ASTMatchFinder.h>
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Lex/Preprocessor.h>
 
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <iostream>
+
 using namespace llvm;
 using namespace clang;
 using namespace clang::ast_matchers;
@@ -25,50 +34,166 @@ FrontendAction* ColobotLintASTFrontendActionFactory::create()
 
 ///////////////////////////
 
+void CollectInputFiles(CompilerInstance& ci, std::set<std::string>& inputFiles)
+{
+    for (auto it = ci.getSourceManager().fileinfo_begin(); it != ci.getSourceManager().fileinfo_end(); ++it)
+    {
+        SmallString<256> path(it->first->getName());
+        ci.getFileManager().FixupRelativePath(path);
+        sys::fs::make_absolute(path);
+        inputFiles.insert(path.str());
+    }
+}
+
+///////////////////////////
+
 ColobotLintASTFrontendAction::ColobotLintASTFrontendAction(Context& context)
     : m_context(context),
+      m_requirement(RuleRequirement::AST),
       m_beginSourceFileHandler(context),
-      m_exclusionZoneCommentHandler(context)
+      m_exclusionZoneCommentHandler(context),
+      m_watchdog(context)
 {}
 
 bool ColobotLintASTFrontendAction::BeginSourceFileAction(CompilerInstance& ci, StringRef filename)
 {
+    m_sourceFileStartTimeUs = TraceRecorder::GetCurrentTimeUs();
+    TraceSpan span(m_context.traceRecorder.get(), "BeginSourceFileAction", "phase");
+
     m_exclusionZoneCommentHandler.AtBeginOfMainFile();
+    m_watchdog.AtBeginOfSourceFile(ci);
     return m_beginSourceFileHandler.BeginSourceFileAction(ci, filename);
 }
 
+void ColobotLintASTFrontendAction::EndSourceFileAction()
+{
+    // AST and source buffers only grow during parsing, so their size at the end is the peak memory
+    // used for this source file, regardless of other source files processed on other threads
+    // Files read by Clang are also remembered here, as they are needed to validate cached results
+    CompilerInstance& ci = getCompilerInstance();
+
+    std::size_t memoryUsage = TranslationUnitWatchdog::GetMemoryUsage(ci);
+    if (ci.hasSourceManager())
+    {
+        CollectInputFiles(ci, m_context.translationUnitInputFiles);
+    }
+
+    m_context.translationUnitMemoryUsage = std::max(m_context.translationUnitMemoryUsage, memoryUsage);
+
+    m_watchdog.AtEndOfSourceFile();
+
+    if (m_context.traceRecorder != nullptr)
+    {
+        m_context.traceRecorder->AddSpan(sys::path::filename(getCurrentFile()).str(),
+                                         "source file",
+                                         m_sourceFileStartTimeUs,
+                                         TraceRecorder::GetCurrentTimeUs(),
+                                         getCurrentFile().str());
+    }
+}
+
+void ColobotLintASTFrontendAction::ExecuteAction()
+{
+    if (m_requirement == RuleRequirement::AST)
+    {
+        ASTFrontendAction::ExecuteAction();
+        return;
+    }
+
+    CompilerInstance& ci = getCompilerInstance();
+
+    if (m_context.debug)
+    {
+        std::cerr << "Preprocessing only " << getCurrentFile().str() << std::endl;
+    }
+
+    // lex whole file as in PreprocessOnlyAction, so that comment handlers and preprocessor callbacks get called
+    {
+        TraceSpan span(m_context.traceRecorder.get(), "preprocessing", "phase");
+        Preprocessor& pp = ci.getPreprocessor();
+        pp.IgnorePragmas();
+        pp.EnterMainSourceFile();
+        Token token;
+        unsigned tokenCount = 0;
+        do
+        {
+            pp.Lex(token);
+
+            if ((++tokenCount % 1024) == 0 && !m_watchdog.CheckLimits())
+                return;
+        }
+        while (token.isNot(tok::eof));
+    }
+
+    // rules working on raw text match translation unit declaration, which is there even if nothing was parsed
+    ASTConsumer& consumer = ci.getASTConsumer();
+    consumer.Initialize(ci.getASTContext());
+    consumer.HandleTranslationUnit(ci.getASTContext());
+}
+
+RuleRequirement ColobotLintASTFrontendAction::GetRequirementOfRules(const std::vector<std::unique_ptr<Rule>>& rules)
+{
+    if (rules.empty())
+        return RuleRequirement::AST;
+
+    RuleRequirement requirement = RuleRequirement::RawText;
+    for (const auto& rule : rules)
+    {
+        requirement = std::max(requirement, rule->GetRequirement());
+    }
+
+    // main file is always lexed anyway, as comments are needed for exclusion zones,
+    // and in fake header mode, actual header file is known only after it is included
+    return std::max(requirement, RuleRequirement::Preprocessor);
+}
+
 std::unique_ptr<ASTConsumer> ColobotLintASTFrontendAction::CreateASTConsumer(CompilerInstance& compiler,
                                                                              StringRef /*file*/)
 {
     std::vector<std::unique_ptr<ASTConsumer>> consumers;
 
     auto finder = make_unique<MatchFinder>();
+    auto dispatcher = make_unique<ASTDispatcher>(m_context);
 
     std::vector<std::unique_ptr<Rule>> rules;
 
     std::unique_ptr<Generator> generator = CreateGenerator(m_context);
     if (generator != nullptr)
     {
-        generator->RegisterASTMatcherCallback(*finder.get());
+        // matchers of generators see whole translation unit, including headers
+        if (generator->UsesASTMatchers())
+        {
+            generator->RegisterASTMatcherCallback(*finder.get());
+            consumers.push_back(finder->newASTConsumer());
+        }
     }
     else
     {
         m_exclusionZoneCommentHandler.RegisterPreProcessorCallbacks(compiler);
 
         rules = CreateRules(m_context);
+        m_requirement = GetRequirementOfRules(rules);
         for (auto& rule : rules)
         {
             rule->RegisterASTMatcherCallback(*finder.get());
+            rule->RegisterASTDispatcherCallbacks(*dispatcher.get());
             rule->RegisterPreProcessorCallbacks(compiler);
+
+            if (rule->GetRegisteredMatchCallback() != nullptr)
+                dispatcher->AddMatchCallback(rule->GetRegisteredMatchCallback());
         }
-    }
 
-    consumers.push_back(finder->newASTConsumer());
+        // matchers of rules are run only on nodes in main file, during traversal of AST dispatcher
+        dispatcher->SetMatchFinder(finder.get());
+    }
 
     return make_unique<ColobotLintASTConsumer>(std::move(consumers),
                                                std::move(finder),
+                                               std::move(dispatcher),
                                                std::move(rules),
-                                               std::move(generator));
+                                               std::move(generator),
+                                               m_watchdog,
+                                               m_context.traceRecorder.get());
 }
 
 ///////////////////////////
@@ -76,14 +201,60 @@ std::unique_ptr<ASTConsumer> ColobotLintASTFrontendAction::CreateASTConsumer(Com
 ColobotLintASTConsumer::ColobotLintASTConsumer(
         std::vector<std::unique_ptr<ASTConsumer>>&& consumers,
         std::unique_ptr<MatchFinder>&& finder,
+        std::unique_ptr<ASTDispatcher>&& dispatcher,
         std::vector<std::unique_ptr<Rule>>&& rules,
-        std::unique_ptr<Generator>&& generator)
+        std::unique_ptr<Generator>&& generator,
+        TranslationUnitWatchdog& watchdog,
+        TraceRecorder* traceRecorder)
     : MultiplexConsumer(std::move(consumers)),
       m_finder(std::move(finder)),
+      m_dispatcher(std::move(dispatcher)),
       m_rules(std::move(rules)),
-      m_generator(std::move(generator))
+      m_generator(std::move(generator)),
+      m_watchdog(watchdog),
+      m_traceRecorder(traceRecorder),
+      m_parseStartTimeUs(0)
 {}
 
 ColobotLintASTConsumer::~ColobotLintASTConsumer()
 {}
 
+void ColobotLintASTConsumer::Initialize(ASTContext& context)
+{
+    m_parseStartTimeUs = TraceRecorder::GetCurrentTimeUs();
+    MultiplexConsumer::Initialize(context);
+}
+
+bool ColobotLintASTConsumer::HandleTopLevelDecl(DeclGroupRef declGroup)
+{
+    if (! m_watchdog.CheckLimits())
+        return false;
+
+    return MultiplexConsumer::HandleTopLevelDecl(declGroup);
+}
+
+void ColobotLintASTConsumer::HandleTranslationUnit(ASTContext& context)
+{
+    // preprocessing is interleaved with parsing, so it cannot be traced separately here
+    if (m_traceRecorder != nullptr)
+    {
+        m_traceRecorder->AddSpan("parsing and semantic analysis", "phase",
+                                 m_parseStartTimeUs, TraceRecorder::GetCurrentTimeUs());
+    }
+
+    // template instantiations at the end of translation unit may also take a while
+    if (! m_watchdog.CheckLimits())
+        return;
+
+    TraceSpan span(m_traceRecorder, "AST matching", "phase");
+
+    MultiplexConsumer::HandleTranslationUnit(context);
+
+    if (m_generator != nullptr)
+        m_generator->HandleTranslationUnit(context);
+
+    // matchers and other callbacks of rules are all run from one traversal of main file
+    if (m_dispatcher->HasCallbacks())
+        m_dispatcher->DispatchTranslationUnit(context);
+}
+
@@ -1,16 +1,23 @@
 #pragma once
 
+#include "Handlers/ASTDispatcher.h"
 #include "Handlers/BeginSourceFileHandler.h"
 #include "Handlers/ExclusionZoneCommentHandler.h"
+#include "Handlers/TranslationUnitWatchdog.h"
+
+#include "Rules/Rule.h"
 
 #include <clang/Frontend/MultiplexConsumer.h>
 #include <clang/Tooling/Tooling.h>
 
+#include <cstdint>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
-class Rule;
 class Generator;
+class TraceRecorder;
 
 namespace clang
 {
@@ -34,6 +41,11 @@ private:
 
 /////////////////////////////////////////////////////////////////////////////////
 
+// Adds absolute paths of all files read by compiler instance
+void CollectInputFiles(clang::CompilerInstance& ci, std::set<std::string>& inputFiles);
+
+/////////////////////////////////////////////////////////////////////////////////
+
 // Frontend action for AST checkers - this is created by above factory
 class ColobotLintASTFrontendAction : public clang::ASTFrontendAction
 {
@@ -45,10 +57,20 @@ public:
 
     bool BeginSourceFileAction(clang::CompilerInstance& ci, llvm::StringRef filename) override;
 
+    void EndSourceFileAction() override;
+
+    // If no selected rule needs AST, file is only preprocessed, without parsing
+    void ExecuteAction() override;
+
 private:
+    static RuleRequirement GetRequirementOfRules(const std::vector<std::unique_ptr<Rule>>& rules);
+
     Context &m_context;
+    RuleRequirement m_requirement;
     BeginSourceFileHandler m_beginSourceFileHandler;
     ExclusionZoneCommentHandler m_exclusionZoneCommentHandler;
+    TranslationUnitWatchdog m_watchdog;
+    std::uint64_t m_sourceFileStartTimeUs = 0;
 };
 
 /////////////////////////////////////////////////////////////////////////////////
@@ -59,12 +81,25 @@ class ColobotLintASTConsumer : public clang::MultiplexConsumer
 public:
     ColobotLintASTConsumer(std::vector<std::unique_ptr<ASTConsumer>>&& consumers,
                            std::unique_ptr<clang::ast_matchers::MatchFinder>&& finder,
+                           std::unique_ptr<ASTDispatcher>&& dispatcher,
                            std::vector<std::unique_ptr<Rule>>&& rules,
-                           std::unique_ptr<Generator>&& generator);
+                           std::unique_ptr<Generator>&& generator,
+                           TranslationUnitWatchdog& watchdog,
+                           TraceRecorder* traceRecorder);
     ~ColobotLintASTConsumer();
 
+    void Initialize(clang::ASTContext& context) override;
+
+    // returning false stops parsing of further declarations
+    bool HandleTopLevelDecl(clang::DeclGroupRef declGroup) override;
+    void HandleTranslationUnit(clang::ASTContext& context) override;
+
 private:
     std::unique_ptr<clang::ast_matchers::MatchFinder> m_finder;
+    std::unique_ptr<ASTDispatcher> m_dispatcher;
     std::vector<std::unique_ptr<Rule>> m_rules;
     std::unique_ptr<Generator> m_generator;
+    TranslationUnitWatchdog& m_watchdog;
+    TraceRecorder* m_traceRecorder;
+    std::uint64_t m_parseStartTimeUs;
 };
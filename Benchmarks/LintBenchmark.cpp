@@ -0,0 +1,565 @@
+// Microbenchmarks of helpers which are called for each matched AST node or each violation,
+// and of AST matching itself, so that optimizations of them can be measured and compared between commits
+// Inputs are generated deterministically and each benchmark prints median time per operation of several runs
+
+#include "Common/Context.h"
+#include "Common/OutputPrinter.h"
+#include "Common/RegexHelper.h"
+#include "Common/SourceLocationHelper.h"
+#include "Common/TagTypeAnalyzer.h"
+
+#include "Handlers/ASTDispatcher.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/RecursiveASTVisitor.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/DiagnosticOptions.h>
+#include <clang/Basic/FileManager.h>
+#include <clang/Basic/FileSystemOptions.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Frontend/ASTUnit.h>
+#include <clang/Tooling/Tooling.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace clang;
+using namespace clang::ast_matchers;
+using namespace llvm;
+
+namespace
+{
+
+// results are accumulated here, so that compiler cannot optimize away benchmarked calls
+volatile std::size_t g_sink = 0;
+
+const char* const NULL_OUTPUT_FILE = "/dev/null";
+
+struct BenchmarkOptions
+{
+    int runs = 9;
+    double scale = 1.0; // multiplies number of operations in each run
+    std::string filter; // only benchmarks whose name contains it are run
+};
+
+// Runs operation given number of times in each run; median of several runs is much less sensitive
+// to other processes running on the machine than mean of one long run
+template<typename Operation>
+void RunBenchmark(const BenchmarkOptions& options, const std::string& name, std::size_t count, Operation operation)
+{
+    if (name.find(options.filter) == std::string::npos)
+        return;
+
+    count = std::max<std::size_t>(1, count * options.scale);
+
+    operation(count); // warm-up fills caches and lazily computed data
+
+    std::vector<double> nsPerOperation;
+    for (int run = 0; run < options.runs; ++run)
+    {
+        auto start = std::chrono::steady_clock::now();
+        operation(count);
+        auto end = std::chrono::steady_clock::now();
+        nsPerOperation.push_back(std::chrono::duration<double, std::nano>(end - start).count() / count);
+    }
+
+    std::sort(nsPerOperation.begin(), nsPerOperation.end());
+    std::cout << std::left << std::setw(50) << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << nsPerOperation[nsPerOperation.size() / 2] << " ns/op"
+              << "   (min " << nsPerOperation.front() << ", max " << nsPerOperation.back() << ")" << std::endl;
+}
+
+std::vector<std::string> GenerateRawFilenames(std::size_t count)
+{
+    static const char* directories[] =
+    {
+        "/home/user/colobot/src/object/../object/subsystems/",
+        "/home/user/colobot/build/../src/graphics/engine/./",
+        "/home/user/colobot/src/ui/controls/",
+        "./src/../src/level/parser/",
+        "/usr/include/c++/4.9/bits/../../4.9/",
+    };
+    const std::size_t directoryCount = sizeof(directories) / sizeof(directories[0]);
+
+    std::vector<std::string> filenames;
+    for (std::size_t i = 0; i < count; ++i)
+        filenames.push_back(directories[i % directoryCount] + std::string("file") + std::to_string(i) + ".h");
+    return filenames;
+}
+
+std::vector<std::string> GenerateIdentifiers(std::size_t count)
+{
+    static const char* identifiers[] =
+    {
+        "SomeFunction", "CalculateSomethingVeryComplicated", "someFunction", "Some_Function",
+        "GetX", "ProcessLevelFile2D", "m_someMember", "SOME_CONSTANT", "i", "CObjectManager",
+    };
+    const std::size_t identifierCount = sizeof(identifiers) / sizeof(identifiers[0]);
+
+    std::vector<std::string> result;
+    for (std::size_t i = 0; i < count; ++i)
+        result.push_back(identifiers[i % identifierCount]);
+    return result;
+}
+
+// Source manager with main file and headers entered from it, as after parsing of real source file
+class BenchmarkSourceManager
+{
+public:
+    BenchmarkSourceManager(const std::vector<std::string>& headerNames, int mainFileLineCount)
+        : m_diagnostics(IntrusiveRefCntPtr<DiagnosticIDs>(new DiagnosticIDs()),
+                        new DiagnosticOptions(),
+                        new IgnoringDiagConsumer()),
+          m_fileManager(FileSystemOptions()),
+          m_sourceManager(m_diagnostics, m_fileManager)
+    {
+        std::string mainFileContent;
+        for (int line = 0; line < mainFileLineCount; ++line)
+            mainFileContent += "int someVariable = 0;\n";
+
+        FileID mainFileID = m_sourceManager.createFileID(AddFile("/home/user/colobot/src/main.cpp", mainFileContent),
+                                                         SourceLocation(),
+                                                         SrcMgr::C_User);
+        m_sourceManager.setMainFileID(mainFileID);
+
+        SourceLocation includeLocation = m_sourceManager.getLocForStartOfFile(mainFileID);
+        for (const auto& headerName : headerNames)
+        {
+            FileID headerFileID = m_sourceManager.createFileID(AddFile(headerName, "int x;\n"),
+                                                               includeLocation,
+                                                               SrcMgr::C_User);
+            m_headerLocations.push_back(m_sourceManager.getLocForStartOfFile(headerFileID));
+        }
+
+        for (int line = 1; line <= mainFileLineCount; ++line)
+            m_mainFileLocations.push_back(m_sourceManager.translateLineCol(mainFileID, line, 5));
+    }
+
+    SourceManager& Get() { return m_sourceManager; }
+    const std::vector<SourceLocation>& GetHeaderLocations() const { return m_headerLocations; }
+    const std::vector<SourceLocation>& GetMainFileLocations() const { return m_mainFileLocations; }
+
+private:
+    const FileEntry* AddFile(const std::string& name, const std::string& content)
+    {
+        const FileEntry* entry = m_fileManager.getVirtualFile(name, content.size(), 0);
+        m_sourceManager.overrideFileContents(entry, MemoryBuffer::getMemBufferCopy(content, name));
+        return entry;
+    }
+
+private:
+    DiagnosticsEngine m_diagnostics;
+    FileManager m_fileManager;
+    SourceManager m_sourceManager;
+    std::vector<SourceLocation> m_headerLocations;
+    std::vector<SourceLocation> m_mainFileLocations;
+};
+
+std::unique_ptr<Context> CreateContext(SourceLocationHelper& sourceLocationHelper)
+{
+    auto context = make_unique<Context>(sourceLocationHelper,
+                                        OutputPrinter::Create(OutputFormat::PlainTextReport,
+                                                              NULL_OUTPUT_FILE,
+                                                              {},
+                                                              sourceLocationHelper),
+                                        std::set<std::string>{"/home/user/colobot/src"},
+                                        std::vector<std::string>{},
+                                        std::set<std::string>{},
+                                        "",
+                                        false,
+                                        false);
+    sourceLocationHelper.SetContext(context.get());
+    return context;
+}
+
+void RunSourceLocationBenchmarks(const BenchmarkOptions& options)
+{
+    std::vector<std::string> rawFilenames = GenerateRawFilenames(64);
+    BenchmarkSourceManager sourceManager(rawFilenames, 2000);
+    SourceLocationHelper sourceLocationHelper;
+    std::unique_ptr<Context> context = CreateContext(sourceLocationHelper);
+
+    RunBenchmark(options, "SourceLocationHelper::CleanRawFilename", 200000, [&](std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            g_sink += sourceLocationHelper.CleanRawFilename(rawFilenames[i % rawFilenames.size()]).size();
+    });
+
+    const auto& headerLocations = sourceManager.GetHeaderLocations();
+    RunBenchmark(options, "SourceLocationHelper::GetCleanFilename (cached)", 2000000, [&](std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            SourceLocation location = headerLocations[i % headerLocations.size()];
+            g_sink += sourceLocationHelper.GetCleanFilename(location, sourceManager.Get()).size();
+        }
+    });
+
+    RunBenchmark(options, "SourceLocationHelper::GetCleanFilename (uncached)", 200000, [&](std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i % headerLocations.size() == 0)
+                sourceLocationHelper.ClearCachedData();
+
+            SourceLocation location = headerLocations[i % headerLocations.size()];
+            g_sink += sourceLocationHelper.GetCleanFilename(location, sourceManager.Get()).size();
+        }
+    });
+
+    const auto& mainFileLocations = sourceManager.GetMainFileLocations();
+    auto runLocationOfInterest = [&](std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            SourceLocation location = mainFileLocations[(i * 7) % mainFileLocations.size()];
+            g_sink += sourceLocationHelper.IsLocationOfInterest("FunctionNamingRule", location, sourceManager.Get());
+        }
+    };
+
+    RunBenchmark(options, "IsLocationOfInterest (no exclusion zones)", 2000000, runLocationOfInterest);
+
+    // exclusion zone of one rule on every tenth line, as in heavily annotated source files
+    for (int line = 1; line <= 2000; line += 10)
+        context->exclusionZones.insert(ExclusionZone{line, "VariableNamingRule"});
+
+    RunBenchmark(options, "IsLocationOfInterest (200 exclusion zones)", 2000000, runLocationOfInterest);
+}
+
+void RunRegexBenchmarks(const BenchmarkOptions& options)
+{
+    std::vector<std::string> identifiers = GenerateIdentifiers(1000);
+
+    struct PatternInfo
+    {
+        const char* name;
+        boost::regex pattern;
+    };
+    std::vector<PatternInfo> patterns =
+    {
+        { "regex_match UPPER_CAMEL_CASE_PATTERN", boost::regex(UPPER_CAMEL_CASE_PATTERN) },
+        { "regex_match LOWER_CAMEL_CASE_PATTERN", boost::regex(LOWER_CAMEL_CASE_PATTERN) },
+        { "regex_match ALL_CAPS_UNDERSCORE_PATTERN", boost::regex(ALL_CAPS_UNDERSCORE_PATTERN) },
+        { "regex_match m_ + LOWER_CAMEL_CASE_PATTERN", boost::regex(std::string("m_") + LOWER_CAMEL_CASE_PATTERN) },
+    };
+
+    for (const auto& pattern : patterns)
+    {
+        RunBenchmark(options, pattern.name, 500000, [&](std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                StringRef name = identifiers[i % identifiers.size()];
+                g_sink += boost::regex_match(name.begin(), name.end(), pattern.pattern);
+            }
+        });
+    }
+}
+
+std::vector<OutputFilter> GenerateOutputFilters(std::size_t count)
+{
+    std::vector<OutputFilter> filters;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        OutputFilter filter;
+        filter.fileName = "src/file" + std::to_string(i) + ".cpp";
+        filter.startLineNumber = 10;
+        filter.endLineNumber = 20;
+        filters.push_back(filter);
+    }
+    return filters;
+}
+
+void RunOutputPrinterBenchmarks(const BenchmarkOptions& options)
+{
+    SourceLocationHelper sourceLocationHelper;
+
+    // filtered out violations are not printed, so this measures only ShouldPrintLine
+    for (std::size_t filterCount : {10, 1000})
+    {
+        auto printer = OutputPrinter::Create(OutputFormat::PlainTextReport,
+                                             NULL_OUTPUT_FILE,
+                                             GenerateOutputFilters(filterCount),
+                                             sourceLocationHelper);
+        std::string name = "OutputPrinter::ShouldPrintLine (" + std::to_string(filterCount) + " filters)";
+        RunBenchmark(options, name, 2000000 / filterCount, [&](std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                printer->PrintRuleViolation("WhitespaceRule", Severity::Style, "Whitespace at end of line",
+                                            "/home/user/colobot/src/not_filtered.cpp", i % 100);
+        });
+    }
+
+    struct PrinterInfo
+    {
+        const char* name;
+        OutputFormat format;
+    };
+    std::vector<PrinterInfo> printers =
+    {
+        { "plain text printer (violation + Save)", OutputFormat::PlainTextReport },
+        { "XML printer (violation + Save)", OutputFormat::XmlReport },
+    };
+
+    for (const auto& printerInfo : printers)
+    {
+        RunBenchmark(options, printerInfo.name, 100000, [&](std::size_t count)
+        {
+            auto printer = OutputPrinter::Create(printerInfo.format, NULL_OUTPUT_FILE, {}, sourceLocationHelper);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                printer->PrintRuleViolation("FunctionNamingRule", Severity::Style,
+                                            "Function 'some_function' should be named in UpperCamelCase style",
+                                            "/home/user/colobot/src/object/object.cpp", i % 5000 + 1);
+            }
+            printer->Save();
+        });
+    }
+}
+
+// Header stands for project and standard library headers, which make up most of AST of typical translation unit
+std::string GenerateHeaderSource(std::size_t classCount)
+{
+    std::string source;
+    for (std::size_t i = 0; i < classCount; ++i)
+    {
+        std::string className = "CHeaderClass" + std::to_string(i);
+        source += "class " + className + "\n"
+                  "{\n"
+                  "public:\n"
+                  "    int Calculate(int value)\n"
+                  "    {\n"
+                  "        int result = value * 2;\n"
+                  "        for (int j = 0; j < value; ++j)\n"
+                  "            result += m_values[j % 4] != 0 ? j : -j;\n"
+                  "        return result;\n"
+                  "    }\n"
+                  "    int m_values[4];\n"
+                  "};\n"
+                  "inline int Use" + className + "(" + className + "* object)\n"
+                  "{\n"
+                  "    return object != 0 ? object->Calculate(" + std::to_string(i) + ") : 0;\n"
+                  "}\n";
+    }
+    return source;
+}
+
+std::string GenerateMainFileSource(const std::string& headerPath, std::size_t functionCount)
+{
+    std::string source = "#include \"" + headerPath + "\"\n";
+    for (std::size_t i = 0; i < functionCount; ++i)
+    {
+        std::string className = "CHeaderClass" + std::to_string(i);
+        source += "int MainFunction" + std::to_string(i) + "(" + className + "& object)\n"
+                  "{\n"
+                  "    int* values = new int[2];\n"
+                  "    values[0] = object.Calculate(1);\n"
+                  "    values[1] = Use" + className + "(&object);\n"
+                  "    int sum = values[0] + values[1];\n"
+                  "    delete[] values;\n"
+                  "    return sum;\n"
+                  "}\n";
+    }
+    return source;
+}
+
+class CountingMatchCallback : public MatchFinder::MatchCallback
+{
+public:
+    void run(const MatchFinder::MatchResult& /*result*/) override
+    {
+        ++g_sink;
+    }
+};
+
+// the same kinds of matchers as rules register
+void AddMatchersOfRules(MatchFinder& finder, MatchFinder::MatchCallback* callback)
+{
+    finder.addMatcher(functionDecl(unless(anyOf(isExpansionInSystemHeader(), isImplicit()))).bind("functionDecl"),
+                      callback);
+    finder.addMatcher(varDecl(unless(isExpansionInSystemHeader())).bind("varDecl"), callback);
+    finder.addMatcher(recordDecl().bind("recordDecl"), callback);
+    finder.addMatcher(valueDecl().bind("valueDecl"), callback);
+    finder.addMatcher(declRefExpr().bind("declRefExpr"), callback);
+    finder.addMatcher(expr().bind("expr"), callback);
+    finder.addMatcher(implicitCastExpr(unless(isExpansionInSystemHeader())).bind("implicitCastExpr"), callback);
+    finder.addMatcher(newExpr(unless(isExpansionInSystemHeader())).bind("new"), callback);
+    finder.addMatcher(deleteExpr(unless(isExpansionInSystemHeader())).bind("delete"), callback);
+    finder.addMatcher(typeLoc(unless(isExpansionInSystemHeader()), loc(tagType())).bind("tagTypeLoc"), callback);
+}
+
+// Matching of whole translation unit in one traversal of MatchFinder, against matching of each node
+// of main file separately in traversal of AST dispatcher, as rules do
+void RunASTMatchingBenchmarks(const BenchmarkOptions& options)
+{
+    SmallString<128> headerPath;
+    int headerFd = -1;
+    if (sys::fs::createTemporaryFile("colobot-lint-bench", "h", headerFd, headerPath))
+    {
+        std::cerr << "Could not create temporary header file" << std::endl;
+        return;
+    }
+
+    {
+        raw_fd_ostream headerStream(headerFd, true);
+        headerStream << GenerateHeaderSource(2000);
+    }
+
+    std::string mainFileSource = GenerateMainFileSource(headerPath.str().str(), 20);
+    std::unique_ptr<ASTUnit> ast = tooling::buildASTFromCodeWithArgs(mainFileSource, {"-std=c++11"}, "main.cpp");
+    if (ast == nullptr)
+    {
+        std::cerr << "Could not parse generated source file" << std::endl;
+        sys::fs::remove(headerPath.str());
+        return;
+    }
+
+    ASTContext& astContext = ast->getASTContext();
+
+    CountingMatchCallback callback;
+    MatchFinder finder;
+    AddMatchersOfRules(finder, &callback);
+
+    RunBenchmark(options, "MatchFinder::matchAST (whole translation unit)", 10, [&](std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            finder.matchAST(astContext);
+    });
+
+    SourceLocationHelper sourceLocationHelper;
+    auto context = CreateContext(sourceLocationHelper);
+    ASTDispatcher dispatcher(*context);
+    dispatcher.SetMatchFinder(&finder);
+    dispatcher.AddMatchCallback(&callback);
+
+    RunBenchmark(options, "ASTDispatcher matching (main file only)", 10, [&](std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            dispatcher.DispatchTranslationUnit(astContext);
+    });
+
+    sys::fs::remove(headerPath.str());
+}
+
+// Expressions and declarations referring to the same few classes through pointers, typedefs and templates,
+// as code seen by PossibleForwardDeclarationRule, which analyzes type of each of them
+std::string GenerateTagTypeSource(std::size_t classCount)
+{
+    std::string source = "template<typename T> class CHolder { public: T* value; };\n";
+    for (std::size_t i = 0; i < classCount; ++i)
+    {
+        std::string className = "CItem" + std::to_string(i);
+        source += "class " + className + " { public: int Get() { return " + std::to_string(i) + "; } };\n"
+                  "typedef " + className + "* " + className + "Ptr;\n"
+                  "int Use" + className + "(" + className + "& item, " + className + "Ptr pointer, "
+                  "CHolder<" + className + "> holder)\n"
+                  "{\n"
+                  "    " + className + "* other = &item;\n"
+                  "    return item.Get() + pointer->Get() + holder.value->Get() + other->Get() +\n"
+                  "           (pointer != 0 ? pointer : other)->Get();\n"
+                  "}\n";
+    }
+    return source;
+}
+
+class TypeCollector : public RecursiveASTVisitor<TypeCollector>
+{
+public:
+    bool VisitValueDecl(ValueDecl* declaration)
+    {
+        types.push_back(declaration->getType());
+        return true;
+    }
+
+    bool VisitExpr(Expr* expression)
+    {
+        types.push_back(expression->getType());
+        return true;
+    }
+
+    std::vector<QualType> types;
+};
+
+// Analysis of types of all expressions and value declarations with cache kept for whole translation unit,
+// against cache cleared before each type, which stands for analysis without cache
+void RunTagTypeAnalyzerBenchmarks(const BenchmarkOptions& options)
+{
+    std::string source = GenerateTagTypeSource(100);
+    std::unique_ptr<ASTUnit> ast = tooling::buildASTFromCodeWithArgs(source, {"-std=c++11"}, "main.cpp");
+    if (ast == nullptr)
+    {
+        std::cerr << "Could not parse generated source file" << std::endl;
+        return;
+    }
+
+    TypeCollector collector;
+    collector.TraverseDecl(ast->getASTContext().getTranslationUnitDecl());
+    SourceManager& sourceManager = ast->getSourceManager();
+
+    TagTypeAnalyzer analyzer;
+
+    RunBenchmark(options, "TagTypeAnalyzer::Analyze (cached)", 100, [&](std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (const auto& type : collector.types)
+                g_sink += analyzer.Analyze(type, sourceManager).tagDeclaration != nullptr;
+        }
+    });
+
+    RunBenchmark(options, "TagTypeAnalyzer::Analyze (cache cleared)", 100, [&](std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (const auto& type : collector.types)
+            {
+                analyzer.Clear();
+                g_sink += analyzer.Analyze(type, sourceManager).tagDeclaration != nullptr;
+            }
+        }
+    });
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "-runs") == 0 && i + 1 < argc)
+            options.runs = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "-scale") == 0 && i + 1 < argc)
+            options.scale = std::strtod(argv[++i], nullptr);
+        else if (std::strcmp(argv[i], "-filter") == 0 && i + 1 < argc)
+            options.filter = argv[++i];
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [-runs N] [-scale X] [-filter substring]" << std::endl;
+            return 1;
+        }
+    }
+
+    RunSourceLocationBenchmarks(options);
+    RunRegexBenchmarks(options);
+    RunOutputPrinterBenchmarks(options);
+    RunASTMatchingBenchmarks(options);
+    RunTagTypeAnalyzerBenchmarks(options);
+
+    return 0;
+}
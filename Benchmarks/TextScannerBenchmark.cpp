@@ -0,0 +1,142 @@
+// Compares text scanning kernels with byte-by-byte loop formerly used by WhitespaceRule
+// on generated source text of several megabytes
+
+#include "Common/TextScanner.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct ScanSummary
+{
+    int lineCount = 0;
+    int trailingWhitespaceCount = 0;
+    int tabCount = 0;
+
+    bool operator==(const ScanSummary& other) const
+    {
+        return lineCount == other.lineCount &&
+               trailingWhitespaceCount == other.trailingWhitespaceCount &&
+               tabCount == other.tabCount;
+    }
+};
+
+std::string GenerateSourceText(std::size_t size)
+{
+    static const char* lines[] =
+    {
+        "#include \"common/global.h\"",
+        "",
+        "void CSomeClass::SomeFunction(int firstParameter, float secondParameter)",
+        "{",
+        "    if (firstParameter > 0 && secondParameter < 1.0f)   ",
+        "    {",
+        "        m_someMember = CalculateSomething(firstParameter) * secondParameter;",
+        "\t\treturn;",
+        "    }",
+        "    // comment explaining what happens in the next few lines of this function ",
+        "}",
+    };
+    const std::size_t lineCount = sizeof(lines) / sizeof(lines[0]);
+
+    std::string text;
+    text.reserve(size + 100);
+    for (std::size_t i = 0; text.size() < size; ++i)
+    {
+        text += lines[i % lineCount];
+        text += '\n';
+    }
+    return text;
+}
+
+ScanSummary ScanBytewise(const std::string& text)
+{
+    ScanSummary summary;
+    bool haveWhitespace = false;
+    int numberOfTabs = 0;
+    for (char ch : text)
+    {
+        if (ch == '\n')
+        {
+            ++summary.lineCount;
+            summary.trailingWhitespaceCount += haveWhitespace ? 1 : 0;
+            summary.tabCount += (numberOfTabs > 0) ? 1 : 0;
+            haveWhitespace = false;
+            numberOfTabs = 0;
+            continue;
+        }
+
+        if (ch == '\t')
+        {
+            ++numberOfTabs;
+            haveWhitespace = true;
+            continue;
+        }
+
+        haveWhitespace = (ch == ' ');
+    }
+    return summary;
+}
+
+ScanSummary ScanWithKernel(const std::string& text, TextScanKernel kernel)
+{
+    ScanSummary summary;
+    for (const auto& line : ScanTextLines(text, std::numeric_limits<std::size_t>::max(), kernel))
+    {
+        ++summary.lineCount;
+        summary.trailingWhitespaceCount += line.Has(TextLine_TrailingWhitespace) ? 1 : 0;
+        summary.tabCount += line.Has(TextLine_HasTab) ? 1 : 0;
+    }
+    return summary;
+}
+
+template<typename ScanFunction>
+ScanSummary RunBenchmark(const char* name, const std::string& text, int iterations, ScanFunction scan)
+{
+    ScanSummary summary;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+        summary = scan();
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double megabytes = static_cast<double>(text.size()) * iterations / (1024 * 1024);
+    std::cout << name << ": " << megabytes / seconds << " MB/s" << std::endl;
+    return summary;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t megabytes = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 8;
+    int iterations = (argc > 2) ? std::atoi(argv[2]) : 20;
+
+    std::string text = GenerateSourceText(megabytes * 1024 * 1024);
+
+    ScanSummary expected = RunBenchmark("bytewise loop", text, iterations, [&]() { return ScanBytewise(text); });
+
+    std::vector<TextScanKernel> kernels = { TextScanKernel::Scalar, TextScanKernel::SSE2 };
+    if (GetBestTextScanKernel() == TextScanKernel::AVX2)
+        kernels.push_back(TextScanKernel::AVX2);
+
+    bool allMatch = true;
+    for (TextScanKernel kernel : kernels)
+    {
+        std::string name = std::string(GetTextScanKernelName(kernel)) + " kernel";
+        ScanSummary summary = RunBenchmark(name.c_str(), text, iterations,
+                                           [&]() { return ScanWithKernel(text, kernel); });
+        if (!(summary == expected))
+        {
+            std::cerr << name << " gives different results than bytewise loop!" << std::endl;
+            allMatch = false;
+        }
+    }
+
+    return allMatch ? 0 : 1;
+}
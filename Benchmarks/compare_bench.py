@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+# Runs colobot-lint-bench built before and after a change with the same options and prints medians
+# of both side by side, in plain text suitable for commit messages
+import argparse
+import re
+import subprocess
+import sys
+
+BENCHMARK_LINE_PATTERN = re.compile(r'^(.*?)\s+([0-9.]+) ns/op')
+
+# Returns list of (benchmark name, median ns/op) in order in which benchmarks were run
+def run_bench(bench_executable, bench_options):
+    command = [bench_executable] + bench_options
+    try:
+        output = subprocess.check_output(command, universal_newlines = True)
+    except (OSError, subprocess.CalledProcessError) as error:
+        sys.stderr.write('Could not run {}: {}\n'.format(' '.join(command), error))
+        sys.exit(1)
+
+    results = []
+    for line in output.splitlines():
+        match = BENCHMARK_LINE_PATTERN.match(line)
+        if match:
+            results.append((match.group(1), float(match.group(2))))
+    return results
+
+def print_comparison(before_results, after_results):
+    before_by_name = dict(before_results)
+    after_by_name = dict(after_results)
+
+    # benchmarks added by the change are listed too, after those which exist in both builds
+    names = [name for name, _ in before_results]
+    names += [name for name, _ in after_results if name not in before_by_name]
+
+    name_width = max([len(name) for name in names] + [len('Benchmark')])
+    print('{:<{width}} {:>12} {:>12} {:>8}'.format('Benchmark', 'before ns/op', 'after ns/op', 'change',
+                                                   width = name_width))
+    for name in names:
+        before = before_by_name.get(name)
+        after = after_by_name.get(name)
+        change = ''
+        if before is not None and after is not None and before > 0:
+            change = '{:+.1f}%'.format((after - before) / before * 100.0)
+        print('{:<{width}} {:>12} {:>12} {:>8}'.format(
+            name,
+            '{:.1f}'.format(before) if before is not None else '-',
+            '{:.1f}'.format(after) if after is not None else '-',
+            change,
+            width = name_width))
+
+def main():
+    parser = argparse.ArgumentParser(description = 'Compare results of colobot-lint-bench of two builds')
+    parser.add_argument('--before', required = True, help = 'colobot-lint-bench built before the change')
+    parser.add_argument('--after', required = True, help = 'colobot-lint-bench built with the change')
+    parser.add_argument('--runs', type = int, default = 9)
+    parser.add_argument('--scale', type = float, default = 1.0)
+    parser.add_argument('--filter', default = '', help = 'run only benchmarks whose name contains it')
+    args = parser.parse_args()
+
+    bench_options = ['-runs', str(args.runs), '-scale', str(args.scale)]
+    if args.filter:
+        bench_options += ['-filter', args.filter]
+
+    print_comparison(run_bench(args.before, bench_options), run_bench(args.after, bench_options))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+# Runs colobot-lint on synthetic projects of increasing size and prints throughput and peak memory,
+# to see how processing scales beyond the small inputs used in tests
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+import synthetic_project
+
+class BenchmarkResult:
+    def __init__(self, headers, source_files, lines, seconds, peak_rss_kb):
+        self.headers = headers
+        self.source_files = source_files
+        self.lines = lines
+        self.seconds = seconds
+        self.peak_rss_kb = peak_rss_kb
+
+    def source_files_per_second(self):
+        return self.source_files / self.seconds
+
+    def lines_per_second(self):
+        return self.lines / self.seconds
+
+    def to_json(self):
+        return {
+            'headers': self.headers,
+            'sourceFiles': self.source_files,
+            'lines': self.lines,
+            'seconds': self.seconds,
+            'sourceFilesPerSecond': self.source_files_per_second(),
+            'linesPerSecond': self.lines_per_second(),
+            'peakRssKb': self.peak_rss_kb
+        }
+
+# Returns wall time and peak RSS of colobot-lint process; with worker processes, RSS reported by wait4
+# is the maximum of the main process and its workers
+def run_colobot_lint(colobot_lint_executable, project, additional_options):
+    command = ([colobot_lint_executable] +
+               ['-p', project.build_directory] +
+               ['-output-format', 'xml', '-output-file', os.devnull] +
+               additional_options +
+               project.source_file_names)
+
+    start_time = time.time()
+    process = subprocess.Popen(command, stdout = subprocess.DEVNULL)
+    _, status, rusage = os.wait4(process.pid, 0)
+    seconds = time.time() - start_time
+
+    if status != 0:
+        sys.stderr.write('colobot-lint failed with status {}: {}\n'.format(status, ' '.join(command)))
+        sys.exit(1)
+
+    return seconds, rusage.ru_maxrss
+
+def run_benchmark(colobot_lint_executable, size, repetitions, additional_options, keep_projects):
+    build_directory = tempfile.mkdtemp()
+    try:
+        project = synthetic_project.generate_project(build_directory, size)
+
+        # fastest of several runs is least affected by other processes
+        runs = [run_colobot_lint(colobot_lint_executable, project, additional_options)
+                for _ in range(repetitions)]
+        seconds = min(run[0] for run in runs)
+        peak_rss_kb = max(run[1] for run in runs)
+
+        return BenchmarkResult(size.headers, len(project.source_file_names), project.line_count,
+                               seconds, peak_rss_kb)
+    finally:
+        if keep_projects:
+            print('Generated project left in: ' + build_directory)
+        else:
+            shutil.rmtree(build_directory)
+
+def print_header():
+    print('{:>8} {:>8} {:>10} {:>10} {:>10} {:>12} {:>14}'.format(
+        'headers', 'TUs', 'lines', 'time [s]', 'TUs/s', 'lines/s', 'peak RSS [MB]'))
+
+def print_result(result):
+    print('{:>8} {:>8} {:>10} {:>10.2f} {:>10.1f} {:>12.0f} {:>14.1f}'.format(
+        result.headers,
+        result.source_files,
+        result.lines,
+        result.seconds,
+        result.source_files_per_second(),
+        result.lines_per_second(),
+        result.peak_rss_kb / 1024.0))
+    sys.stdout.flush()
+
+if __name__ == '__main__':
+    # unknown options are passed to colobot-lint, e.g. -j 4 or -only-rule FunctionNamingRule
+    parser = argparse.ArgumentParser(description = 'Measure how colobot-lint scales with size of project')
+    parser.add_argument('--colobot-lint-exec', dest = 'colobot_lint_executable', default = 'colobot-lint')
+    parser.add_argument('--sizes', default = '10,50,200',
+                        help = 'comma separated numbers of headers of generated projects')
+    parser.add_argument('--repetitions', type = int, default = 3)
+    parser.add_argument('--output-json', help = 'also save results to given file')
+    parser.add_argument('--keep-projects', action = 'store_true',
+                        help = 'do not remove generated projects')
+    synthetic_project.add_size_arguments(parser, with_headers = False)
+    args, colobot_lint_options = parser.parse_known_args()
+
+    print_header()
+    results = []
+    for headers in [int(size) for size in args.sizes.split(',')]:
+        size = synthetic_project.size_from_arguments(args, headers = headers)
+        results.append(run_benchmark(args.colobot_lint_executable, size, args.repetitions,
+                                     colobot_lint_options, args.keep_projects))
+        print_result(results[-1])
+
+    if args.output_json:
+        with open(args.output_json, 'w') as f:
+            json.dump([result.to_json() for result in results], f, indent = 2)
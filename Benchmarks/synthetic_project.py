@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+# Generates synthetic C++ project of configurable size together with its compile_commands.json,
+# so that colobot-lint can be run on inputs much bigger than the ones in tests
+import argparse
+import os
+
+class ProjectSize:
+    def __init__(self,
+                 headers = 20,
+                 classes_per_header = 2,
+                 include_fanout = 3,
+                 functions_per_class = 5,
+                 statements_per_function = 10,
+                 expressions_per_statement = 1):
+        self.headers = headers
+        self.classes_per_header = classes_per_header
+        self.include_fanout = include_fanout
+        self.functions_per_class = functions_per_class
+        self.statements_per_function = statements_per_function
+        self.expressions_per_statement = expressions_per_statement
+
+class GeneratedProject:
+    def __init__(self, build_directory, source_file_names, line_count):
+        self.build_directory = build_directory
+        self.source_file_names = source_file_names
+        self.line_count = line_count # lines of all generated headers and source files
+
+def class_name(header_index, class_index):
+    return 'CGenerated{}Class{}'.format(header_index, class_index)
+
+def header_name(header_index):
+    return 'generated{}.h'.format(header_index)
+
+# Each header includes up to include_fanout previous headers, so include graph is deep and overlapping as in real projects
+def included_headers(header_index, size):
+    first = max(0, header_index - size.include_fanout)
+    return [header_name(index) for index in range(first, header_index)]
+
+def generate_header_lines(header_index, size):
+    lines = ['#pragma once', '']
+    lines += ['#include "{}"'.format(name) for name in included_headers(header_index, size)]
+    lines.append('')
+
+    for class_index in range(size.classes_per_header):
+        lines += [
+            'class {}'.format(class_name(header_index, class_index)),
+            '{',
+            'public:'
+        ]
+        lines += ['    int Function{}(int parameter);'.format(function_index)
+                  for function_index in range(size.functions_per_class)]
+        lines += [
+            '',
+            'private:',
+            '    int m_value = 0;',
+            '};',
+            ''
+        ]
+
+    return lines
+
+def generate_statement_lines(statement_index, size):
+    if statement_index % 3 == 0:
+        # additional terms make expression-heavy code, with member accesses through pointer to class from header
+        terms = ['m_value * {}'.format(statement_index)]
+        terms += ['this->m_value * {}'.format(statement_index + term_index)
+                  for term_index in range(1, size.expressions_per_statement)]
+        return ['    int value{} = parameter + {};'.format(statement_index, ' + '.join(terms))]
+    elif statement_index % 3 == 1:
+        return [
+            '    if (parameter > {})'.format(statement_index),
+            '    {',
+            '        m_value += parameter;',
+            '    }'
+        ]
+    else:
+        return [
+            '    for (int i = 0; i < {}; ++i)'.format(statement_index),
+            '    {',
+            '        parameter -= i;',
+            '    }'
+        ]
+
+def generate_source_lines(header_index, size):
+    lines = ['#include "{}"'.format(header_name(header_index)), '']
+
+    for class_index in range(size.classes_per_header):
+        for function_index in range(size.functions_per_class):
+            lines += [
+                'int {}::Function{}(int parameter)'.format(class_name(header_index, class_index), function_index),
+                '{'
+            ]
+            for statement_index in range(size.statements_per_function):
+                lines += generate_statement_lines(statement_index, size)
+            lines += [
+                '    return parameter;',
+                '}',
+                ''
+            ]
+
+    return lines
+
+def write_file_lines(file_name, lines):
+    with open(file_name, 'w') as f:
+        f.write('\n'.join(lines))
+        f.write('\n')
+
+# same format as write_compilation_database in Tests/test_support.py
+def write_compilation_database(build_directory,
+                               source_file_names,
+                               additional_compile_flags = []):
+    compilation_database_file_name = os.path.join(build_directory, 'compile_commands.json')
+    with open(compilation_database_file_name, 'w') as f:
+        f.write("[\n")
+
+        comma = False
+
+        for source_file_name in source_file_names:
+            if comma:
+                f.write(",")
+
+            f.write(r"""
+                {{
+                    "directory": "{build_directory}",
+                    "command": "/usr/bin/c++ -c -std=c++11 {additional_compile_flags} {source_file_name} -o {source_file_name}.o",
+                    "file": "{source_file_name}"
+                }}
+                """.format(
+                    build_directory = build_directory,
+                    additional_compile_flags = ' '.join(additional_compile_flags),
+                    source_file_name = source_file_name))
+
+            comma = True
+
+        f.write("]\n")
+
+def generate_project(build_directory, size):
+    source_directory = os.path.join(build_directory, 'src')
+    if not os.path.isdir(source_directory):
+        os.makedirs(source_directory)
+
+    source_file_names = []
+    line_count = 0
+    for header_index in range(size.headers):
+        header_lines = generate_header_lines(header_index, size)
+        write_file_lines(os.path.join(source_directory, header_name(header_index)), header_lines)
+
+        source_file_name = os.path.join(source_directory, 'generated{}.cpp'.format(header_index))
+        source_lines = generate_source_lines(header_index, size)
+        write_file_lines(source_file_name, source_lines)
+
+        source_file_names.append(source_file_name)
+        line_count += len(header_lines) + len(source_lines)
+
+    write_compilation_database(build_directory = build_directory,
+                               source_file_names = source_file_names,
+                               additional_compile_flags = ['-I' + source_directory])
+
+    return GeneratedProject(build_directory, source_file_names, line_count)
+
+def add_size_arguments(parser, with_headers = True):
+    defaults = ProjectSize()
+    if with_headers:
+        parser.add_argument('--headers', type = int, default = defaults.headers,
+                            help = 'number of headers; each has one source file')
+    parser.add_argument('--classes-per-header', type = int, default = defaults.classes_per_header)
+    parser.add_argument('--include-fanout', type = int, default = defaults.include_fanout,
+                        help = 'number of other headers included by each header')
+    parser.add_argument('--functions-per-class', type = int, default = defaults.functions_per_class)
+    parser.add_argument('--statements-per-function', type = int, default = defaults.statements_per_function)
+    parser.add_argument('--expressions-per-statement', type = int, default = defaults.expressions_per_statement,
+                        help = 'number of terms in generated arithmetic expressions')
+
+def size_from_arguments(args, headers = None):
+    return ProjectSize(headers = args.headers if headers is None else headers,
+                       classes_per_header = args.classes_per_header,
+                       include_fanout = args.include_fanout,
+                       functions_per_class = args.functions_per_class,
+                       statements_per_function = args.statements_per_function,
+                       expressions_per_statement = args.expressions_per_statement)
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description = 'Generate synthetic C++ project with compile_commands.json')
+    parser.add_argument('build_directory')
+    add_size_arguments(parser)
+    args = parser.parse_args()
+
+    project = generate_project(os.path.realpath(args.build_directory), size_from_arguments(args))
+    print('Generated {} source files with {} lines in total'.format(len(project.source_file_names),
+                                                                      project.line_count))
@@ -4,11 +4,22 @@
 
 #include "Common/Context.h"
 #include "Common/OutputPrinter.h"
+#include "Common/RuleProfiler.h"
 #include "Common/SourceLocationHelper.h"
+#include "Common/TraceRecorder.h"
+
+#include "Driver/DiffReader.h"
+#include "Driver/LintDaemon.h"
+#include "Driver/ParallelLintRunner.h"
+#include "Driver/RawTextLintRunner.h"
+#include "Driver/ReportMerger.h"
 
 #include "Handlers/DiagnosticHandler.h"
 
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallString.h>
 #include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
 #include <clang/Tooling/CommonOptionsParser.h>
 
 #include <iostream>
@@ -47,6 +58,27 @@ static cl::list<std::string> g_outputFilterOpt(
     value_desc("file1@start:end"),
     cat(g_colobotLintOptionCategory));
 
+static cl::opt<std::string> g_diffFileOpt(
+    "diff-file",
+    desc("Unified diff (e.g. from git diff -U0, with paths relative to current directory); only changed lines "
+         "are reported and source files not affected by changed files are skipped"),
+    value_desc("filename"),
+    cat(g_colobotLintOptionCategory));
+
+static cl::list<std::string> g_changedFilesOpt(
+    "changed-files",
+    desc("Process only source files which are among given files or include any of them"),
+    value_desc("file1,file2,..."),
+    CommaSeparated,
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<std::string> g_includeIndexFileOpt(
+    "include-index-file",
+    desc("File with files included by each source file, used to quickly find source files affected by changes "
+         "given with -changed-files or -diff-file; it is updated after each run"),
+    value_desc("filename"),
+    cat(g_colobotLintOptionCategory));
+
 static cl::opt<std::string> g_outputFormat(
     "output-format",
     desc("Format of output: plain text or XML"),
@@ -84,6 +116,135 @@ static cl::opt<std::string> g_generatorSelectionOpt(
     value_desc("graph-type"),
     cat(g_colobotLintOptionCategory));
 
+static cl::opt<unsigned> g_jobsOpt(
+    "j",
+    desc("Number of source files to process in parallel; by default, number of available CPUs"),
+    value_desc("N"),
+    init(0),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<std::string> g_shardOpt(
+    "shard",
+    desc("Process only i-th of N parts of source files; shard reports can be combined with -merge"),
+    value_desc("i/N"),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<std::string> g_timingHistoryFileOpt(
+    "timing-history-file",
+    desc("File with processing times of source files from previous runs, used to process longest ones first; "
+         "it is updated after each run"),
+    value_desc("filename"),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<std::string> g_cacheDirOpt(
+    "cache-dir",
+    desc("Directory where results of source files are cached, to be reused as long as source file "
+         "and headers it includes are not changed; it may be shared between runs"),
+    value_desc("path"),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<unsigned> g_cacheMaxSizeOpt(
+    "cache-max-size",
+    desc("Maximum size of cache directory in MB; least recently used results are removed above this limit"),
+    value_desc("MB"),
+    init(1024),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<bool> g_lintHeadersOpt(
+    "lint-headers",
+    desc("Check header files given as source files for self-containment and other header rules, "
+         "using compile commands of source files next to them"),
+    init(false),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<bool> g_reusePreamblesOpt(
+    "reuse-preambles",
+    desc("Precompile include directives at the beginning of source files once for all source files which "
+         "share them; headers included this way must have include guards"),
+    init(false),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<bool> g_profileRulesOpt(
+    "profile-rules",
+    desc("Measure time spent in each rule across all source files and print it as a table sorted by time"),
+    init(false),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<std::string> g_profileRulesFileOpt(
+    "profile-rules-file",
+    desc("Measure time spent in each rule across all source files and save it to given file in JSON format"),
+    value_desc("filename"),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<std::string> g_traceFileOpt(
+    "trace-file",
+    desc("Record phases of processing of each source file and save them to given file in Chrome trace event format"),
+    value_desc("filename"),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<bool> g_statsOpt(
+    "stats",
+    desc("Print counters of work done while processing source files, such as location checks, "
+         "file name cache hits and matches of each rule"),
+    init(false),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<bool> g_workerProcessesOpt(
+    "worker-processes",
+    desc("Process source files in forked worker processes instead of threads, so that a crash on one source file "
+         "is reported as lint crash and the rest of source files is still processed"),
+    init(false),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<double> g_tuTimeLimitOpt(
+    "tu-time-limit",
+    desc("Abort processing of source file after given number of seconds, reporting it as lint timeout, "
+         "and continue with other source files"),
+    value_desc("seconds"),
+    init(0.0),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<double> g_tuSoftTimeLimitOpt(
+    "tu-soft-time-limit",
+    desc("Print a warning about source files processed longer than given number of seconds"),
+    value_desc("seconds"),
+    init(0.0),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<unsigned> g_tuMemoryLimitOpt(
+    "tu-memory-limit",
+    desc("Abort processing of source file when memory used by parser exceeds given size in MB, "
+         "reporting it as lint memory limit, and continue with other source files"),
+    value_desc("MB"),
+    init(0),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<bool> g_daemonOpt(
+    "daemon",
+    desc("Instead of processing source files, wait for lint requests on socket given with -daemon-socket"),
+    init(false),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<std::string> g_daemonSocketOpt(
+    "daemon-socket",
+    desc("Unix domain socket of colobot-lint daemon; if given without -daemon, source files are processed "
+         "by the daemon (or locally, if daemon is not running)"),
+    value_desc("path"),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<bool> g_rawOpt(
+    "raw",
+    desc("Instead of parsing source files from compilation database, check only text of given files "
+         "(or glob patterns) with whitespace, license header and TODO comment rules"),
+    init(false),
+    cat(g_colobotLintOptionCategory));
+
+static cl::opt<bool> g_mergeOpt(
+    "merge",
+    desc("Instead of processing source files, merge given shard reports into one report"),
+    init(false),
+    cat(g_colobotLintOptionCategory));
+
 extrahelp g_moreHelp(
     "Colobot-lint runs just like any other tool based on Clang's libtooling.\n"
     "\n"
@@ -208,6 +369,35 @@ boost::optional<std::vector<OutputFilter>> ParseOutputFilters(cl::list<std::stri
     return outputFilters;
 }
 
+boost::optional<ShardSelection> ParseShardSelection(const std::string& shardSelection)
+{
+    ShardSelection shard;
+    if (shardSelection.empty())
+        return shard;
+
+    std::vector<std::string> components;
+    boost::split(components, shardSelection, boost::is_any_of("/"));
+
+    unsigned shardNumber = 0;
+    if (components.size() == 2)
+    {
+        std::stringstream str;
+        str.str(components[0] + " " + components[1]);
+        str >> shardNumber >> shard.count;
+        if (str.fail())
+            shard.count = 0;
+    }
+
+    if (shard.count == 0 || shardNumber < 1 || shardNumber > shard.count)
+    {
+        std::cerr << "Invalid shard: \"" << shardSelection << "\"!" << std::endl;
+        return boost::none;
+    }
+
+    shard.index = shardNumber - 1;
+    return shard;
+}
+
 struct ParsedOptions
 {
     bool debug = {};
@@ -219,6 +409,7 @@ struct ParsedOptions
     OutputFormat outputFormat = {};
     std::vector<std::string> licenseTemplateLines = {};
     std::vector<OutputFilter> outputFilters = {};
+    ParallelLintOptions parallelLintOptions = {};
 };
 
 boost::optional<ParsedOptions> ParseOptions()
@@ -238,6 +429,28 @@ boost::optional<ParsedOptions> ParseOptions()
 
     parsedOptions.outputFile = g_outputFileOpt;
 
+    parsedOptions.parallelLintOptions.jobCount = (g_jobsOpt > 0) ? g_jobsOpt : GetAvailableCpuCount();
+    parsedOptions.parallelLintOptions.timingHistoryFile = g_timingHistoryFileOpt;
+    parsedOptions.parallelLintOptions.cacheDirectory = g_cacheDirOpt;
+    parsedOptions.parallelLintOptions.cacheMaxSize = static_cast<std::uint64_t>(g_cacheMaxSizeOpt) * 1024 * 1024;
+    parsedOptions.parallelLintOptions.reusePreambles = g_reusePreamblesOpt;
+    parsedOptions.parallelLintOptions.lintHeaders = g_lintHeadersOpt;
+    parsedOptions.parallelLintOptions.useWorkerProcesses = g_workerProcessesOpt;
+
+    // preambles are built lazily by workers and would be built and left behind by each worker process
+    if (g_workerProcessesOpt && g_reusePreamblesOpt)
+    {
+        std::cerr << "Preambles cannot be reused with worker processes!" << std::endl;
+        return boost::none;
+    }
+
+    auto shard = ParseShardSelection(g_shardOpt);
+    if (!shard)
+    {
+        return boost::none;
+    }
+    parsedOptions.parallelLintOptions.shard = *shard;
+
     auto outputFormat = ParseOutputFormat(g_outputFormat, parsedOptions.generatorSelection);
     if (!outputFormat)
     {
@@ -259,9 +472,187 @@ boost::optional<ParsedOptions> ParseOptions()
     }
     parsedOptions.outputFilters = std::move(*outputFilters);
 
+    parsedOptions.parallelLintOptions.includeIndexFile = g_includeIndexFileOpt;
+
+    parsedOptions.parallelLintOptions.translationUnitLimits.timeLimitSeconds = g_tuTimeLimitOpt;
+    parsedOptions.parallelLintOptions.translationUnitLimits.softTimeLimitSeconds = g_tuSoftTimeLimitOpt;
+    parsedOptions.parallelLintOptions.translationUnitLimits.memoryLimitBytes =
+        static_cast<std::size_t>(g_tuMemoryLimitOpt) * 1024 * 1024;
+
+    SourceLocationHelper sourceLocationHelper;
+
+    if (!g_changedFilesOpt.empty())
+    {
+        parsedOptions.parallelLintOptions.skipUnchangedSourceFiles = true;
+        for (const auto& changedFile : g_changedFilesOpt)
+        {
+            SmallString<256> path(changedFile);
+            sys::fs::make_absolute(path);
+            parsedOptions.parallelLintOptions.changedFiles.insert(sourceLocationHelper.CleanRawFilename(path));
+        }
+    }
+
+    if (!g_diffFileOpt.empty())
+    {
+        SmallString<256> currentDirectory;
+        sys::fs::current_path(currentDirectory);
+
+        auto diffFilters = ReadDiffFile(g_diffFileOpt, currentDirectory.str(), sourceLocationHelper);
+        if (!diffFilters)
+        {
+            return boost::none;
+        }
+
+        parsedOptions.parallelLintOptions.skipUnchangedSourceFiles = true;
+        for (auto& filter : *diffFilters)
+        {
+            parsedOptions.parallelLintOptions.changedFiles.insert(filter.fileName);
+            parsedOptions.outputFilters.push_back(std::move(filter));
+        }
+
+        // empty output filters would mean no filtering at all, so filter which matches nothing is needed
+        if (parsedOptions.outputFilters.empty())
+        {
+            OutputFilter emptyFilter;
+            emptyFilter.startLineNumber = 1;
+            parsedOptions.outputFilters.push_back(std::move(emptyFilter));
+        }
+    }
+
     return parsedOptions;
 }
 
+// features other than multiple threads are implemented only by parallel lint runner
+bool IsParallelLintRequired(const ParallelLintOptions& options, const std::vector<std::string>& sourcePaths)
+{
+    return (options.jobCount > 1 && sourcePaths.size() > 1) ||
+           options.shard.count > 1 ||
+           !options.timingHistoryFile.empty() ||
+           !options.cacheDirectory.empty() ||
+           options.reusePreambles ||
+           options.lintHeaders ||
+           options.skipUnchangedSourceFiles ||
+           !options.includeIndexFile.empty() ||
+           options.useWorkerProcesses ||
+           options.translationUnitLimits.IsAnySet();
+}
+
+bool HasCommandLineOption(int argc, const char **argv, StringRef optionName)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        StringRef arg = argv[i];
+        if (arg == "--")
+            break;
+
+        if (!arg.startswith("-"))
+            continue;
+
+        arg = arg.ltrim('-');
+        if (arg == optionName || arg.startswith((optionName + "=").str()))
+            return true;
+    }
+    return false;
+}
+
+// In merge mode, there is no compilation database and positional arguments are report files,
+// so CommonOptionsParser (which registers its own positional source file list) cannot be used
+std::vector<std::string> ParseMergeModeCommandLine(int argc, const char **argv)
+{
+    static cl::list<std::string> reportFilesOpt(
+        Positional,
+        desc("<report0> [... <reportN>]"),
+        OneOrMore,
+        cat(g_colobotLintOptionCategory));
+
+    ParseCommandLineOptions(argc, argv);
+
+    return std::vector<std::string>(reportFilesOpt.begin(), reportFilesOpt.end());
+}
+
+// In raw mode, there is no compilation database and positional arguments are any files or glob patterns
+std::vector<std::string> ParseRawModeCommandLine(int argc, const char **argv)
+{
+    static cl::list<std::string> pathPatternsOpt(
+        Positional,
+        desc("<file0|pattern0> [... <fileN|patternN>]"),
+        OneOrMore,
+        cat(g_colobotLintOptionCategory));
+
+    ParseCommandLineOptions(argc, argv);
+
+    return std::vector<std::string>(pathPatternsOpt.begin(), pathPatternsOpt.end());
+}
+
+// Daemon gets compilation database and source files with each request
+void ParseDaemonModeCommandLine(int argc, const char **argv)
+{
+    ParseCommandLineOptions(argc, argv);
+}
+
+// In client mode, compilation database is loaded by daemon, so only its location is needed
+std::vector<std::string> ParseClientModeCommandLine(int argc, const char **argv, std::string& buildPath)
+{
+    static cl::opt<std::string> buildPathOpt(
+        "p",
+        desc("Build path"),
+        Optional,
+        cat(g_colobotLintOptionCategory));
+
+    static cl::list<std::string> sourcePathsOpt(
+        Positional,
+        desc("<source0> [... <sourceN>]"),
+        OneOrMore,
+        cat(g_colobotLintOptionCategory));
+
+    ParseCommandLineOptions(argc, argv);
+
+    buildPath = buildPathOpt;
+    return std::vector<std::string>(sourcePathsOpt.begin(), sourcePathsOpt.end());
+}
+
+int RunLint(const CompilationDatabase& compilations,
+            const std::vector<std::string>& sourcePaths,
+            Context& context,
+            const ParallelLintOptions& options)
+{
+    if (IsParallelLintRequired(options, sourcePaths))
+        return RunParallelLint(compilations, sourcePaths, context, options);
+
+    ClangTool tool(compilations, sourcePaths);
+
+    DiagnosticHandler diagnosticHandler(context);
+    tool.setDiagnosticConsumer(&diagnosticHandler);
+
+    ColobotLintASTFrontendActionFactory factory(context);
+    return tool.run(&factory);
+}
+
+int RunClientMode(const std::string& buildPath,
+                  const std::vector<std::string>& sourcePaths,
+                  Context& context,
+                  const ParallelLintOptions& options)
+{
+    auto retCode = RunLintClient(g_daemonSocketOpt, buildPath, sourcePaths, options, context);
+    if (retCode)
+        return *retCode;
+
+    if (context.verbose)
+    {
+        std::cerr << "Daemon is not running, processing source files locally" << std::endl;
+    }
+
+    std::string errorMessage;
+    auto compilations = LoadCompilationDatabase(buildPath, sourcePaths, errorMessage);
+    if (compilations == nullptr)
+    {
+        std::cerr << "Error while trying to load a compilation database:\n" << errorMessage << std::endl;
+        return 1;
+    }
+
+    return RunLint(*compilations, sourcePaths, context, options);
+}
+
 } // anonymous namespace
 
 namespace boost
@@ -277,15 +668,64 @@ namespace boost
 int main(int argc, const char **argv)
 {
     SetVersionPrinter(PrintColobotLintVersion);
-    CommonOptionsParser optionsParser(argc, argv, g_colobotLintOptionCategory);
 
-    ClangTool tool(optionsParser.getCompilations(),
-                   optionsParser.getSourcePathList());
+    std::unique_ptr<CommonOptionsParser> optionsParser;
+    std::vector<std::string> positionalArgs; // report files in merge mode, source files in client and raw mode
+    std::string clientBuildPath;
+    if (HasCommandLineOption(argc, argv, "merge"))
+        positionalArgs = ParseMergeModeCommandLine(argc, argv);
+    else if (HasCommandLineOption(argc, argv, "raw"))
+        positionalArgs = ParseRawModeCommandLine(argc, argv);
+    else if (HasCommandLineOption(argc, argv, "daemon"))
+        ParseDaemonModeCommandLine(argc, argv);
+    else if (HasCommandLineOption(argc, argv, "daemon-socket"))
+        positionalArgs = ParseClientModeCommandLine(argc, argv, clientBuildPath);
+    else
+        optionsParser = make_unique<CommonOptionsParser>(argc, argv, g_colobotLintOptionCategory);
 
     auto parsedOptions = ParseOptions();
     if (!parsedOptions)
         return 1;
 
+    if (g_daemonOpt)
+    {
+        if (g_daemonSocketOpt.empty())
+        {
+            std::cerr << "Daemon mode requires -daemon-socket!" << std::endl;
+            return 1;
+        }
+
+        return RunLintDaemon(g_daemonSocketOpt,
+                             parsedOptions->parallelLintOptions,
+                             parsedOptions->verbose,
+                             parsedOptions->debug);
+    }
+
+    if (g_mergeOpt && !parsedOptions->generatorSelection.empty())
+    {
+        std::cerr << "Graphs cannot be merged!" << std::endl;
+        return 1;
+    }
+
+    if (g_rawOpt && !parsedOptions->generatorSelection.empty())
+    {
+        std::cerr << "Graphs cannot be generated in raw mode!" << std::endl;
+        return 1;
+    }
+
+    bool clientMode = !g_mergeOpt && !g_rawOpt && optionsParser == nullptr;
+    if (clientMode && (g_profileRulesOpt || !g_profileRulesFileOpt.empty()))
+    {
+        std::cerr << "Rules cannot be profiled in client mode!" << std::endl;
+        return 1;
+    }
+
+    if (clientMode && g_statsOpt)
+    {
+        std::cerr << "Statistics cannot be collected in client mode!" << std::endl;
+        return 1;
+    }
+
     SourceLocationHelper sourceLocationHelper;
 
     Context context(sourceLocationHelper,
@@ -301,13 +741,58 @@ int main(int argc, const char **argv)
                     parsedOptions->debug);
     sourceLocationHelper.SetContext(&context);
 
-    DiagnosticHandler diagnosticHandler(context);
-    tool.setDiagnosticConsumer(&diagnosticHandler);
+    if (g_profileRulesOpt || !g_profileRulesFileOpt.empty())
+        context.ruleProfiler = make_unique<RuleProfiler>();
 
-    ColobotLintASTFrontendActionFactory factory(context);
-    int retCode = tool.run(&factory);
+    if (!g_traceFileOpt.empty())
+        context.traceRecorder = make_unique<TraceRecorder>(0);
+
+    if (g_statsOpt)
+    {
+        context.statistics = make_unique<Statistics>();
+        context.outputPrinter->SetStatistics(context.statistics.get());
+    }
+
+    int retCode = 0;
+    if (g_mergeOpt)
+    {
+        retCode = MergeReports(positionalArgs, context);
+    }
+    else if (g_rawOpt)
+    {
+        retCode = RunRawTextLint(positionalArgs, context, parsedOptions->parallelLintOptions.jobCount);
+    }
+    else if (optionsParser == nullptr)
+    {
+        retCode = RunClientMode(clientBuildPath, positionalArgs, context, parsedOptions->parallelLintOptions);
+    }
+    else
+    {
+        retCode = RunLint(optionsParser->getCompilations(),
+                          optionsParser->getSourcePathList(),
+                          context,
+                          parsedOptions->parallelLintOptions);
+    }
+
+    {
+        TraceSpan span(context.traceRecorder.get(), "OutputPrinter::Save", "phase");
+        context.outputPrinter->Save();
+    }
+
+    if (context.ruleProfiler != nullptr)
+    {
+        if (g_profileRulesOpt)
+            context.ruleProfiler->PrintTable(std::cerr);
+
+        if (!g_profileRulesFileOpt.empty() && !context.ruleProfiler->SaveJson(g_profileRulesFileOpt))
+            retCode = 1;
+    }
+
+    if (context.statistics != nullptr)
+        context.statistics->Print(std::cerr);
 
-    context.outputPrinter->Save();
+    if (context.traceRecorder != nullptr && !context.traceRecorder->Save(g_traceFileOpt))
+        retCode = 1;
 
     return retCode;
 }
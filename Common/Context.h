@@ -3,11 +3,15 @@
 #include "Common/ExclusionZone.h"
 #include "Common/FunctionDefinitionContext.h"
 #include "Common/OutputPrinter.h"
+#include "Common/RuleProfiler.h"
 #include "Common/SourceFileInfo.h"
+#include "Common/Statistics.h"
+#include "Common/TraceRecorder.h"
+#include "Common/TranslationUnitLimits.h"
 
+#include <map>
 #include <set>
 #include <string>
-#include <unordered_map>
 #include <unordered_set>
 
 class SourceLocationHelper;
@@ -42,6 +46,8 @@ struct Context
 
     bool areWeInFakeHeaderSourceFile;
     std::string actualHeaderFileSuffix;
+    // sources synthesized in memory to check headers (see -lint-headers), mapped to checked headers
+    std::map<std::string, std::string> headerCheckSources;
     std::unordered_set<std::string> processedFiles;
 
     std::unordered_set<ExclusionZone> exclusionZones;
@@ -49,7 +55,23 @@ struct Context
     std::unordered_set<std::string> reportedOldStyleFunctions;
 
     std::unordered_set<std::string> definedFunctions;
-    std::unordered_map<std::string, SourceFileInfo> undefinedFunctions;
+    std::map<std::string, SourceFileInfo> undefinedFunctions;
+
+    // peak memory (in bytes) used by Clang for source files processed since last reset
+    std::size_t translationUnitMemoryUsage = 0;
+    // absolute paths of all files read by Clang for source files processed since last reset
+    std::set<std::string> translationUnitInputFiles;
+
+    TranslationUnitLimits translationUnitLimits;
+    // set when processing of source file was stopped because it exceeded limits
+    bool translationUnitAborted = false;
+
+    // null if rules are not profiled (see -profile-rules)
+    std::unique_ptr<RuleProfiler> ruleProfiler;
+    // null if processing is not traced (see -trace-file)
+    std::unique_ptr<TraceRecorder> traceRecorder;
+    // null if statistics are not gathered (see -stats)
+    std::unique_ptr<Statistics> statistics;
 
     SourceLocationHelper& sourceLocationHelper;
 
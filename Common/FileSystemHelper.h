@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <sys/stat.h>
+
+// Modification time with the best precision available, so that changes made in the same second are noticed
+inline std::int64_t GetModificationTimeNs(const struct stat& fileStat)
+{
+#ifdef __linux__
+    return static_cast<std::int64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec;
+#else
+    return static_cast<std::int64_t>(fileStat.st_mtime) * 1000000000;
+#endif
+}
+
+// returns -1 if file does not exist
+inline std::int64_t GetModificationTimeNs(const std::string& path)
+{
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) != 0)
+        return -1;
+
+    return GetModificationTimeNs(fileStat);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MD5.h>
+
+#include <string>
+
+// Every part is prefixed with its length, so that different sequences of parts never give the same hash
+inline void UpdateHash(llvm::MD5& hash, llvm::StringRef value)
+{
+    hash.update(std::to_string(value.size()) + ":");
+    hash.update(value);
+}
+
+inline std::string FinalizeHash(llvm::MD5& hash)
+{
+    llvm::MD5::MD5Result result;
+    hash.final(result);
+    llvm::SmallString<32> resultStr;
+    llvm::MD5::stringifyResult(result, resultStr);
+    return resultStr.str();
+}
@@ -3,6 +3,8 @@
 #include "ColobotLintConfig.h"
 
 #include "Common/SourceLocationHelper.h"
+#include "Common/Statistics.h"
+#include "Common/TranslationUnitReport.h"
 
 #include <clang/Basic/SourceLocation.h>
 #include <clang/AST/ASTContext.h>
@@ -10,8 +12,10 @@
 
 #include <tinyxml.h>
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
+#include <unordered_map>
 #include <unordered_set>
 
 using namespace clang;
@@ -31,6 +35,10 @@ public:
                         const std::string& destination,
                         const std::string& options = "") override;
 
+    void PrintTranslationUnitSummary(int sourceFileIndex,
+                                     const std::string& sourceFileName,
+                                     const TranslationUnitReport& report) override;
+
 protected:
     void PrintRuleViolationImpl(StringRef ruleName,
                                 Severity severity,
@@ -56,6 +64,10 @@ public:
                         const std::string& destination,
                         const std::string& options = "") override;
 
+    void PrintTranslationUnitSummary(int sourceFileIndex,
+                                     const std::string& sourceFileName,
+                                     const TranslationUnitReport& report) override;
+
 protected:
     void PrintRuleViolationImpl(StringRef ruleName,
                                 Severity severity,
@@ -72,6 +84,7 @@ private:
     TiXmlDocument m_document;
     std::unique_ptr<TiXmlElement> m_resultsElement;
     std::unique_ptr<TiXmlElement> m_errorsElement;
+    std::unique_ptr<TiXmlElement> m_translationUnitsElement;
 };
 
 class DotGraphOutputPrinter : public OutputPrinter
@@ -123,10 +136,18 @@ private:
         }
     };
 
-    std::unordered_set<DotGraphEdge, DotGraphEdgeHash> m_graphEdges;
+    // repeated edges are counted, for example calls between the same classes
+    std::unordered_map<DotGraphEdge, int, DotGraphEdgeHash> m_graphEdges;
 };
 
 
+std::vector<std::string> GetSortedFunctionNames(const std::unordered_set<std::string>& functions)
+{
+    std::vector<std::string> sortedFunctions(functions.begin(), functions.end());
+    std::sort(sortedFunctions.begin(), sortedFunctions.end());
+    return sortedFunctions;
+}
+
 } // anonymous namespace
 
 
@@ -197,17 +218,65 @@ void OutputPrinter::PrintRuleViolation(StringRef ruleName,
                                        int lineNumber,
                                        bool tentative)
 {
-    if (ShouldPrintLine(fileName, lineNumber))
+    // tentative violations are filtered and counted only when they are replayed in Save(),
+    // as they may be cleared and queued again many times before that
+    if (tentative)
     {
-        if (tentative)
-        {
-            m_tentativeViolations.emplace_back(ruleName.str(), severity, description, fileName.str(), lineNumber);
-        }
-        else
-        {
-            PrintRuleViolationImpl(ruleName, severity, description, fileName, lineNumber);
-        }
+        m_tentativeViolations.emplace_back(ruleName.str(), severity, description, fileName.str(), lineNumber);
+        return;
     }
+
+    bool shouldPrint = ShouldPrintLine(fileName, lineNumber);
+
+    if (m_statistics != nullptr)
+        ++(shouldPrint ? m_statistics->violationsPrinted : m_statistics->violationsFilteredOut);
+
+    if (shouldPrint)
+        PrintRuleViolationImpl(ruleName, severity, description, fileName, lineNumber);
+}
+
+void OutputPrinter::PrintUniqueRuleViolation(const std::string& uniqueKey,
+                                             StringRef ruleName,
+                                             Severity severity,
+                                             const std::string& description,
+                                             SourceLocation location,
+                                             SourceManager& sourceManager)
+{
+    StringRef fileName = m_sourceLocationHelper.GetCleanFilename(location, sourceManager);
+    int lineNumber = sourceManager.getPresumedLineNumber(location);
+
+    PrintUniqueRuleViolation(uniqueKey, ruleName, severity, description, fileName, lineNumber);
+}
+
+void OutputPrinter::PrintUniqueRuleViolation(const std::string& uniqueKey,
+                                             StringRef ruleName,
+                                             Severity severity,
+                                             const std::string& description,
+                                             StringRef fileName,
+                                             int lineNumber)
+{
+    PrintUniqueRuleViolationImpl(uniqueKey, ruleName, severity, description, fileName, lineNumber);
+}
+
+void OutputPrinter::PrintUniqueRuleViolationImpl(const std::string& uniqueKey,
+                                                 StringRef ruleName,
+                                                 Severity severity,
+                                                 const std::string& description,
+                                                 StringRef fileName,
+                                                 int lineNumber)
+{
+    if (m_reportedUniqueViolations.count(uniqueKey) > 0)
+        return;
+
+    PrintRuleViolation(ruleName, severity, description, fileName, lineNumber);
+
+    m_reportedUniqueViolations.insert(uniqueKey);
+}
+
+void OutputPrinter::PrintTranslationUnitSummary(int sourceFileIndex,
+                                                const std::string& sourceFileName,
+                                                const TranslationUnitReport& report)
+{
 }
 
 void OutputPrinter::ClearTentativeViolations()
@@ -215,6 +284,11 @@ void OutputPrinter::ClearTentativeViolations()
     m_tentativeViolations.clear();
 }
 
+void OutputPrinter::SetStatistics(Statistics* statistics)
+{
+    m_statistics = statistics;
+}
+
 bool OutputPrinter::ShouldPrintLine(StringRef fileName, int lineNumber)
 {
     if (m_outputFilters.empty())
@@ -308,6 +382,25 @@ void PlainTextOutputPrinter::PrintGraphEdge(const std::string& source,
     assert(false && "Not implemented");
 }
 
+void PlainTextOutputPrinter::PrintTranslationUnitSummary(int sourceFileIndex,
+                                                         const std::string& sourceFileName,
+                                                         const TranslationUnitReport& report)
+{
+    m_outputStream << "[translation unit] " << sourceFileIndex << " " << sourceFileName << std::endl;
+
+    for (const auto& definedFunction : GetSortedFunctionNames(report.definedFunctions))
+    {
+        m_outputStream << "[defined function] " << definedFunction << std::endl;
+    }
+
+    for (const auto& undefinedFunction : report.undefinedFunctions)
+    {
+        m_outputStream << "[declared function] "
+                       << undefinedFunction.second.fileName << ":" << undefinedFunction.second.lineNumber << " "
+                       << undefinedFunction.first << std::endl;
+    }
+}
+
 void PlainTextOutputPrinter::SaveImpl()
 {
 }
@@ -366,9 +459,41 @@ void XmlOutputPrinter::PrintGraphEdge(const std::string& source,
     assert(false && "Not implemented");
 }
 
+void XmlOutputPrinter::PrintTranslationUnitSummary(int sourceFileIndex,
+                                                   const std::string& sourceFileName,
+                                                   const TranslationUnitReport& report)
+{
+    if (m_translationUnitsElement == nullptr)
+        m_translationUnitsElement = make_unique<TiXmlElement>("translation-units");
+
+    auto translationUnitElement = make_unique<TiXmlElement>("translation-unit");
+    translationUnitElement->SetAttribute("index", std::to_string(sourceFileIndex));
+    translationUnitElement->SetAttribute("file", sourceFileName);
+
+    for (const auto& definedFunction : GetSortedFunctionNames(report.definedFunctions))
+    {
+        auto functionElement = make_unique<TiXmlElement>("defined-function");
+        functionElement->SetAttribute("name", definedFunction);
+        translationUnitElement->LinkEndChild(functionElement.release());
+    }
+
+    for (const auto& undefinedFunction : report.undefinedFunctions)
+    {
+        auto functionElement = make_unique<TiXmlElement>("declared-function");
+        functionElement->SetAttribute("name", undefinedFunction.first);
+        functionElement->SetAttribute("file", undefinedFunction.second.fileName);
+        functionElement->SetAttribute("line", std::to_string(undefinedFunction.second.lineNumber));
+        translationUnitElement->LinkEndChild(functionElement.release());
+    }
+
+    m_translationUnitsElement->LinkEndChild(translationUnitElement.release());
+}
+
 void XmlOutputPrinter::SaveImpl()
 {
     m_resultsElement->LinkEndChild(m_errorsElement.release());
+    if (m_translationUnitsElement != nullptr)
+        m_resultsElement->LinkEndChild(m_translationUnitsElement.release());
     m_document.LinkEndChild(m_resultsElement.release());
 
     if (m_outputFileName.empty())
@@ -402,7 +527,7 @@ void DotGraphOutputPrinter::PrintGraphEdge(const std::string& source,
                                            const std::string& destination,
                                            const std::string& options)
 {
-    m_graphEdges.insert(DotGraphEdge{source, destination, options});
+    ++m_graphEdges[DotGraphEdge{source, destination, options}];
 }
 
 void DotGraphOutputPrinter::SaveImpl()
@@ -421,9 +546,21 @@ void DotGraphOutputPrinter::SaveImpl()
 void DotGraphOutputPrinter::Save(std::ostream& outputStream)
 {
     outputStream << "digraph G {\n";
-    for (const auto& edge : m_graphEdges)
+    for (const auto& edgeWithCount : m_graphEdges)
     {
-        outputStream << "  \"" << edge.source << "\" -> \"" << edge.target << "\" " << edge.options << "\n";
+        const DotGraphEdge& edge = edgeWithCount.first;
+        int count = edgeWithCount.second;
+
+        outputStream << "  \"" << edge.source << "\" -> \"" << edge.target << "\"";
+        if (!edge.options.empty())
+        {
+            outputStream << " " << edge.options;
+        }
+        if (count > 1)
+        {
+            outputStream << " [weight=" << count << ", label=\"" << count << "\"]";
+        }
+        outputStream << "\n";
     }
     outputStream << "}\n";
 }
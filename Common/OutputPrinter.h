@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace clang
@@ -18,6 +19,8 @@ class StringRef;
 } // namespace clang
 
 class SourceLocationHelper;
+struct Statistics;
+struct TranslationUnitReport;
 
 enum class OutputFormat
 {
@@ -64,12 +67,35 @@ public:
                             int lineNumber,
                             bool tentative = false);
 
+    void PrintUniqueRuleViolation(const std::string& uniqueKey,
+                                  llvm::StringRef ruleName,
+                                  Severity severity,
+                                  const std::string& description,
+                                  clang::SourceLocation location,
+                                  clang::SourceManager& sourceManager);
+
+    void PrintUniqueRuleViolation(const std::string& uniqueKey,
+                                  llvm::StringRef ruleName,
+                                  Severity severity,
+                                  const std::string& description,
+                                  llvm::StringRef fileName,
+                                  int lineNumber);
+
     virtual void PrintGraphEdge(const std::string& source,
                                 const std::string& destination,
                                 const std::string& options = "") = 0;
 
+    // cross-TU state of source file; it is printed only in sharded runs, so that it can be combined later by report merge
+    // By default it is ignored, as only report formats which can be merged have place for it
+    virtual void PrintTranslationUnitSummary(int sourceFileIndex,
+                                             const std::string& sourceFileName,
+                                             const TranslationUnitReport& report);
+
     void ClearTentativeViolations();
 
+    // counts violations printed and dropped by output filters (see -stats); only for the final printer
+    void SetStatistics(Statistics* statistics);
+
     void Save();
 
 protected:
@@ -78,6 +104,12 @@ protected:
                                         const std::string& description,
                                         llvm::StringRef fileName,
                                         int lineNumber) = 0;
+    virtual void PrintUniqueRuleViolationImpl(const std::string& uniqueKey,
+                                              llvm::StringRef ruleName,
+                                              Severity severity,
+                                              const std::string& description,
+                                              llvm::StringRef fileName,
+                                              int lineNumber);
     virtual void SaveImpl() = 0;
     bool ShouldPrintLine(llvm::StringRef fileName, int lineNumber);
     std::string GetSeverityString(Severity severity);
@@ -87,5 +119,7 @@ protected:
     const std::vector<OutputFilter> m_outputFilters;
     struct RuleViolationInfo;
     std::vector<RuleViolationInfo> m_tentativeViolations;
+    std::unordered_set<std::string> m_reportedUniqueViolations;
     SourceLocationHelper& m_sourceLocationHelper;
+    Statistics* m_statistics = nullptr;
 };
@@ -0,0 +1,55 @@
+#include "Common/RecordingOutputPrinter.h"
+
+#include "Common/TranslationUnitReport.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <cassert>
+
+using namespace llvm;
+
+RecordingOutputPrinter::RecordingOutputPrinter(SourceLocationHelper& sourceLocationHelper)
+    : OutputPrinter("", {}, sourceLocationHelper)
+{}
+
+void RecordingOutputPrinter::SetReport(TranslationUnitReport* report)
+{
+    m_report = report;
+}
+
+void RecordingOutputPrinter::PrintRuleViolationImpl(StringRef ruleName,
+                                                    Severity severity,
+                                                    const std::string& description,
+                                                    StringRef fileName,
+                                                    int lineNumber)
+{
+    assert(m_report != nullptr);
+    m_report->violations.push_back(
+        ReportedViolation{ruleName.str(), severity, description, fileName.str(), lineNumber, ""});
+}
+
+void RecordingOutputPrinter::PrintUniqueRuleViolationImpl(const std::string& uniqueKey,
+                                                          StringRef ruleName,
+                                                          Severity severity,
+                                                          const std::string& description,
+                                                          StringRef fileName,
+                                                          int lineNumber)
+{
+    // uniqueness is checked only when the report is replayed, as we don't know yet
+    // which translation unit comes first
+    assert(m_report != nullptr);
+    m_report->violations.push_back(
+        ReportedViolation{ruleName.str(), severity, description, fileName.str(), lineNumber, uniqueKey});
+}
+
+void RecordingOutputPrinter::PrintGraphEdge(const std::string& source,
+                                            const std::string& destination,
+                                            const std::string& options)
+{
+    assert(m_report != nullptr);
+    m_report->graphEdges.push_back(ReportedGraphEdge{source, destination, options});
+}
+
+void RecordingOutputPrinter::SaveImpl()
+{
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Common/OutputPrinter.h"
+
+struct TranslationUnitReport;
+
+// Output printer that doesn't print anything, but records everything in translation unit report
+// to be replayed later into the actual output printer
+class RecordingOutputPrinter : public OutputPrinter
+{
+public:
+    RecordingOutputPrinter(SourceLocationHelper& sourceLocationHelper);
+
+    void SetReport(TranslationUnitReport* report);
+
+    void PrintGraphEdge(const std::string& source,
+                        const std::string& destination,
+                        const std::string& options = "") override;
+
+protected:
+    void PrintRuleViolationImpl(llvm::StringRef ruleName,
+                                Severity severity,
+                                const std::string& description,
+                                llvm::StringRef fileName,
+                                int lineNumber) override;
+
+    void PrintUniqueRuleViolationImpl(const std::string& uniqueKey,
+                                      llvm::StringRef ruleName,
+                                      Severity severity,
+                                      const std::string& description,
+                                      llvm::StringRef fileName,
+                                      int lineNumber) override;
+
+    void SaveImpl() override;
+
+private:
+    TranslationUnitReport* m_report = nullptr;
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Common/Statistics.h"
+
 #include <llvm/ADT/StringRef.h>
 
 #include <boost/regex.hpp>
@@ -13,6 +15,15 @@ inline llvm::StringRef GetStringRefResult(const StringRefMatchResults& results,
     return text.substr(results.position(number), results.length(number));
 }
 
+// matches whole name against naming pattern, counting it in statistics of rule if they are gathered
+inline bool MatchNamePattern(llvm::StringRef name, const boost::regex& pattern, RuleStatistics* statistics)
+{
+    if (statistics != nullptr)
+        statistics->regexEvaluations++;
+
+    return boost::regex_match(name.begin(), name.end(), pattern);
+}
+
 const char* const LOWER_CAMEL_CASE_PATTERN = "[[:lower:][:digit:]]+([[:upper:][:digit:]]+[[:lower:][:digit:]]*)*";
 const char* const UPPER_CAMEL_CASE_PATTERN = "[[:upper:][:digit:]][[:lower:][:digit:]]*([[:upper:][:digit:]]+[[:lower:][:digit:]]*)*";
 const char* const ALL_CAPS_UNDERSCORE_PATTERN = "[[:upper:][:digit:]]+(_[[:upper:][:digit:]]+)*";
@@ -0,0 +1,126 @@
+#include "Common/RuleProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+double ToMs(std::uint64_t timeNs)
+{
+    return timeNs / 1e6;
+}
+
+void WriteJsonCounter(std::ostream& str, const char* name, const RuleProfileCounter& counter)
+{
+    str << "\"" << name << "\": {\"calls\": " << counter.calls << ", \"timeMs\": " << ToMs(counter.timeNs) << "}";
+}
+
+} // anonymous namespace
+
+void RuleProfileEntry::Add(const RuleProfileEntry& other)
+{
+    matchCallbacks.Add(other.matchCallbacks);
+    translationUnitCallbacks.Add(other.translationUnitCallbacks);
+    preprocessorCallbacks.Add(other.preprocessorCallbacks);
+    locationChecks.Add(other.locationChecks);
+}
+
+RuleProfileEntry& RuleProfiler::GetEntry(const std::string& ruleName)
+{
+    return m_profile[ruleName];
+}
+
+RuleProfile RuleProfiler::TakeProfile()
+{
+    RuleProfile profile;
+    profile.swap(m_profile);
+    return profile;
+}
+
+void RuleProfiler::Merge(const RuleProfile& profile)
+{
+    for (const auto& entry : profile)
+        m_profile[entry.first].Add(entry.second);
+}
+
+void RuleProfiler::PrintTable(std::ostream& str) const
+{
+    std::vector<const RuleProfile::value_type*> sortedEntries;
+    std::uint64_t totalTimeNs = 0;
+    for (const auto& entry : m_profile)
+    {
+        sortedEntries.push_back(&entry);
+        totalTimeNs += entry.second.GetTotalTimeNs();
+    }
+
+    std::stable_sort(sortedEntries.begin(), sortedEntries.end(),
+        [](const RuleProfile::value_type* left, const RuleProfile::value_type* right)
+        {
+            return left->second.GetTotalTimeNs() > right->second.GetTotalTimeNs();
+        });
+
+    std::ios::fmtflags oldFlags = str.flags();
+    str << std::fixed << std::setprecision(1);
+
+    str << std::left << std::setw(42) << "Rule" << std::right
+        << std::setw(10) << "Total ms" << std::setw(7) << "%"
+        << std::setw(10) << "Matches" << std::setw(10) << "Match ms"
+        << std::setw(10) << "TU ms"
+        << std::setw(10) << "PP calls" << std::setw(10) << "PP ms"
+        << std::setw(10) << "Loc. chk" << std::setw(10) << "Loc. ms" << "\n";
+
+    for (const auto* entry : sortedEntries)
+    {
+        const RuleProfileEntry& profile = entry->second;
+        double percentage = (totalTimeNs > 0) ? (100.0 * profile.GetTotalTimeNs() / totalTimeNs) : 0.0;
+
+        str << std::left << std::setw(42) << entry->first << std::right
+            << std::setw(10) << ToMs(profile.GetTotalTimeNs()) << std::setw(7) << percentage
+            << std::setw(10) << profile.matchCallbacks.calls << std::setw(10) << ToMs(profile.matchCallbacks.timeNs)
+            << std::setw(10) << ToMs(profile.translationUnitCallbacks.timeNs)
+            << std::setw(10) << profile.preprocessorCallbacks.calls << std::setw(10) << ToMs(profile.preprocessorCallbacks.timeNs)
+            << std::setw(10) << profile.locationChecks.calls << std::setw(10) << ToMs(profile.locationChecks.timeNs) << "\n";
+    }
+
+    str << std::left << std::setw(42) << "Total" << std::right << std::setw(10) << ToMs(totalTimeNs) << "\n";
+
+    str.flags(oldFlags);
+}
+
+bool RuleProfiler::SaveJson(const std::string& fileName) const
+{
+    std::ofstream str(fileName.c_str());
+    str << std::fixed << std::setprecision(3);
+
+    // rule names are C++ identifiers, so they need no escaping
+    str << "{\n  \"rules\": [";
+    bool first = true;
+    for (const auto& entry : m_profile)
+    {
+        const RuleProfileEntry& profile = entry.second;
+        str << (first ? "\n" : ",\n");
+        str << "    {\"name\": \"" << entry.first << "\", \"totalTimeMs\": " << ToMs(profile.GetTotalTimeNs()) << ", ";
+        WriteJsonCounter(str, "matchCallbacks", profile.matchCallbacks);
+        str << ", ";
+        WriteJsonCounter(str, "translationUnitCallbacks", profile.translationUnitCallbacks);
+        str << ", ";
+        WriteJsonCounter(str, "preprocessorCallbacks", profile.preprocessorCallbacks);
+        str << ", ";
+        WriteJsonCounter(str, "locationChecks", profile.locationChecks);
+        str << "}";
+        first = false;
+    }
+    str << "\n  ]\n}\n";
+
+    if (!str.good())
+    {
+        std::cerr << "Could not write rule profile file \"" << fileName << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
+}
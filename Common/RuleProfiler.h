@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+
+struct RuleProfileCounter
+{
+    std::uint64_t calls = 0;
+    std::uint64_t timeNs = 0;
+
+    void Add(const RuleProfileCounter& other)
+    {
+        calls += other.calls;
+        timeNs += other.timeNs;
+    }
+};
+
+// Time spent in callbacks of single rule (see -profile-rules)
+struct RuleProfileEntry
+{
+    RuleProfileCounter matchCallbacks;           // MatchCallback::run() and nodes from AST dispatcher
+    RuleProfileCounter translationUnitCallbacks; // callbacks at start and end of translation unit
+    RuleProfileCounter preprocessorCallbacks;    // PPCallbacks and comment handlers
+    RuleProfileCounter locationChecks;           // SourceLocationHelper::IsLocationOfInterest(); part of above
+
+    std::uint64_t GetTotalTimeNs() const
+    {
+        return matchCallbacks.timeNs + translationUnitCallbacks.timeNs + preprocessorCallbacks.timeNs;
+    }
+
+    void Add(const RuleProfileEntry& other);
+};
+
+using RuleProfile = std::map<std::string, RuleProfileEntry>;
+
+// Aggregates time spent in rules across source files
+// Each thread has its own profiler in its context; profiles of source files are merged by the main thread
+class RuleProfiler
+{
+public:
+    // reference stays valid until profile is taken
+    RuleProfileEntry& GetEntry(const std::string& ruleName);
+
+    RuleProfile TakeProfile();
+    void Merge(const RuleProfile& profile);
+
+    // table sorted by total time, for humans
+    void PrintTable(std::ostream& str) const;
+    // the same in JSON, for scripts
+    bool SaveJson(const std::string& fileName) const;
+
+private:
+    RuleProfile m_profile;
+};
+
+// Adds time from construction to destruction to given counter; does nothing if counter is null
+class RuleProfileTimer
+{
+public:
+    explicit RuleProfileTimer(RuleProfileCounter* counter)
+        : m_counter(counter)
+    {
+        if (m_counter != nullptr)
+            m_startTime = std::chrono::steady_clock::now();
+    }
+
+    ~RuleProfileTimer()
+    {
+        if (m_counter == nullptr)
+            return;
+
+        auto elapsed = std::chrono::steady_clock::now() - m_startTime;
+        m_counter->calls++;
+        m_counter->timeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+private:
+    RuleProfileCounter* m_counter;
+    std::chrono::steady_clock::time_point m_startTime;
+};
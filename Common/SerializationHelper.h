@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <utility>
+
+// Simple text serialization used to pass data between processes
+// Strings are prefixed with their length, as they may contain any characters, including newlines
+// Lengths of strings and counts of elements are checked against characters left in stream before they are used,
+// so that corrupted or hostile data cannot make reader allocate arbitrary amount of memory
+
+inline void WriteString(std::ostream& str, const std::string& value)
+{
+    str << value.size() << ':' << value << '\n';
+}
+
+inline void WriteInt(std::ostream& str, int value)
+{
+    str << value << '\n';
+}
+
+inline void WriteCount(std::ostream& str, std::size_t count)
+{
+    str << count << '\n';
+}
+
+inline bool HasCharactersLeft(std::istream& str, std::size_t count)
+{
+    std::istream::pos_type position = str.tellg();
+    if (position == std::istream::pos_type(-1))
+        return false;
+
+    str.seekg(0, std::ios::end);
+    std::istream::pos_type end = str.tellg();
+    str.seekg(position);
+
+    return end != std::istream::pos_type(-1) && static_cast<std::size_t>(end - position) >= count;
+}
+
+inline bool ReadString(std::istream& str, std::string& value)
+{
+    std::size_t size = 0;
+    if (!(str >> size) || str.get() != ':' || !HasCharactersLeft(str, size))
+        return false;
+
+    value.resize(size);
+    str.read(&value[0], size);
+    return str.get() == '\n';
+}
+
+inline bool ReadInt(std::istream& str, int& value)
+{
+    return (str >> value) && str.get() == '\n';
+}
+
+inline bool ReadCount(std::istream& str, std::size_t& count)
+{
+    return (str >> count) && str.get() == '\n';
+}
+
+// count of elements which follow, each taking at least one character
+inline bool ReadElementCount(std::istream& str, std::size_t& count)
+{
+    return ReadCount(str, count) && HasCharactersLeft(str, count);
+}
+
+template<typename Container>
+void WriteStrings(std::ostream& str, const Container& strings)
+{
+    WriteCount(str, strings.size());
+    for (const auto& value : strings)
+        WriteString(str, value);
+}
+
+template<typename InsertFunc>
+bool ReadStrings(std::istream& str, InsertFunc insert)
+{
+    std::size_t count = 0;
+    if (!ReadElementCount(str, count))
+        return false;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::string value;
+        if (!ReadString(str, value))
+            return false;
+        insert(std::move(value));
+    }
+
+    return true;
+}
@@ -21,17 +21,95 @@ bool SourceLocationHelper::IsLocationOfInterest(StringRef ruleName,
                                                 SourceLocation location,
                                                 SourceManager& sourceManager)
 {
-    return IsLocationInMainFile(location, sourceManager) and
-           not IsLocationInMacroExpansion(location, sourceManager) and
-           not IsLocationInExclusionZone(ruleName, location, sourceManager);
+    RuleProfileTimer timer(GetLocationChecksCounter(ruleName));
+
+    return CheckLocationOfInterest(ruleName, location, sourceManager, false);
 }
 
 bool SourceLocationHelper::IsLocationOfInterestAllowingMacros(StringRef ruleName,
                                                               SourceLocation location,
                                                               SourceManager& sourceManager)
 {
-    return IsLocationInMainFile(location, sourceManager) and
-           not IsLocationInExclusionZone(ruleName, location, sourceManager);
+    RuleProfileTimer timer(GetLocationChecksCounter(ruleName));
+
+    return CheckLocationOfInterest(ruleName, location, sourceManager, true);
+}
+
+bool SourceLocationHelper::CheckLocationOfInterest(StringRef ruleName,
+                                                   SourceLocation location,
+                                                   SourceManager& sourceManager,
+                                                   bool allowMacros)
+{
+    CountStatistic(&Statistics::locationChecks);
+
+    if (! IsLocationInMainFile(location, sourceManager))
+    {
+        CountStatistic(&Statistics::locationsOutsideMainFile);
+        return false;
+    }
+
+    if (! allowMacros && IsLocationInMacroExpansion(location, sourceManager))
+    {
+        CountStatistic(&Statistics::locationsInMacroExpansion);
+        return false;
+    }
+
+    if (IsLocationInExclusionZone(ruleName, location, sourceManager))
+    {
+        CountStatistic(&Statistics::locationsInExclusionZone);
+        return false;
+    }
+
+    return true;
+}
+
+bool SourceLocationHelper::IsLocationOfInterestForAnyRule(SourceLocation location,
+                                                          SourceManager& sourceManager)
+{
+    CountStatistic(&Statistics::locationChecks);
+
+    if (! IsLocationInMainFile(location, sourceManager))
+    {
+        CountStatistic(&Statistics::locationsOutsideMainFile);
+        return false;
+    }
+
+    if (IsLocationInMacroExpansion(location, sourceManager))
+    {
+        CountStatistic(&Statistics::locationsInMacroExpansion);
+        return false;
+    }
+
+    return true;
+}
+
+bool SourceLocationHelper::IsLocationOfInterestForRule(StringRef ruleName,
+                                                       SourceLocation location,
+                                                       SourceManager& sourceManager)
+{
+    RuleProfileTimer timer(GetLocationChecksCounter(ruleName));
+
+    if (IsLocationInExclusionZone(ruleName, location, sourceManager))
+    {
+        CountStatistic(&Statistics::locationsInExclusionZone);
+        return false;
+    }
+
+    return true;
+}
+
+RuleProfileCounter* SourceLocationHelper::GetLocationChecksCounter(StringRef ruleName)
+{
+    if (m_context->ruleProfiler == nullptr)
+        return nullptr;
+
+    return &m_context->ruleProfiler->GetEntry(ruleName.str()).locationChecks;
+}
+
+void SourceLocationHelper::CountStatistic(std::uint64_t Statistics::* counter)
+{
+    if (m_context->statistics != nullptr)
+        ++(m_context->statistics.get()->*counter);
 }
 
 bool SourceLocationHelper::IsLocationOfInterestIgnoringExclusionZone(SourceLocation location,
@@ -74,9 +152,11 @@ bool SourceLocationHelper::IsLocationInExclusionZone(StringRef ruleName,
     if (m_context->exclusionZones.empty())
         return false;
 
+    return IsLineInExclusionZone(ruleName, sourceManager.getPresumedLineNumber(location));
+}
 
-    int lineNumber = sourceManager.getPresumedLineNumber(location);
-
+bool SourceLocationHelper::IsLineInExclusionZone(StringRef ruleName, int lineNumber)
+{
     return m_context->exclusionZones.count(ExclusionZone{lineNumber, ruleName}) > 0 ||
            m_context->exclusionZones.count(ExclusionZone{lineNumber, StringRef("*")}) > 0;
 }
@@ -137,7 +217,12 @@ StringRef SourceLocationHelper::GetCleanFilename(FileID fileID, SourceManager& s
 
     auto it = m_cleanFilenameCache.find(fileID);
     if (it != m_cleanFilenameCache.end())
+    {
+        CountStatistic(&Statistics::filenameCacheHits);
         return StringRef(it->second);
+    }
+
+    CountStatistic(&Statistics::filenameCacheMisses);
 
     const FileEntry* entry = sourceManager.getFileEntryForID(fileID);
     if (entry == nullptr)
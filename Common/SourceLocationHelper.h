@@ -5,9 +5,12 @@
 #include <llvm/ADT/StringRef.h>
 #include <llvm/ADT/DenseMap.h>
 
+#include <cstdint>
 #include <string>
 
 struct Context;
+struct RuleProfileCounter;
+struct Statistics;
 
 class SourceLocationHelper
 {
@@ -25,9 +28,20 @@ public:
     bool IsLocationOfInterestIgnoringExclusionZone(clang::SourceLocation location,
                                                    clang::SourceManager& sourceManager);
 
+    // IsLocationOfInterest split in two parts, for AST dispatcher which checks location of node once
+    // for all rules and then each rule checks only its exclusion zones
+    bool IsLocationOfInterestForAnyRule(clang::SourceLocation location,
+                                        clang::SourceManager& sourceManager);
+    bool IsLocationOfInterestForRule(llvm::StringRef ruleName,
+                                     clang::SourceLocation location,
+                                     clang::SourceManager& sourceManager);
+
     bool IsLocationInProjectSourceFile(clang::SourceLocation location,
                                        clang::SourceManager& sourceManager);
 
+    // for raw mode, where there are no source locations
+    bool IsLineInExclusionZone(llvm::StringRef ruleName, int lineNumber);
+
     clang::FileID GetMainFileID(clang::SourceManager& sourceManager);
 
     void ClearCachedData();
@@ -37,6 +51,14 @@ public:
     std::string CleanRawFilename(llvm::StringRef filename);
 
 private:
+    RuleProfileCounter* GetLocationChecksCounter(llvm::StringRef ruleName);
+    void CountStatistic(std::uint64_t Statistics::* counter);
+
+    bool CheckLocationOfInterest(llvm::StringRef ruleName,
+                                 clang::SourceLocation location,
+                                 clang::SourceManager& sourceManager,
+                                 bool allowMacros);
+
     bool IsLocationInMainFile(clang::SourceLocation location,
                               clang::SourceManager& sourceManager);
     bool IsLocationInMacroExpansion(clang::SourceLocation location,
@@ -0,0 +1,65 @@
+#include "Common/Statistics.h"
+
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+
+double GetPercentage(std::uint64_t part, std::uint64_t total)
+{
+    return (total > 0) ? (100.0 * part / total) : 0.0;
+}
+
+} // anonymous namespace
+
+void Statistics::Add(const Statistics& other)
+{
+    auto counters = GetStatisticsCounters(*this);
+    auto otherCounters = GetStatisticsCounters(other);
+    for (std::size_t i = 0; i < counters.size(); ++i)
+        *counters[i] += *otherCounters[i];
+
+    for (const auto& rule : other.rules)
+        rules[rule.first].Add(rule.second);
+}
+
+void Statistics::Print(std::ostream& str) const
+{
+    std::ios::fmtflags oldFlags = str.flags();
+    str << std::fixed << std::setprecision(1);
+
+    auto printCounter = [&str](const char* name, std::uint64_t value)
+    {
+        str << std::left << std::setw(42) << name << std::right << std::setw(12) << value << "\n";
+    };
+    auto printRejected = [&str, this](const char* name, std::uint64_t value)
+    {
+        str << std::left << std::setw(42) << name << std::right << std::setw(12) << value
+            << std::setw(8) << GetPercentage(value, locationChecks) << "%\n";
+    };
+
+    printCounter("Source files processed", translationUnitsProcessed);
+    printCounter("Source files skipped as already processed", translationUnitsSkipped);
+    printCounter("Location checks", locationChecks);
+    printRejected("  rejected outside main file", locationsOutsideMainFile);
+    printRejected("  rejected in macro expansion", locationsInMacroExpansion);
+    printRejected("  rejected in exclusion zone", locationsInExclusionZone);
+    printCounter("File name cache hits", filenameCacheHits);
+    printCounter("File name cache misses", filenameCacheMisses);
+    str << std::left << std::setw(42) << "File name cache hit ratio" << std::right << std::setw(11)
+        << GetPercentage(filenameCacheHits, filenameCacheHits + filenameCacheMisses) << "%\n";
+    printCounter("Violations printed", violationsPrinted);
+    printCounter("Violations dropped by output filters", violationsFilteredOut);
+
+    str << "\n" << std::left << std::setw(42) << "Rule" << std::right
+        << std::setw(12) << "Matches" << std::setw(12) << "Regexes" << "\n";
+    for (const auto& rule : rules)
+    {
+        str << std::left << std::setw(42) << rule.first << std::right
+            << std::setw(12) << rule.second.matchCallbacks
+            << std::setw(12) << rule.second.regexEvaluations << "\n";
+    }
+
+    str.flags(oldFlags);
+}
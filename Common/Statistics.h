@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+
+struct RuleStatistics
+{
+    std::uint64_t matchCallbacks = 0;
+    std::uint64_t regexEvaluations = 0; // naming patterns
+
+    void Add(const RuleStatistics& other)
+    {
+        matchCallbacks += other.matchCallbacks;
+        regexEvaluations += other.regexEvaluations;
+    }
+};
+
+// Counters of work done while processing source files (see -stats)
+// They are plain integers, as each thread has its own statistics in its context;
+// statistics of source files are merged by the main thread
+struct Statistics
+{
+    std::uint64_t translationUnitsProcessed = 0;
+    std::uint64_t translationUnitsSkipped = 0;   // already processed
+    std::uint64_t locationChecks = 0;            // SourceLocationHelper::IsLocationOfInterest() and variants
+    std::uint64_t locationsOutsideMainFile = 0;  // rejected location checks, by first failed condition
+    std::uint64_t locationsInMacroExpansion = 0;
+    std::uint64_t locationsInExclusionZone = 0;
+    std::uint64_t filenameCacheHits = 0;         // SourceLocationHelper::GetCleanFilename()
+    std::uint64_t filenameCacheMisses = 0;
+    std::uint64_t violationsPrinted = 0;         // OutputPrinter::ShouldPrintLine()
+    std::uint64_t violationsFilteredOut = 0;
+    std::map<std::string, RuleStatistics> rules;
+
+    void Add(const Statistics& other);
+    void Print(std::ostream& str) const;
+};
+
+// all plain counters, for merging and serialization
+template<typename StatisticsType>
+auto GetStatisticsCounters(StatisticsType& statistics) -> std::array<decltype(&statistics.locationChecks), 10>
+{
+    return {{&statistics.translationUnitsProcessed, &statistics.translationUnitsSkipped,
+             &statistics.locationChecks, &statistics.locationsOutsideMainFile,
+             &statistics.locationsInMacroExpansion, &statistics.locationsInExclusionZone,
+             &statistics.filenameCacheHits, &statistics.filenameCacheMisses,
+             &statistics.violationsPrinted, &statistics.violationsFilteredOut}};
+}
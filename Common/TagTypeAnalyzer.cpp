@@ -0,0 +1,240 @@
+#include "Common/TagTypeAnalyzer.h"
+
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/Basic/SourceManager.h>
+
+using namespace clang;
+
+namespace
+{
+
+QualType RecursivelyDesugarType(const QualType& type)
+{
+    QualType desugaredType = type;
+
+    while (true)
+    {
+        const ElaboratedType* elaboratedType = desugaredType->getAs<ElaboratedType>();
+        if (elaboratedType != nullptr)
+        {
+            desugaredType = elaboratedType->desugar();
+            continue;
+        }
+
+        if (desugaredType->isArrayType())
+        {
+            desugaredType = desugaredType->getAsArrayTypeUnsafe()->getElementType();
+            continue;
+        }
+
+        const PointerType* pointerType = desugaredType->getAs<PointerType>();
+        if (pointerType != nullptr)
+        {
+            desugaredType = pointerType->getPointeeType();
+            continue;
+        }
+
+        const ReferenceType* referenceType = desugaredType->getAs<ReferenceType>();
+        if (referenceType != nullptr)
+        {
+            desugaredType = referenceType->getPointeeType();
+            continue;
+        }
+
+        break;
+    }
+
+    return desugaredType;
+}
+
+QualType RecursivelyDesugarTypedefType(const QualType& type)
+{
+    QualType desugaredType = type;
+    bool haveTypedefType = false;
+
+    while (true)
+    {
+        const TypedefType* typedefType = desugaredType->getAs<TypedefType>();
+        if (typedefType != nullptr)
+        {
+            desugaredType = typedefType->desugar();
+            haveTypedefType = true;
+            continue;
+        }
+
+        const ElaboratedType* elaboratedType = desugaredType->getAs<ElaboratedType>();
+        if (elaboratedType != nullptr)
+        {
+            desugaredType = elaboratedType->desugar();
+            continue;
+        }
+
+        if (desugaredType->isArrayType())
+        {
+            desugaredType = desugaredType->getAsArrayTypeUnsafe()->getElementType();
+            continue;
+        }
+
+        const PointerType* pointerType = desugaredType->getAs<PointerType>();
+        if (pointerType != nullptr)
+        {
+            desugaredType = pointerType->getPointeeType();
+            continue;
+        }
+
+        const ReferenceType* referenceType = desugaredType->getAs<ReferenceType>();
+        if (referenceType != nullptr)
+        {
+            desugaredType = referenceType->getPointeeType();
+            continue;
+        }
+
+        break;
+    }
+
+    if (!haveTypedefType)
+    {
+        return QualType();
+    }
+
+    return desugaredType;
+}
+
+QualType GetPointeeType(const QualType& type)
+{
+    const PointerType* pointerType = type->getAs<PointerType>();
+    if (pointerType != nullptr)
+        return pointerType->getPointeeType();
+
+    const ReferenceType* referenceType = type->getAs<ReferenceType>();
+    if (referenceType != nullptr)
+        return referenceType->getPointeeType();
+
+    return QualType();
+}
+
+} // anonymous namespace
+
+TagTypeInfo TagTypeAnalyzer::Analyze(QualType type, SourceManager& sourceManager)
+{
+    if (type.isNull())
+        return TagTypeInfo();
+
+    m_sourceManager = &sourceManager;
+
+    auto it = m_cache.find(type);
+    if (it != m_cache.end())
+        return it->second;
+
+    TagTypeInfo info = AnalyzeUncached(type);
+    m_cache.insert(std::make_pair(type, info));
+    return info;
+}
+
+void TagTypeAnalyzer::Clear()
+{
+    m_cache.clear();
+}
+
+// Alternatives are tried in order, first one finding tag type wins:
+//  - typedef of template specialization with tag type as template argument,
+//  - typedef of tag type, also through pointers, which is not reported as pointer or reference type,
+//  - template specialization with tag type as template argument,
+//  - pointer or reference to tag type,
+//  - tag type itself
+TagTypeInfo TagTypeAnalyzer::AnalyzeUncached(QualType type)
+{
+    TagTypeInfo info;
+
+    QualType typedefDesugaredType = RecursivelyDesugarTypedefType(type);
+    if (! typedefDesugaredType.isNull())
+    {
+        info = AnalyzeTemplateSpecializationType(typedefDesugaredType);
+        if (info.tagDeclaration != nullptr)
+            return info;
+
+        info = AnalyzeActualTagType(typedefDesugaredType);
+        if (info.tagDeclaration != nullptr)
+            return info;
+    }
+
+    QualType desugaredType = RecursivelyDesugarType(type);
+
+    info = AnalyzeTemplateSpecializationType(desugaredType);
+    if (info.tagDeclaration != nullptr)
+        return info;
+
+    QualType pointeeType = GetPointeeType(type);
+    if (! pointeeType.isNull())
+    {
+        info = AnalyzeActualTagType(RecursivelyDesugarType(pointeeType));
+        if (info.tagDeclaration != nullptr)
+        {
+            info.isPointerOrReferenceType = true;
+            return info;
+        }
+    }
+
+    return AnalyzeActualTagType(desugaredType);
+}
+
+TagTypeInfo TagTypeAnalyzer::AnalyzeTemplateSpecializationType(QualType type)
+{
+    const auto* templateSpecializationType = dyn_cast<TemplateSpecializationType>(type.getTypePtr());
+    if (templateSpecializationType == nullptr)
+        return TagTypeInfo();
+
+    for (unsigned i = 0; i < templateSpecializationType->getNumArgs(); ++i)
+    {
+        const TemplateArgument& argument = templateSpecializationType->getArg(i);
+        if (argument.getKind() != TemplateArgument::Type || argument.getAsType().isNull())
+            continue;
+
+        TagTypeInfo info = AnalyzeActualTagType(RecursivelyDesugarType(argument.getAsType()));
+        if (info.tagDeclaration != nullptr)
+            return info;
+    }
+
+    return TagTypeInfo();
+}
+
+TagTypeInfo TagTypeAnalyzer::AnalyzeActualTagType(QualType type)
+{
+    TagTypeInfo info;
+
+    if (type.isNull())
+        return info;
+
+    // the same declarations as found by hasDeclaration() matcher
+    const TagDecl* tagDeclaration = nullptr;
+    if (const auto* enumType = dyn_cast<EnumType>(type.getTypePtr()))
+        tagDeclaration = enumType->getDecl();
+    else
+        tagDeclaration = type->getAsCXXRecordDecl();
+
+    if (tagDeclaration == nullptr)
+        return info;
+
+    SourceLocation expansionLocation = m_sourceManager->getExpansionLoc(tagDeclaration->getLocStart());
+    if (expansionLocation.isValid() && m_sourceManager->isInSystemHeader(expansionLocation))
+        return info;
+
+    info.tagDeclaration = tagDeclaration;
+
+    if (isa<ClassTemplateSpecializationDecl>(tagDeclaration))
+    {
+        info.isTemplateClassType = true;
+        return info;
+    }
+
+    const auto* enumDeclaration = dyn_cast<EnumDecl>(tagDeclaration);
+    if (enumDeclaration != nullptr && ! enumDeclaration->isScopedUsingClassTag())
+    {
+        info.isOldStyleEnum = true;
+        return info;
+    }
+
+    info.isExistingForwardDeclaration = tagDeclaration->getDefinition() == nullptr;
+    return info;
+}
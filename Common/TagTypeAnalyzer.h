@@ -0,0 +1,44 @@
+#pragma once
+
+#include <clang/AST/Type.h>
+
+#include <llvm/ADT/DenseMap.h>
+
+namespace clang
+{
+class SourceManager;
+class TagDecl;
+} // namespace clang
+
+// Tag type referred to by some type, after looking through typedefs, pointers, references, arrays
+// and arguments of template specializations
+struct TagTypeInfo
+{
+    // null if type does not refer to tag type declared outside of system headers
+    const clang::TagDecl* tagDeclaration = nullptr;
+    bool isPointerOrReferenceType = false;
+    bool isTemplateClassType = false;
+    bool isOldStyleEnum = false;
+    bool isExistingForwardDeclaration = false;
+};
+
+// Finds tag types referred to by types of declarations and expressions
+// The same types are seen over and over again in one translation unit, so results are cached;
+// key is type as written, not canonical type, because typedef of pointer is not treated as pointer
+class TagTypeAnalyzer
+{
+public:
+    TagTypeInfo Analyze(clang::QualType type, clang::SourceManager& sourceManager);
+
+    // types are valid only in one translation unit
+    void Clear();
+
+private:
+    TagTypeInfo AnalyzeUncached(clang::QualType type);
+    TagTypeInfo AnalyzeTemplateSpecializationType(clang::QualType type);
+    TagTypeInfo AnalyzeActualTagType(clang::QualType type);
+
+private:
+    clang::SourceManager* m_sourceManager = nullptr;
+    llvm::DenseMap<clang::QualType, TagTypeInfo> m_cache;
+};
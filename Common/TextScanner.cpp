@@ -0,0 +1,243 @@
+#include "Common/TextScanner.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define COLOBOT_LINT_HAVE_SSE2_KERNEL
+#endif
+
+// AVX2 kernel is compiled with target attribute and selected at runtime,
+// which requires __builtin_cpu_supports() and intrinsics usable in target functions
+#if defined(COLOBOT_LINT_HAVE_SSE2_KERNEL) && \
+    ((defined(__clang__) && (__clang_major__ > 3 || (__clang_major__ == 3 && __clang_minor__ >= 8))) || \
+     (!defined(__clang__) && defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#include <immintrin.h>
+#define COLOBOT_LINT_HAVE_AVX2_KERNEL
+#endif
+
+using namespace llvm;
+
+namespace
+{
+
+// Common part of all kernels; kernels only find positions of newline, tab and CR characters
+class LineIndexBuilder
+{
+public:
+    LineIndexBuilder(StringRef text, std::size_t maxLineCount, std::vector<TextLine>& lines)
+        : m_text(text.data()),
+          m_maxLineCount(maxLineCount),
+          m_lines(lines)
+    {
+        // rough guess for source code, to avoid most reallocations
+        m_lines.reserve(std::min(maxLineCount, text.size() / 32 + 1));
+    }
+
+    // masks have bits set for positions of given characters in block of up to 64 bytes starting at given position
+    bool HandleBlock(std::size_t blockPos, std::uint64_t newlineMask, std::uint64_t tabMask, std::uint64_t carriageReturnMask)
+    {
+        while (newlineMask != 0)
+        {
+            unsigned newlineBit = __builtin_ctzll(newlineMask);
+            std::uint64_t lineMask = (std::uint64_t(1) << newlineBit) - 1;
+            if ((tabMask & lineMask) != 0)
+                m_flags |= TextLine_HasTab;
+            if ((carriageReturnMask & lineMask) != 0)
+                m_flags |= TextLine_HasCarriageReturn;
+            tabMask &= ~lineMask;
+            carriageReturnMask &= ~lineMask;
+
+            if (!EndLine(blockPos + newlineBit, TextLine_Terminated))
+                return false;
+
+            newlineMask &= newlineMask - 1;
+        }
+
+        if (tabMask != 0)
+            m_flags |= TextLine_HasTab;
+        if (carriageReturnMask != 0)
+            m_flags |= TextLine_HasCarriageReturn;
+        return true;
+    }
+
+    // returns false when no more lines are needed
+    bool HandleSpecialChar(std::size_t pos)
+    {
+        char ch = m_text[pos];
+        if (ch == '\n')
+            return EndLine(pos, TextLine_Terminated);
+
+        m_flags |= (ch == '\t') ? TextLine_HasTab : TextLine_HasCarriageReturn;
+        return true;
+    }
+
+    void Finish(std::size_t size)
+    {
+        if (m_lineStart < size && m_lines.size() < m_maxLineCount)
+            EndLine(size, 0);
+    }
+
+private:
+    bool EndLine(std::size_t end, std::uint8_t flags)
+    {
+        if (end > m_lineStart && (m_text[end - 1] == ' ' || m_text[end - 1] == '\t'))
+            flags |= TextLine_TrailingWhitespace;
+
+        m_lines.push_back(TextLine{static_cast<std::uint32_t>(m_lineStart),
+                                   static_cast<std::uint32_t>(end - m_lineStart),
+                                   static_cast<std::uint8_t>(m_flags | flags)});
+        m_lineStart = end + 1;
+        m_flags = 0;
+        return m_lines.size() < m_maxLineCount;
+    }
+
+private:
+    const char* m_text;
+    const std::size_t m_maxLineCount;
+    std::vector<TextLine>& m_lines;
+    std::size_t m_lineStart = 0;
+    std::uint8_t m_flags = 0;
+};
+
+bool ScanScalar(const char* text, std::size_t pos, std::size_t size, LineIndexBuilder& builder)
+{
+    for (; pos < size; ++pos)
+    {
+        char ch = text[pos];
+        if (ch == '\n' || ch == '\t' || ch == '\r')
+        {
+            if (!builder.HandleSpecialChar(pos))
+                return false;
+        }
+    }
+    return true;
+}
+
+#ifdef COLOBOT_LINT_HAVE_SSE2_KERNEL
+
+bool ScanSSE2(const char* text, std::size_t size, LineIndexBuilder& builder)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+
+    // 64 bytes at once, so that there is usually at least one line end in each block
+    std::size_t pos = 0;
+    for (; pos + 64 <= size; pos += 64)
+    {
+        std::uint64_t newlineMask = 0, tabMask = 0, carriageReturnMask = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + pos + 16 * i));
+            newlineMask |= std::uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline)) & 0xFFFF) << (16 * i);
+            tabMask |= std::uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, tab)) & 0xFFFF) << (16 * i);
+            carriageReturnMask |= std::uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(block, carriageReturn)) & 0xFFFF) << (16 * i);
+        }
+
+        if (!builder.HandleBlock(pos, newlineMask, tabMask, carriageReturnMask))
+            return false;
+    }
+
+    return ScanScalar(text, pos, size, builder);
+}
+
+#endif
+
+#ifdef COLOBOT_LINT_HAVE_AVX2_KERNEL
+
+__attribute__((target("avx2")))
+bool ScanAVX2(const char* text, std::size_t size, LineIndexBuilder& builder)
+{
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i carriageReturn = _mm256_set1_epi8('\r');
+
+    std::size_t pos = 0;
+    for (; pos + 64 <= size; pos += 64)
+    {
+        std::uint64_t newlineMask = 0, tabMask = 0, carriageReturnMask = 0;
+        for (int i = 0; i < 2; ++i)
+        {
+            __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + pos + 32 * i));
+            newlineMask |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newline)))) << (32 * i);
+            tabMask |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, tab)))) << (32 * i);
+            carriageReturnMask |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, carriageReturn)))) << (32 * i);
+        }
+
+        if (!builder.HandleBlock(pos, newlineMask, tabMask, carriageReturnMask))
+            return false;
+    }
+
+    return ScanScalar(text, pos, size, builder);
+}
+
+#endif
+
+} // anonymous namespace
+
+TextScanKernel GetBestTextScanKernel()
+{
+#ifdef COLOBOT_LINT_HAVE_AVX2_KERNEL
+    static const bool haveAVX2 = __builtin_cpu_supports("avx2");
+    if (haveAVX2)
+        return TextScanKernel::AVX2;
+#endif
+
+#ifdef COLOBOT_LINT_HAVE_SSE2_KERNEL
+    return TextScanKernel::SSE2;
+#else
+    return TextScanKernel::Scalar;
+#endif
+}
+
+const char* GetTextScanKernelName(TextScanKernel kernel)
+{
+    switch (kernel)
+    {
+        case TextScanKernel::Scalar:
+            return "scalar";
+        case TextScanKernel::SSE2:
+            return "SSE2";
+        case TextScanKernel::AVX2:
+            return "AVX2";
+    }
+    return "";
+}
+
+std::vector<TextLine> ScanTextLines(StringRef text, std::size_t maxLineCount)
+{
+    return ScanTextLines(text, maxLineCount, GetBestTextScanKernel());
+}
+
+std::vector<TextLine> ScanTextLines(StringRef text, std::size_t maxLineCount, TextScanKernel kernel)
+{
+    std::vector<TextLine> lines;
+    if (maxLineCount == 0)
+        return lines;
+
+    LineIndexBuilder builder(text, maxLineCount, lines);
+
+    bool scannedAll = false;
+    switch (kernel)
+    {
+#ifdef COLOBOT_LINT_HAVE_AVX2_KERNEL
+        case TextScanKernel::AVX2:
+            scannedAll = ScanAVX2(text.data(), text.size(), builder);
+            break;
+#endif
+#ifdef COLOBOT_LINT_HAVE_SSE2_KERNEL
+        case TextScanKernel::SSE2:
+            scannedAll = ScanSSE2(text.data(), text.size(), builder);
+            break;
+#endif
+        default:
+            scannedAll = ScanScalar(text.data(), 0, text.size(), builder);
+            break;
+    }
+
+    if (scannedAll)
+        builder.Finish(text.size());
+
+    return lines;
+}
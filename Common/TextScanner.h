@@ -0,0 +1,48 @@
+#pragma once
+
+#include <llvm/ADT/StringRef.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+enum TextLineFlags : std::uint8_t
+{
+    TextLine_Terminated         = 1 << 0, // line ends with newline character
+    TextLine_TrailingWhitespace = 1 << 1, // space or tab just before end of line
+    TextLine_HasTab             = 1 << 2,
+    TextLine_HasCarriageReturn  = 1 << 3
+};
+
+struct TextLine
+{
+    std::uint32_t offset;
+    std::uint32_t length; // without newline character
+    std::uint8_t flags;
+
+    bool Has(TextLineFlags flag) const { return (flags & flag) != 0; }
+};
+
+enum class TextScanKernel
+{
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// The fastest kernel supported by CPU we are running on
+TextScanKernel GetBestTextScanKernel();
+
+const char* GetTextScanKernelName(TextScanKernel kernel);
+
+// Splits text into lines in a single pass, noting tabs, CR bytes and trailing whitespace in each line
+// Last line without newline character is included only if it is not empty
+// Scanning stops after maxLineCount lines, so that only beginning of large file can be looked at
+std::vector<TextLine> ScanTextLines(llvm::StringRef text,
+                                    std::size_t maxLineCount = std::numeric_limits<std::size_t>::max());
+
+// The same with given kernel, which must be supported by CPU; used for benchmarking
+std::vector<TextLine> ScanTextLines(llvm::StringRef text,
+                                    std::size_t maxLineCount,
+                                    TextScanKernel kernel);
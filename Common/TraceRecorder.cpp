@@ -0,0 +1,141 @@
+#include "Common/TraceRecorder.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+namespace
+{
+
+void WriteJsonString(std::ostream& str, const std::string& value)
+{
+    str << '"';
+    for (char c : value)
+    {
+        switch (c)
+        {
+            case '"':
+                str << "\\\"";
+                break;
+            case '\\':
+                str << "\\\\";
+                break;
+            case '\n':
+                str << "\\n";
+                break;
+            case '\t':
+                str << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    str << ' ';
+                else
+                    str << c;
+                break;
+        }
+    }
+    str << '"';
+}
+
+} // anonymous namespace
+
+TraceRecorder::TraceRecorder(unsigned trackId)
+    : m_trackId(trackId)
+{}
+
+std::uint64_t TraceRecorder::GetCurrentTimeUs()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+void TraceRecorder::AddSpan(const std::string& name,
+                            const std::string& category,
+                            std::uint64_t startTimeUs,
+                            std::uint64_t endTimeUs,
+                            const std::string& fileName)
+{
+    std::uint64_t durationUs = (endTimeUs > startTimeUs) ? (endTimeUs - startTimeUs) : 0;
+    m_events.push_back(TraceEvent{name, category, fileName, startTimeUs, durationUs, m_trackId});
+}
+
+std::vector<TraceEvent> TraceRecorder::TakeEvents()
+{
+    std::vector<TraceEvent> events;
+    events.swap(m_events);
+    return events;
+}
+
+void TraceRecorder::AddEvents(const std::vector<TraceEvent>& events)
+{
+    m_events.insert(m_events.end(), events.begin(), events.end());
+}
+
+bool TraceRecorder::Save(const std::string& fileName) const
+{
+    std::ofstream str(fileName.c_str());
+    str << "{\"traceEvents\": [\n";
+
+    std::set<unsigned> trackIds;
+    for (const auto& event : m_events)
+    {
+        trackIds.insert(event.trackId);
+
+        str << "{\"name\": ";
+        WriteJsonString(str, event.name);
+        str << ", \"cat\": ";
+        WriteJsonString(str, event.category);
+        str << ", \"ph\": \"X\", \"ts\": " << event.startTimeUs
+            << ", \"dur\": " << event.durationUs
+            << ", \"pid\": 1, \"tid\": " << event.trackId;
+        if (!event.fileName.empty())
+        {
+            str << ", \"args\": {\"file\": ";
+            WriteJsonString(str, event.fileName);
+            str << "}";
+        }
+        str << "},\n";
+    }
+
+    // names of tracks shown by trace viewer
+    trackIds.insert(m_trackId);
+    bool first = true;
+    for (unsigned trackId : trackIds)
+    {
+        str << (first ? "" : ",\n");
+        str << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << trackId << ", \"args\": {\"name\": ";
+        WriteJsonString(str, (trackId == m_trackId) ? std::string("main") : "worker " + std::to_string(trackId));
+        str << "}}";
+        first = false;
+    }
+
+    str << "\n]}\n";
+
+    if (!str.good())
+    {
+        std::cerr << "Could not write trace file \"" << fileName << "\"" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+TraceSpan::TraceSpan(TraceRecorder* recorder, std::string name, std::string category, std::string fileName)
+    : m_recorder(recorder),
+      m_startTimeUs(0)
+{
+    if (m_recorder == nullptr)
+        return;
+
+    m_name = std::move(name);
+    m_category = std::move(category);
+    m_fileName = std::move(fileName);
+    m_startTimeUs = TraceRecorder::GetCurrentTimeUs();
+}
+
+TraceSpan::~TraceSpan()
+{
+    if (m_recorder != nullptr)
+        m_recorder->AddSpan(m_name, m_category, m_startTimeUs, TraceRecorder::GetCurrentTimeUs(), m_fileName);
+}
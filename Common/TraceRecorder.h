@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct TraceEvent
+{
+    std::string name;
+    std::string category;
+    std::string fileName; // shown in details of event; may be empty
+    std::uint64_t startTimeUs;
+    std::uint64_t durationUs;
+    unsigned trackId;
+};
+
+// Records spans of processing in Chrome trace event format (see -trace-file)
+// Each thread has its own recorder in its context, writing to its own track; events of source files
+// are collected by the main thread, whose recorder writes the final trace file
+class TraceRecorder
+{
+public:
+    explicit TraceRecorder(unsigned trackId);
+
+    // monotonic time which is the same in all threads and processes
+    static std::uint64_t GetCurrentTimeUs();
+
+    void AddSpan(const std::string& name,
+                 const std::string& category,
+                 std::uint64_t startTimeUs,
+                 std::uint64_t endTimeUs,
+                 const std::string& fileName = "");
+
+    std::vector<TraceEvent> TakeEvents();
+    void AddEvents(const std::vector<TraceEvent>& events);
+
+    bool Save(const std::string& fileName) const;
+
+private:
+    const unsigned m_trackId;
+    std::vector<TraceEvent> m_events;
+};
+
+// Records span from construction to destruction; does nothing if recorder is null
+class TraceSpan
+{
+public:
+    TraceSpan(TraceRecorder* recorder, std::string name, std::string category, std::string fileName = "");
+    ~TraceSpan();
+
+private:
+    TraceRecorder* m_recorder;
+    std::string m_name;
+    std::string m_category;
+    std::string m_fileName;
+    std::uint64_t m_startTimeUs;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+// Limits of resources used for processing of single source file; 0 means no limit
+struct TranslationUnitLimits
+{
+    double timeLimitSeconds = 0.0;     // processing is aborted above this limit
+    double softTimeLimitSeconds = 0.0; // source files processed longer than this are only logged
+    std::size_t memoryLimitBytes = 0;  // processing is aborted above this limit
+
+    bool IsAnySet() const
+    {
+        return timeLimitSeconds > 0.0 || softTimeLimitSeconds > 0.0 || memoryLimitBytes > 0;
+    }
+};
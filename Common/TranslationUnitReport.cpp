@@ -0,0 +1,164 @@
+#include "Common/TranslationUnitReport.h"
+
+#include "Common/Context.h"
+#include "Common/OutputPrinter.h"
+#include "Common/SerializationHelper.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <algorithm>
+
+void ReplayTranslationUnitReport(const TranslationUnitReport& report, Context& context)
+{
+    for (const auto& violation : report.violations)
+    {
+        if (violation.uniqueKey.empty())
+        {
+            context.outputPrinter->PrintRuleViolation(
+                violation.ruleName,
+                violation.severity,
+                violation.description,
+                violation.fileName,
+                violation.lineNumber);
+        }
+        else
+        {
+            context.outputPrinter->PrintUniqueRuleViolation(
+                violation.uniqueKey,
+                violation.ruleName,
+                violation.severity,
+                violation.description,
+                violation.fileName,
+                violation.lineNumber);
+        }
+    }
+
+    for (const auto& edge : report.graphEdges)
+    {
+        context.outputPrinter->PrintGraphEdge(edge.source, edge.destination, edge.options);
+    }
+
+    // this gives the same result as if UndefinedFunctionRule saw declarations of this translation unit
+    // after all previously replayed ones
+    for (const auto& definedFunction : report.definedFunctions)
+    {
+        context.definedFunctions.insert(definedFunction);
+        context.undefinedFunctions.erase(definedFunction);
+    }
+
+    for (const auto& undefinedFunction : report.undefinedFunctions)
+    {
+        if (context.definedFunctions.count(undefinedFunction.first) == 0)
+            context.undefinedFunctions.insert(undefinedFunction);
+    }
+}
+
+void SerializeTranslationUnitReport(const TranslationUnitReport& report, std::ostream& str)
+{
+    WriteCount(str, report.violations.size());
+    for (const auto& violation : report.violations)
+    {
+        WriteString(str, violation.ruleName);
+        WriteInt(str, static_cast<int>(violation.severity));
+        WriteString(str, violation.description);
+        WriteString(str, violation.fileName);
+        WriteInt(str, violation.lineNumber);
+        WriteString(str, violation.uniqueKey);
+    }
+
+    WriteCount(str, report.graphEdges.size());
+    for (const auto& edge : report.graphEdges)
+    {
+        WriteString(str, edge.source);
+        WriteString(str, edge.destination);
+        WriteString(str, edge.options);
+    }
+
+    std::vector<std::string> definedFunctions(report.definedFunctions.begin(), report.definedFunctions.end());
+    std::sort(definedFunctions.begin(), definedFunctions.end());
+    WriteCount(str, definedFunctions.size());
+    for (const auto& definedFunction : definedFunctions)
+    {
+        WriteString(str, definedFunction);
+    }
+
+    WriteCount(str, report.undefinedFunctions.size());
+    for (const auto& undefinedFunction : report.undefinedFunctions)
+    {
+        WriteString(str, undefinedFunction.first);
+        WriteString(str, undefinedFunction.second.fileName);
+        WriteInt(str, undefinedFunction.second.lineNumber);
+    }
+
+    WriteInt(str, report.failed ? 1 : 0);
+}
+
+bool DeserializeTranslationUnitReport(std::istream& str, TranslationUnitReport& report)
+{
+    std::size_t count = 0;
+
+    if (!ReadElementCount(str, count))
+        return false;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ReportedViolation violation;
+        int severity = 0;
+        if (!ReadString(str, violation.ruleName) ||
+            !ReadInt(str, severity) ||
+            !ReadString(str, violation.description) ||
+            !ReadString(str, violation.fileName) ||
+            !ReadInt(str, violation.lineNumber) ||
+            !ReadString(str, violation.uniqueKey))
+        {
+            return false;
+        }
+        violation.severity = static_cast<Severity>(severity);
+        report.violations.push_back(std::move(violation));
+    }
+
+    if (!ReadElementCount(str, count))
+        return false;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ReportedGraphEdge edge;
+        if (!ReadString(str, edge.source) ||
+            !ReadString(str, edge.destination) ||
+            !ReadString(str, edge.options))
+        {
+            return false;
+        }
+        report.graphEdges.push_back(std::move(edge));
+    }
+
+    if (!ReadElementCount(str, count))
+        return false;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::string definedFunction;
+        if (!ReadString(str, definedFunction))
+            return false;
+        report.definedFunctions.insert(std::move(definedFunction));
+    }
+
+    if (!ReadElementCount(str, count))
+        return false;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::string name;
+        SourceFileInfo info;
+        if (!ReadString(str, name) ||
+            !ReadString(str, info.fileName) ||
+            !ReadInt(str, info.lineNumber))
+        {
+            return false;
+        }
+        report.undefinedFunctions[name] = std::move(info);
+    }
+
+    int failed = 0;
+    if (!ReadInt(str, failed))
+        return false;
+    report.failed = (failed != 0);
+
+    return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Common/Severity.h"
+#include "Common/SourceFileInfo.h"
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+struct Context;
+
+struct ReportedViolation
+{
+    std::string ruleName;
+    Severity severity;
+    std::string description;
+    std::string fileName;
+    int lineNumber;
+    std::string uniqueKey; // if not empty, violation is reported only once per whole run
+};
+
+struct ReportedGraphEdge
+{
+    std::string source;
+    std::string destination;
+    std::string options;
+};
+
+// Everything that processing of single source file contributes to final output
+// This is recorded separately for each source file, so that it can be later replayed
+// in the same order as source files would be processed in serial run
+struct TranslationUnitReport
+{
+    std::vector<ReportedViolation> violations;
+    std::vector<ReportedGraphEdge> graphEdges;
+    std::unordered_set<std::string> definedFunctions;
+    std::map<std::string, SourceFileInfo> undefinedFunctions;
+    bool failed = false;
+};
+
+void ReplayTranslationUnitReport(const TranslationUnitReport& report, Context& context);
+
+// Binary-safe text serialization of report, so that it can be stored and replayed by another process
+void SerializeTranslationUnitReport(const TranslationUnitReport& report, std::ostream& str);
+bool DeserializeTranslationUnitReport(std::istream& str, TranslationUnitReport& report);
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+inline std::string GetAbsolutePath(const std::string& directory, const std::string& path)
+{
+    if (llvm::sys::path::is_absolute(path))
+        return path;
+
+    llvm::SmallString<256> absolutePath(directory);
+    llvm::sys::path::append(absolutePath, path);
+    return absolutePath.str();
+}
+
+// Source file argument of compile command, which may be given relative to its directory
+inline std::vector<std::string>::iterator FindSourceArgument(std::vector<std::string>& commandLine,
+                                                             const std::string& directory,
+                                                             const std::string& sourcePath)
+{
+    if (commandLine.empty())
+        return commandLine.end();
+
+    return std::find_if(commandLine.begin() + 1, commandLine.end(),
+        [&](const std::string& arg)
+        {
+            return arg == sourcePath || GetAbsolutePath(directory, arg) == sourcePath;
+        });
+}
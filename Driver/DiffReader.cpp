@@ -0,0 +1,110 @@
+#include "Driver/DiffReader.h"
+
+#include "Common/SourceLocationHelper.h"
+
+#include "Driver/CompileCommandHelper.h"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+
+#include <boost/regex.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace llvm;
+
+namespace
+{
+
+std::string GetNewFilePath(StringRef diffLine, const std::string& baseDirectory)
+{
+    StringRef path = diffLine.substr(4); // "+++ "
+    path = path.split('\t').first.rtrim();
+
+    if (path == "/dev/null")
+        return "";
+
+    if (path.startswith("b/") && sys::fs::exists(GetAbsolutePath(baseDirectory, path.substr(2))))
+        path = path.substr(2);
+
+    return GetAbsolutePath(baseDirectory, path);
+}
+
+} // anonymous namespace
+
+boost::optional<std::vector<OutputFilter>> ReadDiffFile(const std::string& diffFileName,
+                                                        const std::string& baseDirectory,
+                                                        SourceLocationHelper& sourceLocationHelper)
+{
+    std::ifstream str(diffFileName.c_str());
+    if (!str.good())
+    {
+        std::cerr << "Could not read diff file " << diffFileName << "!" << std::endl;
+        return boost::none;
+    }
+
+    const boost::regex hunkHeaderPattern("^@@ -[0-9]+(,([0-9]+))? \\+([0-9]+)(,([0-9]+))? @@");
+
+    std::vector<OutputFilter> filters;
+    std::string currentFile;
+    std::string line;
+    // lines of current hunk not read yet; inside hunk, lines starting with "+++ " or "--- " are added or removed lines
+    int oldLinesLeft = 0, newLinesLeft = 0;
+    while (std::getline(str, line))
+    {
+        if (oldLinesLeft > 0 || newLinesLeft > 0)
+        {
+            if (StringRef(line).startswith("+"))
+                --newLinesLeft;
+            else if (StringRef(line).startswith("-"))
+                --oldLinesLeft;
+            else if (!StringRef(line).startswith("\\")) // "\ No newline at end of file"
+            {
+                // context line, which may have lost its leading space
+                --oldLinesLeft;
+                --newLinesLeft;
+            }
+            continue;
+        }
+
+        if (StringRef(line).startswith("+++ "))
+        {
+            currentFile = GetNewFilePath(line, baseDirectory);
+            if (!currentFile.empty())
+                currentFile = sourceLocationHelper.CleanRawFilename(currentFile);
+            continue;
+        }
+
+        boost::smatch hunkHeader;
+        if (!boost::regex_search(line, hunkHeader, hunkHeaderPattern))
+            continue;
+
+        oldLinesLeft = hunkHeader[2].matched ? std::atoi(hunkHeader[2].str().c_str()) : 1;
+        int startLineNumber = std::atoi(hunkHeader[3].str().c_str());
+        int lineCount = hunkHeader[5].matched ? std::atoi(hunkHeader[5].str().c_str()) : 1;
+        newLinesLeft = lineCount;
+
+        if (currentFile.empty())
+            continue;
+
+        OutputFilter filter;
+        filter.fileName = currentFile;
+        if (lineCount == 0)
+        {
+            // start line is the line just before deleted lines
+            filter.startLineNumber = std::max(startLineNumber, 1);
+            filter.endLineNumber = startLineNumber + 1;
+        }
+        else
+        {
+            filter.startLineNumber = startLineNumber;
+            filter.endLineNumber = startLineNumber + lineCount - 1;
+        }
+        filters.push_back(std::move(filter));
+    }
+
+    return filters;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Common/OutputPrinter.h"
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+
+class SourceLocationHelper;
+
+// Reads unified diff (for example output of "git diff -U0") and gives ranges of changed lines
+// in new versions of files, as output filters with clean absolute file names
+// Paths in diff are relative to given base directory; "b/" prefix added by git is removed
+// Deleted lines are represented by lines around the place of deletion
+boost::optional<std::vector<OutputFilter>> ReadDiffFile(const std::string& diffFileName,
+                                                        const std::string& baseDirectory,
+                                                        SourceLocationHelper& sourceLocationHelper);
@@ -0,0 +1,71 @@
+#include "Driver/FileManagerCache.h"
+
+#include "Common/FileSystemHelper.h"
+
+#include <clang/Basic/FileManager.h>
+#include <clang/Basic/FileSystemOptions.h>
+
+#include <llvm/Support/Path.h>
+
+using namespace clang;
+using namespace llvm;
+
+FileManagerCache::FileManagerCache()
+{}
+
+FileManagerCache::~FileManagerCache()
+{}
+
+FileManager* FileManagerCache::GetFileManager(unsigned workerIndex, const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& fileManager = m_fileManagers[std::make_pair(workerIndex, directory)];
+    if (fileManager == nullptr)
+    {
+        FileSystemOptions fileSystemOptions;
+        fileSystemOptions.WorkingDir = directory;
+        fileManager = new FileManager(fileSystemOptions);
+    }
+
+    return fileManager.get();
+}
+
+void FileManagerCache::RecordInputFiles(const std::set<std::string>& inputFiles)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto& inputFile : inputFiles)
+    {
+        if (m_inputFileModificationTimes.count(inputFile) == 0)
+            m_inputFileModificationTimes[inputFile] = GetModificationTimeNs(inputFile);
+
+        // FileManager also remembers files that were not found, so new files are noticed
+        // by changes of directories
+        std::string directory = sys::path::parent_path(inputFile);
+        if (!directory.empty() && m_inputFileModificationTimes.count(directory) == 0)
+            m_inputFileModificationTimes[directory] = GetModificationTimeNs(directory);
+    }
+}
+
+bool FileManagerCache::InvalidateIfFilesChanged()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    bool filesChanged = false;
+    for (const auto& inputFile : m_inputFileModificationTimes)
+    {
+        if (GetModificationTimeNs(inputFile.first) != inputFile.second)
+        {
+            filesChanged = true;
+            break;
+        }
+    }
+
+    if (!filesChanged)
+        return false;
+
+    m_fileManagers.clear();
+    m_inputFileModificationTimes.clear();
+    return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <llvm/ADT/IntrusiveRefCntPtr.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+
+namespace clang
+{
+class FileManager;
+} // namespace clang
+
+// FileManagers of parallel lint workers, which can be kept between runs (in daemon mode) to reuse
+// their cached file system lookups
+// As FileManager never notices changes on disk, whole cache is dropped when any of the files read
+// in previous runs has changed
+class FileManagerCache
+{
+public:
+    FileManagerCache();
+    ~FileManagerCache();
+
+    // FileManager is not thread-safe, so each worker gets its own
+    clang::FileManager* GetFileManager(unsigned workerIndex, const std::string& directory);
+
+    void RecordInputFiles(const std::set<std::string>& inputFiles);
+
+    // returns true if cache was dropped
+    bool InvalidateIfFilesChanged();
+
+private:
+    std::mutex m_mutex;
+    std::map<std::pair<unsigned, std::string>, llvm::IntrusiveRefCntPtr<clang::FileManager>> m_fileManagers;
+    std::map<std::string, std::int64_t> m_inputFileModificationTimes;
+};
@@ -0,0 +1,123 @@
+#include "Driver/HeaderChecks.h"
+
+#include "Driver/CompileCommandHelper.h"
+
+#include "Handlers/BeginSourceFileHandler.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace llvm;
+using namespace clang::tooling;
+
+namespace
+{
+
+const char* const HEADER_EXTENSIONS[] = { ".h", ".hh", ".hpp", ".hxx" };
+const char* const SOURCE_EXTENSIONS[] = { ".cpp", ".cc", ".cxx" };
+
+const char* const HEADER_CHECK_SOURCE_SUFFIX = ".header-check.cpp";
+
+bool IsSourceFile(StringRef path)
+{
+    StringRef extension = sys::path::extension(path);
+    return std::find(std::begin(SOURCE_EXTENSIONS), std::end(SOURCE_EXTENSIONS), extension) != std::end(SOURCE_EXTENSIONS);
+}
+
+int GetCommonDirectoryDepth(StringRef leftPath, StringRef rightPath)
+{
+    StringRef leftDirectory = sys::path::parent_path(leftPath);
+    StringRef rightDirectory = sys::path::parent_path(rightPath);
+
+    int depth = 0;
+    for (auto leftIt = sys::path::begin(leftDirectory), rightIt = sys::path::begin(rightDirectory);
+         leftIt != sys::path::end(leftDirectory) && rightIt != sys::path::end(rightDirectory) && *leftIt == *rightIt;
+         ++leftIt, ++rightIt)
+    {
+        ++depth;
+    }
+    return depth;
+}
+
+} // anonymous namespace
+
+bool IsHeaderFile(StringRef path)
+{
+    StringRef extension = sys::path::extension(path);
+    return std::find(std::begin(HEADER_EXTENSIONS), std::end(HEADER_EXTENSIONS), extension) != std::end(HEADER_EXTENSIONS);
+}
+
+std::string GetHeaderCheckSourcePath(const std::string& headerPath)
+{
+    return headerPath + HEADER_CHECK_SOURCE_SUFFIX;
+}
+
+std::string GetHeaderCheckSourceContent(const std::string& headerPath)
+{
+    return "#include \"" + headerPath + "\"\n";
+}
+
+HeaderCheckCompileCommands::HeaderCheckCompileCommands(const CompilationDatabase& compilations)
+    : m_compilations(compilations)
+{}
+
+std::vector<CompileCommand> HeaderCheckCompileCommands::GetCompileCommands(const std::string& headerPath)
+{
+    std::string siblingSourceFile = FindSiblingSourceFile(headerPath);
+    if (siblingSourceFile.empty())
+        return {};
+
+    std::string headerCheckSourcePath = GetHeaderCheckSourcePath(headerPath);
+
+    std::vector<CompileCommand> compileCommands;
+    for (auto& compileCommand : m_compilations.getCompileCommands(siblingSourceFile))
+    {
+        auto sourceArg = FindSourceArgument(compileCommand.CommandLine, compileCommand.Directory, siblingSourceFile);
+        if (sourceArg == compileCommand.CommandLine.end())
+            continue;
+
+        *sourceArg = headerCheckSourcePath;
+        compileCommands.push_back(std::move(compileCommand));
+    }
+
+    return compileCommands;
+}
+
+// Source file with the same name as header if there is one, otherwise the closest one in directory tree
+std::string HeaderCheckCompileCommands::FindSiblingSourceFile(const std::string& headerPath)
+{
+    for (const char* extension : SOURCE_EXTENSIONS)
+    {
+        SmallString<256> sourceFile(headerPath);
+        sys::path::replace_extension(sourceFile, extension);
+        if (!m_compilations.getCompileCommands(sourceFile).empty())
+            return sourceFile.str();
+    }
+
+    if (!m_allFilesLoaded)
+    {
+        m_allFiles = m_compilations.getAllFiles();
+        std::sort(m_allFiles.begin(), m_allFiles.end());
+        m_allFilesLoaded = true;
+    }
+
+    std::string closestSourceFile;
+    int closestDepth = -1;
+    for (const auto& file : m_allFiles)
+    {
+        if (!IsSourceFile(file) || BeginSourceFileHandler::IsFakeHeaderSource(file))
+            continue;
+
+        int depth = GetCommonDirectoryDepth(headerPath, file);
+        if (depth > closestDepth)
+        {
+            closestSourceFile = file;
+            closestDepth = depth;
+        }
+    }
+
+    return closestSourceFile;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include <llvm/ADT/StringRef.h>
+
+#include <string>
+#include <vector>
+
+// Header checks (-lint-headers) work like fake header sources generated by the build, which consist of
+// single include of the checked header, but the sources are synthesized in memory and their compile commands
+// are taken from source files next to the headers
+
+bool IsHeaderFile(llvm::StringRef path);
+
+std::string GetHeaderCheckSourcePath(const std::string& headerPath);
+std::string GetHeaderCheckSourceContent(const std::string& headerPath);
+
+class HeaderCheckCompileCommands
+{
+public:
+    explicit HeaderCheckCompileCommands(const clang::tooling::CompilationDatabase& compilations);
+
+    // returns empty vector if there is no source file to take compile commands from
+    std::vector<clang::tooling::CompileCommand> GetCompileCommands(const std::string& headerPath);
+
+private:
+    std::string FindSiblingSourceFile(const std::string& headerPath);
+
+private:
+    const clang::tooling::CompilationDatabase& m_compilations;
+    bool m_allFilesLoaded = false;
+    std::vector<std::string> m_allFiles;
+};
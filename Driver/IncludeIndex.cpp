@@ -0,0 +1,163 @@
+#include "Driver/IncludeIndex.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+
+const char* INCLUDE_INDEX_HEADER = "# colobot-lint include index v1: S <source file> | F <source file numbers> <file>";
+
+} // anonymous namespace
+
+bool IncludeIndex::Load(const std::string& fileName)
+{
+    std::ifstream str(fileName.c_str());
+    if (!str.good())
+        return true;
+
+    auto printError = [this, &fileName]()
+    {
+        std::cerr << "Ignoring invalid include index file \"" << fileName << "\"" << std::endl;
+        m_sourceFiles.clear();
+        m_includingSourceFiles.clear();
+    };
+
+    std::vector<std::string> sourceFiles;
+    std::string line;
+    while (std::getline(str, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        if (line.size() > 2 && line.compare(0, 2, "S ") == 0)
+        {
+            sourceFiles.push_back(line.substr(2));
+            m_sourceFiles.insert(sourceFiles.back());
+            continue;
+        }
+
+        std::istringstream lineStr(line);
+        std::string type, sourceNumbers, path;
+        lineStr >> type >> sourceNumbers;
+        lineStr.get(); // separating space; path may contain spaces itself
+        std::getline(lineStr, path);
+        if (lineStr.fail() || type != "F" || path.empty())
+        {
+            printError();
+            return false;
+        }
+
+        std::set<std::string>& includingSourceFiles = m_includingSourceFiles[path];
+        std::istringstream numbersStr(sourceNumbers);
+        std::size_t number = 0;
+        while (numbersStr >> number)
+        {
+            if (number >= sourceFiles.size())
+            {
+                printError();
+                return false;
+            }
+            includingSourceFiles.insert(sourceFiles[number]);
+            numbersStr.get(); // comma
+        }
+    }
+
+    return true;
+}
+
+bool IncludeIndex::Save(const std::string& fileName) const
+{
+    // written to temporary file and renamed, so that concurrent runs never see partially written index
+    std::string tempFileName = fileName + ".tmp." + std::to_string(getpid());
+
+    {
+        std::ofstream str(tempFileName.c_str());
+        str << INCLUDE_INDEX_HEADER << "\n";
+
+        std::map<std::string, std::size_t> sourceFileNumbers;
+        for (const auto& sourceFile : m_sourceFiles)
+        {
+            sourceFileNumbers.insert({sourceFile, sourceFileNumbers.size()});
+            str << "S " << sourceFile << "\n";
+        }
+
+        for (const auto& file : m_includingSourceFiles)
+        {
+            str << "F ";
+            bool first = true;
+            for (const auto& sourceFile : file.second)
+            {
+                str << (first ? "" : ",") << sourceFileNumbers[sourceFile];
+                first = false;
+            }
+            str << " " << file.first << "\n";
+        }
+
+        if (!str.good())
+        {
+            std::cerr << "Could not write include index file \"" << fileName << "\"" << std::endl;
+            std::remove(tempFileName.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tempFileName.c_str(), fileName.c_str()) != 0)
+    {
+        std::cerr << "Could not write include index file \"" << fileName << "\"" << std::endl;
+        std::remove(tempFileName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void IncludeIndex::Update(const std::map<std::string, std::set<std::string>>& inputFilesBySourceFile)
+{
+    if (inputFilesBySourceFile.empty())
+        return;
+
+    // one pass over whole index removes old entries of all updated source files
+    for (auto it = m_includingSourceFiles.begin(); it != m_includingSourceFiles.end();)
+    {
+        for (const auto& sourceFile : inputFilesBySourceFile)
+            it->second.erase(sourceFile.first);
+
+        if (it->second.empty())
+            it = m_includingSourceFiles.erase(it);
+        else
+            ++it;
+    }
+
+    for (const auto& sourceFile : inputFilesBySourceFile)
+    {
+        m_sourceFiles.insert(sourceFile.first);
+        for (const auto& inputFile : sourceFile.second)
+            m_includingSourceFiles[inputFile].insert(sourceFile.first);
+    }
+}
+
+bool IncludeIndex::IsSourceFileKnown(const std::string& sourcePath) const
+{
+    return m_sourceFiles.count(sourcePath) > 0;
+}
+
+std::set<std::string> IncludeIndex::GetAffectedSourceFiles(const std::set<std::string>& changedFiles) const
+{
+    std::set<std::string> affectedSourceFiles;
+    for (const auto& changedFile : changedFiles)
+    {
+        if (m_sourceFiles.count(changedFile) > 0)
+            affectedSourceFiles.insert(changedFile);
+
+        auto it = m_includingSourceFiles.find(changedFile);
+        if (it != m_includingSourceFiles.end())
+            affectedSourceFiles.insert(it->second.begin(), it->second.end());
+    }
+    return affectedSourceFiles;
+}
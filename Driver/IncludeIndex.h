@@ -0,0 +1,28 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+
+// Reverse index of includes: for each file, source files which include it (directly or not)
+// Persisted in a compact text file, where each source file is written once and referred to by number
+// Used to find out which source files need to be processed again when some files are changed
+class IncludeIndex
+{
+public:
+    // missing file is not an error, it just gives empty index
+    bool Load(const std::string& fileName);
+    bool Save(const std::string& fileName) const;
+
+    // replaces everything known about given source files with files read while processing them
+    void Update(const std::map<std::string, std::set<std::string>>& inputFilesBySourceFile);
+
+    bool IsSourceFileKnown(const std::string& sourcePath) const;
+
+    // source files which are among changed files or include any of them
+    std::set<std::string> GetAffectedSourceFiles(const std::set<std::string>& changedFiles) const;
+
+private:
+    std::set<std::string> m_sourceFiles;
+    std::map<std::string, std::set<std::string>> m_includingSourceFiles;
+};
@@ -0,0 +1,548 @@
+#include "Driver/LintDaemon.h"
+
+#include "Common/Context.h"
+#include "Common/FileSystemHelper.h"
+#include "Common/OutputPrinter.h"
+#include "Common/SerializationHelper.h"
+#include "Common/SourceLocationHelper.h"
+#include "Common/TranslationUnitReport.h"
+
+#include "Driver/FileManagerCache.h"
+#include "Driver/SocketMessages.h"
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace llvm;
+using namespace clang::tooling;
+
+namespace
+{
+
+const char* LINT_REQUEST_HEADER = "colobot-lint request v2";
+
+volatile std::sig_atomic_t g_daemonStopRequested = 0;
+
+void RequestDaemonStop(int)
+{
+    g_daemonStopRequested = 1;
+}
+
+///////////////////////////
+
+bool InitSocketAddress(const std::string& socketPath, sockaddr_un& address)
+{
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path is too long: \"" << socketPath << "\"" << std::endl;
+        return false;
+    }
+
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    return true;
+}
+
+int ConnectToSocket(const std::string& socketPath)
+{
+    sockaddr_un address;
+    if (!InitSocketAddress(socketPath, address))
+        return -1;
+
+    int socketFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socketFd < 0)
+        return -1;
+
+    if (connect(socketFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(socketFd);
+        return -1;
+    }
+
+    return socketFd;
+}
+
+std::string GetAbsolutePath(const std::string& path)
+{
+    SmallString<256> absolutePath(path);
+    sys::fs::make_absolute(absolutePath);
+    return absolutePath.str();
+}
+
+///////////////////////////
+
+struct LintRequest
+{
+    std::string buildPath;
+    std::vector<std::string> sourcePaths;
+    std::set<std::string> rulesSelection;
+    std::set<std::string> projectLocalIncludePaths;
+    std::vector<std::string> licenseTemplateLines;
+    std::string generatorSelection;
+    ShardSelection shard;
+    bool lintHeaders = false;
+    bool skipUnchangedSourceFiles = false;
+    std::set<std::string> changedFiles;
+    std::string includeIndexFile;
+};
+
+std::string SerializeLintRequest(const LintRequest& request)
+{
+    std::ostringstream str;
+    WriteString(str, LINT_REQUEST_HEADER);
+    WriteString(str, request.buildPath);
+    WriteStrings(str, request.sourcePaths);
+    WriteStrings(str, request.rulesSelection);
+    WriteStrings(str, request.projectLocalIncludePaths);
+    WriteStrings(str, request.licenseTemplateLines);
+    WriteString(str, request.generatorSelection);
+    WriteInt(str, request.shard.index);
+    WriteInt(str, request.shard.count);
+    WriteInt(str, request.lintHeaders ? 1 : 0);
+    WriteInt(str, request.skipUnchangedSourceFiles ? 1 : 0);
+    WriteStrings(str, request.changedFiles);
+    WriteString(str, request.includeIndexFile);
+    return str.str();
+}
+
+bool DeserializeLintRequest(const std::string& message, LintRequest& request)
+{
+    std::istringstream str(message);
+
+    std::string header;
+    if (!ReadString(str, header) || header != LINT_REQUEST_HEADER)
+        return false;
+
+    int shardIndex = 0, shardCount = 0, lintHeaders = 0, skipUnchangedSourceFiles = 0;
+    bool ok = ReadString(str, request.buildPath) &&
+        ReadStrings(str, [&request](std::string s) { request.sourcePaths.push_back(std::move(s)); }) &&
+        ReadStrings(str, [&request](std::string s) { request.rulesSelection.insert(std::move(s)); }) &&
+        ReadStrings(str, [&request](std::string s) { request.projectLocalIncludePaths.insert(std::move(s)); }) &&
+        ReadStrings(str, [&request](std::string s) { request.licenseTemplateLines.push_back(std::move(s)); }) &&
+        ReadString(str, request.generatorSelection) &&
+        ReadInt(str, shardIndex) &&
+        ReadInt(str, shardCount) &&
+        ReadInt(str, lintHeaders) &&
+        ReadInt(str, skipUnchangedSourceFiles) &&
+        ReadStrings(str, [&request](std::string s) { request.changedFiles.insert(std::move(s)); }) &&
+        ReadString(str, request.includeIndexFile);
+
+    if (!ok || shardCount < 1 || shardIndex < 0 || shardIndex >= shardCount)
+        return false;
+
+    request.shard.index = shardIndex;
+    request.shard.count = shardCount;
+    request.lintHeaders = (lintHeaders != 0);
+    request.skipUnchangedSourceFiles = (skipUnchangedSourceFiles != 0);
+    return true;
+}
+
+///////////////////////////
+
+// Sends everything printed by daemon back to the client; violations are already filtered and deduplicated
+// by OutputPrinter base class, so client just needs to print them
+class DaemonOutputPrinter : public OutputPrinter
+{
+public:
+    DaemonOutputPrinter(int socketFd, SourceLocationHelper& sourceLocationHelper);
+
+    void PrintGraphEdge(const std::string& source,
+                        const std::string& destination,
+                        const std::string& options = "") override;
+
+    void PrintTranslationUnitSummary(int sourceFileIndex,
+                                     const std::string& sourceFileName,
+                                     const TranslationUnitReport& report) override;
+
+protected:
+    void PrintRuleViolationImpl(StringRef ruleName,
+                                Severity severity,
+                                const std::string& description,
+                                StringRef fileName,
+                                int lineNumber) override;
+
+    void SaveImpl() override;
+
+private:
+    const int m_socketFd;
+};
+
+DaemonOutputPrinter::DaemonOutputPrinter(int socketFd, SourceLocationHelper& sourceLocationHelper)
+    : OutputPrinter("", {}, sourceLocationHelper),
+      m_socketFd(socketFd)
+{}
+
+void DaemonOutputPrinter::PrintRuleViolationImpl(StringRef ruleName,
+                                                 Severity severity,
+                                                 const std::string& description,
+                                                 StringRef fileName,
+                                                 int lineNumber)
+{
+    std::ostringstream str;
+    WriteString(str, "violation");
+    WriteString(str, ruleName.str());
+    WriteInt(str, static_cast<int>(severity));
+    WriteString(str, description);
+    WriteString(str, fileName.str());
+    WriteInt(str, lineNumber);
+    SendMessage(m_socketFd, str.str());
+}
+
+void DaemonOutputPrinter::PrintGraphEdge(const std::string& source,
+                                         const std::string& destination,
+                                         const std::string& options)
+{
+    std::ostringstream str;
+    WriteString(str, "edge");
+    WriteString(str, source);
+    WriteString(str, destination);
+    WriteString(str, options);
+    SendMessage(m_socketFd, str.str());
+}
+
+void DaemonOutputPrinter::PrintTranslationUnitSummary(int sourceFileIndex,
+                                                      const std::string& sourceFileName,
+                                                      const TranslationUnitReport& report)
+{
+    std::ostringstream str;
+    WriteString(str, "summary");
+    WriteInt(str, sourceFileIndex);
+    WriteString(str, sourceFileName);
+    SerializeTranslationUnitReport(report, str);
+    SendMessage(m_socketFd, str.str());
+}
+
+void DaemonOutputPrinter::SaveImpl()
+{
+}
+
+void SendError(int socketFd, const std::string& errorMessage)
+{
+    std::ostringstream str;
+    WriteString(str, "error");
+    WriteString(str, errorMessage);
+    SendMessage(socketFd, str.str());
+}
+
+void SendDone(int socketFd, int retCode)
+{
+    std::ostringstream str;
+    WriteString(str, "done");
+    WriteInt(str, retCode);
+    SendMessage(socketFd, str.str());
+}
+
+///////////////////////////
+
+class LintDaemon
+{
+public:
+    LintDaemon(const ParallelLintOptions& options, bool verbose, bool debug);
+
+    void HandleClient(int clientFd);
+
+private:
+    const CompilationDatabase* GetCompilationDatabase(const LintRequest& request, std::string& errorMessage);
+
+private:
+    ParallelLintOptions m_options;
+    const bool m_verbose;
+    const bool m_debug;
+    FileManagerCache m_fileManagerCache;
+
+    struct CachedCompilationDatabase
+    {
+        std::unique_ptr<CompilationDatabase> database;
+        std::int64_t modificationTimeNs = -1;
+    };
+    std::map<std::string, CachedCompilationDatabase> m_compilationDatabases;
+    std::unique_ptr<CompilationDatabase> m_uncachedCompilationDatabase;
+};
+
+LintDaemon::LintDaemon(const ParallelLintOptions& options, bool verbose, bool debug)
+    : m_options(options),
+      m_verbose(verbose),
+      m_debug(debug)
+{
+    m_options.fileManagerCache = &m_fileManagerCache;
+}
+
+void LintDaemon::HandleClient(int clientFd)
+{
+    std::string message;
+    LintRequest request;
+    if (!ReceiveMessage(clientFd, message) || !DeserializeLintRequest(message, request))
+    {
+        SendError(clientFd, "Invalid lint request");
+        SendDone(clientFd, 1);
+        return;
+    }
+
+    if (m_fileManagerCache.InvalidateIfFilesChanged() && m_verbose)
+    {
+        std::cerr << "Files changed on disk, dropping cached file system state" << std::endl;
+    }
+
+    std::string errorMessage;
+    const CompilationDatabase* compilations = GetCompilationDatabase(request, errorMessage);
+    if (compilations == nullptr)
+    {
+        SendError(clientFd, "Error while trying to load a compilation database:\n" + errorMessage);
+        SendDone(clientFd, 1);
+        return;
+    }
+
+    SourceLocationHelper sourceLocationHelper;
+    Context context(sourceLocationHelper,
+                    make_unique<DaemonOutputPrinter>(clientFd, sourceLocationHelper),
+                    std::move(request.projectLocalIncludePaths),
+                    std::move(request.licenseTemplateLines),
+                    std::move(request.rulesSelection),
+                    request.generatorSelection,
+                    m_verbose,
+                    m_debug);
+    sourceLocationHelper.SetContext(&context);
+
+    ParallelLintOptions options = m_options;
+    options.shard = request.shard;
+    options.lintHeaders = request.lintHeaders;
+    options.skipUnchangedSourceFiles = request.skipUnchangedSourceFiles;
+    options.changedFiles = std::move(request.changedFiles);
+    options.includeIndexFile = request.includeIndexFile;
+
+    int retCode = RunParallelLint(*compilations, request.sourcePaths, context, options);
+    context.outputPrinter->Save();
+
+    SendDone(clientFd, retCode);
+}
+
+const CompilationDatabase* LintDaemon::GetCompilationDatabase(const LintRequest& request, std::string& errorMessage)
+{
+    if (request.buildPath.empty())
+    {
+        // without build path, there is no single file to watch for changes
+        m_uncachedCompilationDatabase = LoadCompilationDatabase(request.buildPath, request.sourcePaths, errorMessage);
+        return m_uncachedCompilationDatabase.get();
+    }
+
+    SmallString<256> compileCommandsPath(request.buildPath);
+    sys::path::append(compileCommandsPath, "compile_commands.json");
+    std::int64_t modificationTimeNs = GetModificationTimeNs(compileCommandsPath.str());
+
+    auto& cachedDatabase = m_compilationDatabases[request.buildPath];
+    if (cachedDatabase.database == nullptr || cachedDatabase.modificationTimeNs != modificationTimeNs)
+    {
+        if (m_verbose)
+        {
+            std::cerr << "Loading compilation database from " << request.buildPath << std::endl;
+        }
+
+        cachedDatabase.database = LoadCompilationDatabase(request.buildPath, request.sourcePaths, errorMessage);
+        cachedDatabase.modificationTimeNs = modificationTimeNs;
+    }
+
+    return cachedDatabase.database.get();
+}
+
+} // anonymous namespace
+
+std::unique_ptr<CompilationDatabase> LoadCompilationDatabase(const std::string& buildPath,
+                                                             const std::vector<std::string>& sourcePaths,
+                                                             std::string& errorMessage)
+{
+    if (!buildPath.empty())
+        return CompilationDatabase::autoDetectFromDirectory(buildPath, errorMessage);
+
+    if (sourcePaths.empty())
+    {
+        errorMessage = "No source files given";
+        return nullptr;
+    }
+
+    return CompilationDatabase::autoDetectFromSource(sourcePaths.front(), errorMessage);
+}
+
+int RunLintDaemon(const std::string& socketPath,
+                  const ParallelLintOptions& options,
+                  bool verbose,
+                  bool debug)
+{
+    sockaddr_un address;
+    if (!InitSocketAddress(socketPath, address))
+        return 1;
+
+    int existingDaemonFd = ConnectToSocket(socketPath);
+    if (existingDaemonFd >= 0)
+    {
+        close(existingDaemonFd);
+        std::cerr << "Daemon is already running on socket \"" << socketPath << "\"" << std::endl;
+        return 1;
+    }
+
+    // socket left over from daemon that did not exit cleanly
+    unlink(socketPath.c_str());
+
+    int serverFd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    // anyone who can connect can make daemon read files, so socket is created with mode 0600 right away
+    mode_t oldUmask = umask(S_IXUSR | S_IRWXG | S_IRWXO);
+    bool bound = serverFd >= 0 && bind(serverFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+    umask(oldUmask);
+
+    if (!bound || listen(serverFd, 16) != 0)
+    {
+        std::cerr << "Could not listen on socket \"" << socketPath << "\": " << std::strerror(errno) << std::endl;
+        if (serverFd >= 0)
+            close(serverFd);
+        return 1;
+    }
+
+    // no SA_RESTART, so that accept() is interrupted and daemon can remove its socket before exiting
+    struct sigaction stopAction;
+    std::memset(&stopAction, 0, sizeof(stopAction));
+    stopAction.sa_handler = RequestDaemonStop;
+    sigaction(SIGINT, &stopAction, nullptr);
+    sigaction(SIGTERM, &stopAction, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (verbose)
+    {
+        std::cerr << "Listening on socket " << socketPath << std::endl;
+    }
+
+    LintDaemon daemon(options, verbose, debug);
+
+    while (!g_daemonStopRequested)
+    {
+        int clientFd = accept(serverFd, nullptr, nullptr);
+        if (clientFd < 0)
+            continue;
+
+        daemon.HandleClient(clientFd);
+        close(clientFd);
+    }
+
+    close(serverFd);
+    unlink(socketPath.c_str());
+    return 0;
+}
+
+boost::optional<int> RunLintClient(const std::string& socketPath,
+                                   const std::string& buildPath,
+                                   const std::vector<std::string>& sourcePaths,
+                                   const ParallelLintOptions& options,
+                                   Context& context)
+{
+    int socketFd = ConnectToSocket(socketPath);
+    if (socketFd < 0)
+        return boost::none;
+
+    // daemon has different working directory
+    LintRequest request;
+    request.buildPath = buildPath.empty() ? "" : GetAbsolutePath(buildPath);
+    for (const auto& sourcePath : sourcePaths)
+        request.sourcePaths.push_back(GetAbsolutePath(sourcePath));
+    request.rulesSelection = context.rulesSelection;
+    request.projectLocalIncludePaths = context.projectLocalIncludePaths;
+    request.licenseTemplateLines = context.licenseTemplateLines;
+    request.generatorSelection = context.generatorSelection;
+    request.shard = options.shard;
+    request.lintHeaders = options.lintHeaders;
+    request.skipUnchangedSourceFiles = options.skipUnchangedSourceFiles;
+    request.changedFiles = options.changedFiles; // already absolute
+    request.includeIndexFile = options.includeIndexFile.empty() ? "" : GetAbsolutePath(options.includeIndexFile);
+
+    int retCode = 1;
+    bool done = false;
+
+    std::string message;
+    if (SendMessage(socketFd, SerializeLintRequest(request)))
+    {
+        while (!done && ReceiveMessage(socketFd, message))
+        {
+            std::istringstream str(message);
+            std::string type;
+            if (!ReadString(str, type))
+                break;
+
+            if (type == "violation")
+            {
+                std::string ruleName, description, fileName;
+                int severity = 0, lineNumber = 0;
+                if (!ReadString(str, ruleName) || !ReadInt(str, severity) || !ReadString(str, description) ||
+                    !ReadString(str, fileName) || !ReadInt(str, lineNumber))
+                {
+                    break;
+                }
+
+                context.outputPrinter->PrintRuleViolation(ruleName,
+                                                          static_cast<Severity>(severity),
+                                                          description,
+                                                          fileName,
+                                                          lineNumber);
+            }
+            else if (type == "edge")
+            {
+                std::string source, destination, options;
+                if (!ReadString(str, source) || !ReadString(str, destination) || !ReadString(str, options))
+                    break;
+
+                context.outputPrinter->PrintGraphEdge(source, destination, options);
+            }
+            else if (type == "summary")
+            {
+                int sourceFileIndex = 0;
+                std::string sourceFileName;
+                TranslationUnitReport report;
+                if (!ReadInt(str, sourceFileIndex) || !ReadString(str, sourceFileName) ||
+                    !DeserializeTranslationUnitReport(str, report))
+                {
+                    break;
+                }
+
+                context.outputPrinter->PrintTranslationUnitSummary(sourceFileIndex, sourceFileName, report);
+            }
+            else if (type == "error")
+            {
+                std::string errorMessage;
+                if (!ReadString(str, errorMessage))
+                    break;
+
+                std::cerr << errorMessage << std::endl;
+            }
+            else if (type == "done")
+            {
+                done = ReadInt(str, retCode);
+            }
+        }
+    }
+
+    close(socketFd);
+
+    if (!done)
+    {
+        std::cerr << "Lost connection to daemon on socket \"" << socketPath << "\"" << std::endl;
+        return 1;
+    }
+
+    return retCode;
+}
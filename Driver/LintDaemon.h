@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Driver/ParallelLintRunner.h"
+
+#include <boost/optional.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Context;
+
+namespace clang
+{
+namespace tooling
+{
+class CompilationDatabase;
+} // namespace tooling
+} // namespace clang
+
+// Same as CommonOptionsParser: if build path is not given, compilation database is searched for
+// in parent directories of first source file
+std::unique_ptr<clang::tooling::CompilationDatabase> LoadCompilationDatabase(const std::string& buildPath,
+                                                                           const std::vector<std::string>& sourcePaths,
+                                                                           std::string& errorMessage);
+
+// Daemon mode: serves lint requests on Unix domain socket until terminated
+// Compilation databases and FileManagers are kept between requests and dropped when files change on disk.
+// Options that affect results (rules, license template, etc.) are taken from each request; the rest
+// (number of threads, result cache, etc.) are given here.
+int RunLintDaemon(const std::string& socketPath,
+                  const ParallelLintOptions& options,
+                  bool verbose,
+                  bool debug);
+
+// Client mode: sends lint request to daemon and prints violations sent back to output printer of given context
+// Returns none if daemon could not be reached, so that source files can be processed locally instead
+boost::optional<int> RunLintClient(const std::string& socketPath,
+                                   const std::string& buildPath,
+                                   const std::vector<std::string>& sourcePaths,
+                                   const ParallelLintOptions& options,
+                                   Context& context);
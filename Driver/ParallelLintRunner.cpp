@@ -0,0 +1,1294 @@
+#include "Driver/ParallelLintRunner.h"
+
+#include "ActionFactories.h"
+
+#include "Common/Context.h"
+#include "Common/RecordingOutputPrinter.h"
+#include "Common/RuleProfiler.h"
+#include "Common/SerializationHelper.h"
+#include "Common/SourceLocationHelper.h"
+#include "Common/Statistics.h"
+#include "Common/TraceRecorder.h"
+#include "Common/TranslationUnitReport.h"
+
+#include "Driver/FileManagerCache.h"
+#include "Driver/HeaderChecks.h"
+#include "Driver/IncludeIndex.h"
+#include "Driver/PreambleCache.h"
+#include "Driver/ResultCache.h"
+#include "Driver/SocketMessages.h"
+#include "Driver/TimingHistory.h"
+
+#include "Handlers/DiagnosticHandler.h"
+
+#include "Rules/UndefinedFunctionRule.h"
+
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Tooling/ArgumentsAdjusters.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Tooling.h>
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using namespace llvm;
+using namespace clang;
+using namespace clang::tooling;
+
+namespace
+{
+
+struct TranslationUnitJob
+{
+    int sourceFileIndex;
+    std::string sourcePath;
+    bool isHeaderCheck; // source path is header checked with synthesized source
+    std::vector<CompileCommand> compileCommands;
+    std::vector<std::string> preambleKeys; // for each compile command; empty if preambles are not reused
+};
+
+struct TranslationUnitResult
+{
+    TranslationUnitReport report;
+    TranslationUnitTiming timing;
+    bool fromCache = false;
+    bool skipped = false; // not affected by changed files
+    bool crashed = false; // worker process crashed while processing source file
+    std::set<std::string> inputFiles; // all files read while processing source file
+    RuleProfile ruleProfile; // empty if rules are not profiled
+    std::vector<TraceEvent> traceEvents; // empty if processing is not traced
+    Statistics statistics; // zero if statistics are not gathered
+    bool finished = false; // guarded by ResultQueue mutex
+};
+
+// Results are replayed in order of source files as soon as they are available,
+// so that output of long runs is streamed instead of being printed all at the end
+class ResultQueue
+{
+public:
+    explicit ResultQueue(std::size_t size);
+
+    TranslationUnitResult& GetResult(std::size_t index);
+    void SetFinished(std::size_t index);
+    bool IsFinished(std::size_t index);
+    const TranslationUnitResult& WaitForResult(std::size_t index);
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_resultFinished;
+    std::vector<TranslationUnitResult> m_results;
+};
+
+ResultQueue::ResultQueue(std::size_t size)
+    : m_results(size)
+{}
+
+TranslationUnitResult& ResultQueue::GetResult(std::size_t index)
+{
+    return m_results[index];
+}
+
+void ResultQueue::SetFinished(std::size_t index)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_results[index].finished = true;
+    }
+    m_resultFinished.notify_all();
+}
+
+bool ResultQueue::IsFinished(std::size_t index)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_results[index].finished;
+}
+
+const TranslationUnitResult& ResultQueue::WaitForResult(std::size_t index)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_resultFinished.wait(lock, [this, index]() { return m_results[index].finished; });
+    return m_results[index];
+}
+
+// Each worker has its own queue of jobs, initially filled so that estimated costs are balanced
+// between workers, with longest jobs first; worker that runs out of jobs steals the shortest remaining job
+// from the most loaded worker, so that workers finish at about the same time even if estimates are wrong
+class JobScheduler
+{
+public:
+    JobScheduler(const std::vector<double>& jobCosts, unsigned workerCount);
+
+    bool GetNextJob(unsigned workerIndex, std::size_t& jobIndex);
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> jobs;
+        double remainingCost = 0.0;
+    };
+
+    bool PopFront(WorkerQueue& queue, std::size_t& jobIndex);
+    bool PopBack(WorkerQueue& queue, std::size_t& jobIndex);
+
+private:
+    const std::vector<double>& m_jobCosts;
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+};
+
+JobScheduler::JobScheduler(const std::vector<double>& jobCosts, unsigned workerCount)
+    : m_jobCosts(jobCosts)
+{
+    for (unsigned i = 0; i < workerCount; ++i)
+        m_queues.push_back(make_unique<WorkerQueue>());
+
+    std::vector<std::size_t> sortedJobs(jobCosts.size());
+    std::iota(sortedJobs.begin(), sortedJobs.end(), 0);
+    std::stable_sort(sortedJobs.begin(), sortedJobs.end(),
+                     [&jobCosts](std::size_t left, std::size_t right) { return jobCosts[left] > jobCosts[right]; });
+
+    for (std::size_t jobIndex : sortedJobs)
+    {
+        auto leastLoadedQueue = std::min_element(m_queues.begin(), m_queues.end(),
+            [](const std::unique_ptr<WorkerQueue>& left, const std::unique_ptr<WorkerQueue>& right)
+            {
+                return left->remainingCost < right->remainingCost;
+            });
+
+        (*leastLoadedQueue)->jobs.push_back(jobIndex);
+        (*leastLoadedQueue)->remainingCost += jobCosts[jobIndex];
+    }
+}
+
+bool JobScheduler::GetNextJob(unsigned workerIndex, std::size_t& jobIndex)
+{
+    if (PopFront(*m_queues[workerIndex], jobIndex))
+        return true;
+
+    while (true)
+    {
+        WorkerQueue* victim = nullptr;
+        double victimRemainingCost = 0.0;
+        for (auto& queue : m_queues)
+        {
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            if (!queue->jobs.empty() && (victim == nullptr || queue->remainingCost > victimRemainingCost))
+            {
+                victim = queue.get();
+                victimRemainingCost = queue->remainingCost;
+            }
+        }
+
+        if (victim == nullptr)
+            return false;
+
+        if (PopBack(*victim, jobIndex))
+            return true;
+    }
+}
+
+bool JobScheduler::PopFront(WorkerQueue& queue, std::size_t& jobIndex)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+
+    jobIndex = queue.jobs.front();
+    queue.jobs.pop_front();
+    queue.remainingCost -= m_jobCosts[jobIndex];
+    return true;
+}
+
+bool JobScheduler::PopBack(WorkerQueue& queue, std::size_t& jobIndex)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+
+    jobIndex = queue.jobs.back();
+    queue.jobs.pop_back();
+    queue.remainingCost -= m_jobCosts[jobIndex];
+    return true;
+}
+
+// Only preprocesses source file to find all files included by it
+class IncludeScanAction : public PreprocessOnlyAction
+{
+public:
+    explicit IncludeScanAction(std::set<std::string>& inputFiles)
+        : m_inputFiles(inputFiles)
+    {}
+
+protected:
+    void EndSourceFileAction() override
+    {
+        CollectInputFiles(getCompilerInstance(), m_inputFiles);
+    }
+
+private:
+    std::set<std::string>& m_inputFiles;
+};
+
+class IncludeScanActionFactory : public FrontendActionFactory
+{
+public:
+    explicit IncludeScanActionFactory(std::set<std::string>& inputFiles)
+        : m_inputFiles(inputFiles)
+    {}
+
+    FrontendAction* create() override
+    {
+        return new IncludeScanAction(m_inputFiles);
+    }
+
+private:
+    std::set<std::string>& m_inputFiles;
+};
+
+class LintWorker
+{
+public:
+    LintWorker(unsigned workerIndex,
+               const Context& mainContext,
+               const std::string& mainExecutable,
+               FileManagerCache& fileManagerCache,
+               ResultCache* resultCache,
+               PreambleCache* preambleCache,
+               const std::set<std::string>* changedFiles,
+               const TranslationUnitLimits& translationUnitLimits);
+
+    void Run(JobScheduler& scheduler,
+             const std::vector<TranslationUnitJob>& jobs,
+             ResultQueue& results);
+
+    void ProcessJob(const TranslationUnitJob& job, TranslationUnitResult& result);
+
+private:
+    void LintJob(const TranslationUnitJob& job, TranslationUnitResult& result);
+    bool IsAffectedByChangedFiles(const TranslationUnitJob& job);
+    bool RunCompileCommand(const TranslationUnitJob& job, std::size_t compileCommandIndex);
+    CommandLineArguments GetCommandLine(const CompileCommand& compileCommand);
+
+private:
+    const unsigned m_workerIndex;
+    const std::set<std::string>* m_changedFiles; // null if all source files are processed
+    const std::string& m_mainExecutable;
+    FileManagerCache& m_fileManagerCache;
+    ResultCache* m_resultCache;
+    PreambleCache* m_preambleCache;
+    SourceLocationHelper m_sourceLocationHelper;
+    Context m_context;
+    RecordingOutputPrinter* m_outputPrinter;
+    DiagnosticHandler m_diagnosticHandler;
+};
+
+LintWorker::LintWorker(unsigned workerIndex,
+                       const Context& mainContext,
+                       const std::string& mainExecutable,
+                       FileManagerCache& fileManagerCache,
+                       ResultCache* resultCache,
+                       PreambleCache* preambleCache,
+                       const std::set<std::string>* changedFiles,
+                       const TranslationUnitLimits& translationUnitLimits)
+    : m_workerIndex(workerIndex),
+      m_changedFiles(changedFiles),
+      m_mainExecutable(mainExecutable),
+      m_fileManagerCache(fileManagerCache),
+      m_resultCache(resultCache),
+      m_preambleCache(preambleCache),
+      m_context(m_sourceLocationHelper,
+                make_unique<RecordingOutputPrinter>(m_sourceLocationHelper),
+                mainContext.projectLocalIncludePaths,
+                mainContext.licenseTemplateLines,
+                mainContext.rulesSelection,
+                mainContext.generatorSelection,
+                mainContext.verbose,
+                mainContext.debug),
+      m_outputPrinter(static_cast<RecordingOutputPrinter*>(m_context.outputPrinter.get())),
+      m_diagnosticHandler(m_context)
+{
+    m_sourceLocationHelper.SetContext(&m_context);
+    m_context.headerCheckSources = mainContext.headerCheckSources;
+    m_context.translationUnitLimits = translationUnitLimits;
+    if (mainContext.ruleProfiler != nullptr)
+        m_context.ruleProfiler = make_unique<RuleProfiler>();
+    if (mainContext.traceRecorder != nullptr)
+        m_context.traceRecorder = make_unique<TraceRecorder>(workerIndex + 1);
+    if (mainContext.statistics != nullptr)
+        m_context.statistics = make_unique<Statistics>();
+}
+
+void LintWorker::Run(JobScheduler& scheduler,
+                     const std::vector<TranslationUnitJob>& jobs,
+                     ResultQueue& results)
+{
+    std::size_t jobIndex = 0;
+    while (scheduler.GetNextJob(m_workerIndex, jobIndex))
+    {
+        ProcessJob(jobs[jobIndex], results.GetResult(jobIndex));
+        results.SetFinished(jobIndex);
+    }
+}
+
+void LintWorker::ProcessJob(const TranslationUnitJob& job, TranslationUnitResult& result)
+{
+    LintJob(job, result);
+
+    if (m_context.ruleProfiler != nullptr)
+        result.ruleProfile = m_context.ruleProfiler->TakeProfile();
+
+    if (m_context.traceRecorder != nullptr)
+        result.traceEvents = m_context.traceRecorder->TakeEvents();
+
+    if (m_context.statistics != nullptr)
+    {
+        result.statistics = std::move(*m_context.statistics);
+        *m_context.statistics = Statistics();
+    }
+}
+
+void LintWorker::LintJob(const TranslationUnitJob& job, TranslationUnitResult& result)
+{
+    TranslationUnitReport& report = result.report;
+    TraceRecorder* traceRecorder = m_context.traceRecorder.get();
+
+    std::string cacheKey;
+    std::int64_t cacheStartTimeNs = 0;
+    if (m_resultCache != nullptr)
+    {
+        TraceSpan span(traceRecorder, "result cache lookup", "phase", job.sourcePath);
+        cacheKey = m_resultCache->GetKey(job.sourcePath, job.compileCommands);
+        if (m_resultCache->Load(cacheKey, report))
+        {
+            if (m_context.verbose)
+            {
+                std::cerr << "Using cached results for " << job.sourcePath << std::endl;
+            }
+            result.fromCache = true;
+            return;
+        }
+        cacheStartTimeNs = ResultCache::GetCurrentTimeNs();
+    }
+
+    bool affectedByChangedFiles = true;
+    if (m_changedFiles != nullptr)
+    {
+        TraceSpan span(traceRecorder, "include scan", "phase", job.sourcePath);
+        affectedByChangedFiles = IsAffectedByChangedFiles(job);
+    }
+
+    if (!affectedByChangedFiles)
+    {
+        if (m_context.verbose)
+        {
+            std::cerr << "Skipping " << job.sourcePath << " [not affected by changes]" << std::endl;
+        }
+        result.skipped = true;
+        return;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // cross-TU state is gathered separately for each source file and merged when replaying reports
+    m_context.processedFiles.clear();
+    m_context.definedFunctions.clear();
+    m_context.undefinedFunctions.clear();
+    m_context.translationUnitMemoryUsage = 0;
+    m_context.translationUnitInputFiles.clear();
+    m_context.translationUnitAborted = false;
+
+    m_outputPrinter->SetReport(&report);
+
+    for (std::size_t i = 0; i < job.compileCommands.size(); ++i)
+    {
+        if (! RunCompileCommand(job, i))
+            report.failed = true;
+    }
+
+    m_outputPrinter->SetReport(nullptr);
+
+    report.definedFunctions = std::move(m_context.definedFunctions);
+    report.undefinedFunctions = std::move(m_context.undefinedFunctions);
+
+    result.timing.wallTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    result.timing.peakMemoryKb = m_context.translationUnitMemoryUsage / 1024;
+
+    m_fileManagerCache.RecordInputFiles(m_context.translationUnitInputFiles);
+
+    // aborted processing depends on machine load, so it must be tried again next time
+    if (m_resultCache != nullptr && !report.failed && !m_context.translationUnitAborted)
+        m_resultCache->Store(cacheKey, m_context.translationUnitInputFiles, report, cacheStartTimeNs);
+
+    for (const auto& inputFile : m_context.translationUnitInputFiles)
+        result.inputFiles.insert(m_sourceLocationHelper.CleanRawFilename(inputFile));
+}
+
+bool LintWorker::IsAffectedByChangedFiles(const TranslationUnitJob& job)
+{
+    if (m_changedFiles->count(m_sourceLocationHelper.CleanRawFilename(job.sourcePath)) > 0)
+        return true;
+
+    // only preprocessing is needed to find all included files, which is much cheaper than parsing
+    for (const auto& compileCommand : job.compileCommands)
+    {
+        std::set<std::string> inputFiles;
+        IncludeScanActionFactory factory(inputFiles);
+
+        ToolInvocation invocation(GetCommandLine(compileCommand),
+                                  &factory,
+                                  m_fileManagerCache.GetFileManager(m_workerIndex, compileCommand.Directory));
+        IgnoringDiagConsumer diagnosticConsumer;
+        invocation.setDiagnosticConsumer(&diagnosticConsumer);
+
+        if (job.isHeaderCheck)
+            invocation.mapVirtualFile(GetHeaderCheckSourcePath(job.sourcePath), GetHeaderCheckSourceContent(job.sourcePath));
+
+        // let the actual processing report what went wrong
+        if (! invocation.run())
+            return true;
+
+        for (const auto& inputFile : inputFiles)
+        {
+            if (m_changedFiles->count(m_sourceLocationHelper.CleanRawFilename(inputFile)) > 0)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+CommandLineArguments LintWorker::GetCommandLine(const CompileCommand& compileCommand)
+{
+    // ClangTool::run() does chdir() into compile command directory, which is not something
+    // we can do from many threads at once, so working directory is passed to Clang instead
+    CommandLineArguments commandLine = compileCommand.CommandLine;
+    commandLine = getClangStripOutputAdjuster()(commandLine);
+    commandLine = getClangSyntaxOnlyAdjuster()(commandLine);
+    commandLine[0] = m_mainExecutable;
+    commandLine.insert(commandLine.begin() + 1, {"-working-directory", compileCommand.Directory});
+    return commandLine;
+}
+
+bool LintWorker::RunCompileCommand(const TranslationUnitJob& job, std::size_t compileCommandIndex)
+{
+    const CompileCommand& compileCommand = job.compileCommands[compileCommandIndex];
+    std::string preambleKey = job.preambleKeys.empty() ? "" : job.preambleKeys[compileCommandIndex];
+
+    FileManager* fileManager = m_fileManagerCache.GetFileManager(m_workerIndex, compileCommand.Directory);
+
+    const Preamble* preamble = nullptr;
+    if (m_preambleCache != nullptr)
+        preamble = m_preambleCache->GetPreamble(preambleKey, fileManager, m_mainExecutable, m_sourceLocationHelper);
+
+    CommandLineArguments commandLine = GetCommandLine(compileCommand);
+    if (preamble != nullptr)
+        commandLine.insert(commandLine.begin() + 1, {"-include-pch", preamble->precompiledPath});
+
+    ColobotLintASTFrontendActionFactory factory(m_context);
+
+    ToolInvocation invocation(std::move(commandLine), &factory, fileManager);
+    invocation.setDiagnosticConsumer(&m_diagnosticHandler);
+
+    std::string headerCheckSourcePath;
+    if (job.isHeaderCheck)
+    {
+        headerCheckSourcePath = GetHeaderCheckSourcePath(job.sourcePath);
+        invocation.mapVirtualFile(headerCheckSourcePath, GetHeaderCheckSourceContent(job.sourcePath));
+    }
+
+    if (preamble != nullptr)
+    {
+        invocation.mapVirtualFile(preamble->virtualPath, preamble->content);
+
+        // headers in preamble are not parsed again, so their warnings have to be reported here
+        for (const auto& diagnostic : preamble->diagnostics)
+        {
+            m_diagnosticHandler.HandleRecordedDiagnostic(diagnostic.level,
+                                                         diagnostic.message,
+                                                         diagnostic.fileName,
+                                                         diagnostic.lineNumber);
+        }
+    }
+
+    bool result = invocation.run();
+
+    // synthesized files do not exist on disk
+    if (job.isHeaderCheck)
+        m_context.translationUnitInputFiles.erase(headerCheckSourcePath);
+
+    if (preamble != nullptr)
+    {
+        m_context.translationUnitInputFiles.insert(preamble->inputFiles.begin(), preamble->inputFiles.end());
+        m_context.translationUnitInputFiles.erase(preamble->virtualPath);
+        m_context.translationUnitInputFiles.erase(preamble->precompiledPath);
+    }
+
+    return result;
+}
+
+template<typename Entry>
+auto GetRuleProfileCounters(Entry& entry) -> std::array<decltype(&entry.matchCallbacks), 4>
+{
+    return {{&entry.matchCallbacks, &entry.translationUnitCallbacks, &entry.preprocessorCallbacks, &entry.locationChecks}};
+}
+
+std::string SerializeTranslationUnitResult(const TranslationUnitResult& result)
+{
+    std::ostringstream str;
+    SerializeTranslationUnitReport(result.report, str);
+    WriteString(str, std::to_string(result.timing.wallTimeMs));
+    WriteCount(str, result.timing.peakMemoryKb);
+    WriteInt(str, result.fromCache ? 1 : 0);
+    WriteInt(str, result.skipped ? 1 : 0);
+    WriteStrings(str, result.inputFiles);
+
+    WriteCount(str, result.ruleProfile.size());
+    for (const auto& entry : result.ruleProfile)
+    {
+        WriteString(str, entry.first);
+        for (const RuleProfileCounter* counter : GetRuleProfileCounters(entry.second))
+        {
+            WriteCount(str, counter->calls);
+            WriteCount(str, counter->timeNs);
+        }
+    }
+
+    WriteCount(str, result.traceEvents.size());
+    for (const auto& event : result.traceEvents)
+    {
+        WriteString(str, event.name);
+        WriteString(str, event.category);
+        WriteString(str, event.fileName);
+        WriteCount(str, event.startTimeUs);
+        WriteCount(str, event.durationUs);
+        WriteCount(str, event.trackId);
+    }
+
+    for (const std::uint64_t* counter : GetStatisticsCounters(result.statistics))
+        WriteCount(str, *counter);
+
+    WriteCount(str, result.statistics.rules.size());
+    for (const auto& rule : result.statistics.rules)
+    {
+        WriteString(str, rule.first);
+        WriteCount(str, rule.second.matchCallbacks);
+        WriteCount(str, rule.second.regexEvaluations);
+    }
+
+    return str.str();
+}
+
+bool DeserializeTranslationUnitResult(const std::string& message, TranslationUnitResult& result)
+{
+    std::istringstream str(message);
+
+    std::string wallTimeMs;
+    int fromCache = 0, skipped = 0;
+    bool ok = DeserializeTranslationUnitReport(str, result.report) &&
+        ReadString(str, wallTimeMs) &&
+        ReadCount(str, result.timing.peakMemoryKb) &&
+        ReadInt(str, fromCache) &&
+        ReadInt(str, skipped) &&
+        ReadStrings(str, [&result](std::string s) { result.inputFiles.insert(std::move(s)); });
+
+    std::size_t ruleCount = 0;
+    if (!ok || !ReadElementCount(str, ruleCount))
+        return false;
+
+    for (std::size_t i = 0; i < ruleCount; ++i)
+    {
+        std::string ruleName;
+        if (!ReadString(str, ruleName))
+            return false;
+
+        RuleProfileEntry& entry = result.ruleProfile[ruleName];
+        for (RuleProfileCounter* counter : GetRuleProfileCounters(entry))
+        {
+            std::size_t calls = 0, timeNs = 0;
+            if (!ReadCount(str, calls) || !ReadCount(str, timeNs))
+                return false;
+            counter->calls = calls;
+            counter->timeNs = timeNs;
+        }
+    }
+
+    std::size_t traceEventCount = 0;
+    if (!ReadElementCount(str, traceEventCount))
+        return false;
+
+    result.traceEvents.resize(traceEventCount);
+    for (auto& event : result.traceEvents)
+    {
+        std::size_t startTimeUs = 0, durationUs = 0, trackId = 0;
+        if (!ReadString(str, event.name) ||
+            !ReadString(str, event.category) ||
+            !ReadString(str, event.fileName) ||
+            !ReadCount(str, startTimeUs) ||
+            !ReadCount(str, durationUs) ||
+            !ReadCount(str, trackId))
+        {
+            return false;
+        }
+        event.startTimeUs = startTimeUs;
+        event.durationUs = durationUs;
+        event.trackId = trackId;
+    }
+
+    for (std::uint64_t* counter : GetStatisticsCounters(result.statistics))
+    {
+        std::size_t value = 0;
+        if (!ReadCount(str, value))
+            return false;
+        *counter = value;
+    }
+
+    std::size_t statisticsRuleCount = 0;
+    if (!ReadElementCount(str, statisticsRuleCount))
+        return false;
+
+    for (std::size_t i = 0; i < statisticsRuleCount; ++i)
+    {
+        std::string ruleName;
+        std::size_t matchCallbacks = 0, regexEvaluations = 0;
+        if (!ReadString(str, ruleName) || !ReadCount(str, matchCallbacks) || !ReadCount(str, regexEvaluations))
+            return false;
+
+        RuleStatistics& rule = result.statistics.rules[ruleName];
+        rule.matchCallbacks = matchCallbacks;
+        rule.regexEvaluations = regexEvaluations;
+    }
+
+    result.timing.wallTimeMs = std::strtod(wallTimeMs.c_str(), nullptr);
+    result.fromCache = (fromCache != 0);
+    result.skipped = (skipped != 0);
+    return true;
+}
+
+std::string GetTerminationDescription(int status)
+{
+    if (WIFSIGNALED(status))
+        return "killed by signal " + std::to_string(WTERMSIG(status));
+
+    if (WIFEXITED(status))
+        return "exited with code " + std::to_string(WEXITSTATUS(status));
+
+    return "terminated";
+}
+
+// Instead of threads, source files are processed by worker processes forked from this (supervisor) process,
+// so that a crash of Clang on one source file costs only the result of that source file
+// Each worker gets job indexes and sends back serialized results over its own socket pair;
+// crashed workers are replaced by new ones and the source file is reported as lint crash
+class WorkerProcessPool
+{
+public:
+    using WorkerFactory = std::function<std::unique_ptr<LintWorker>(unsigned workerIndex)>;
+
+    WorkerProcessPool(unsigned workerCount, WorkerFactory workerFactory, Context& mainContext);
+    ~WorkerProcessPool();
+
+    // calls resultFinished after each result, so that results can be replayed as soon as possible
+    void Run(JobScheduler& scheduler,
+             const std::vector<TranslationUnitJob>& jobs,
+             ResultQueue& results,
+             const std::function<void()>& resultFinished);
+
+private:
+    struct WorkerProcess
+    {
+        pid_t pid = -1;
+        int socketFd = -1;
+        bool busy = false;
+        std::size_t jobIndex = 0;
+    };
+
+    bool StartWorkerProcess(unsigned workerIndex, const std::vector<TranslationUnitJob>& jobs);
+    int StopWorkerProcess(unsigned workerIndex);
+    bool SendNextJob(unsigned workerIndex, JobScheduler& scheduler);
+    void SetCrashedResult(const TranslationUnitJob& job, const std::string& reason, TranslationUnitResult& result);
+
+    static void RunWorkerProcess(LintWorker& worker, int socketFd, const std::vector<TranslationUnitJob>& jobs);
+
+private:
+    WorkerFactory m_workerFactory;
+    Context& m_mainContext;
+    std::vector<WorkerProcess> m_processes;
+};
+
+WorkerProcessPool::WorkerProcessPool(unsigned workerCount, WorkerFactory workerFactory, Context& mainContext)
+    : m_workerFactory(std::move(workerFactory)),
+      m_mainContext(mainContext),
+      m_processes(workerCount)
+{}
+
+WorkerProcessPool::~WorkerProcessPool()
+{
+    for (unsigned i = 0; i < m_processes.size(); ++i)
+        StopWorkerProcess(i);
+}
+
+void WorkerProcessPool::Run(JobScheduler& scheduler,
+                            const std::vector<TranslationUnitJob>& jobs,
+                            ResultQueue& results,
+                            const std::function<void()>& resultFinished)
+{
+    for (unsigned i = 0; i < m_processes.size(); ++i)
+    {
+        if (StartWorkerProcess(i, jobs))
+            SendNextJob(i, scheduler);
+    }
+
+    while (true)
+    {
+        std::vector<pollfd> pollFds;
+        std::vector<unsigned> pollWorkers;
+        for (unsigned i = 0; i < m_processes.size(); ++i)
+        {
+            if (m_processes[i].busy)
+            {
+                pollFds.push_back(pollfd{m_processes[i].socketFd, POLLIN, 0});
+                pollWorkers.push_back(i);
+            }
+        }
+
+        if (pollFds.empty())
+            break;
+
+        if (poll(pollFds.data(), pollFds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            std::cerr << "Error while waiting for worker processes: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        for (std::size_t p = 0; p < pollFds.size(); ++p)
+        {
+            if (pollFds[p].revents == 0)
+                continue;
+
+            unsigned workerIndex = pollWorkers[p];
+            WorkerProcess& process = m_processes[workerIndex];
+            std::size_t jobIndex = process.jobIndex;
+            const TranslationUnitJob& job = jobs[jobIndex];
+            TranslationUnitResult& result = results.GetResult(jobIndex);
+
+            std::string message;
+            bool received = ReceiveMessage(process.socketFd, message) &&
+                            DeserializeTranslationUnitResult(message, result);
+            process.busy = false;
+
+            if (!received)
+            {
+                int status = StopWorkerProcess(workerIndex);
+                SetCrashedResult(job, GetTerminationDescription(status), result);
+                if (m_mainContext.verbose)
+                {
+                    std::cerr << "Worker process crashed while processing " << job.sourcePath
+                              << ", starting new one" << std::endl;
+                }
+            }
+
+            results.SetFinished(jobIndex);
+            resultFinished();
+
+            if (process.pid > 0 || StartWorkerProcess(workerIndex, jobs))
+                SendNextJob(workerIndex, scheduler);
+        }
+    }
+
+    // if worker processes could not be started at all, remaining source files must still get results
+    std::size_t jobIndex = 0;
+    while (scheduler.GetNextJob(0, jobIndex))
+    {
+        SetCrashedResult(jobs[jobIndex], "could not be started", results.GetResult(jobIndex));
+        results.SetFinished(jobIndex);
+        resultFinished();
+    }
+}
+
+bool WorkerProcessPool::StartWorkerProcess(unsigned workerIndex, const std::vector<TranslationUnitJob>& jobs)
+{
+    int socketFds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, socketFds) != 0)
+    {
+        std::cerr << "Could not create socket for worker process: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // buffered output would be printed twice otherwise
+    std::cout.flush();
+    std::cerr.flush();
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        std::cerr << "Could not start worker process: " << std::strerror(errno) << std::endl;
+        close(socketFds[0]);
+        close(socketFds[1]);
+        return false;
+    }
+
+    if (pid == 0)
+    {
+        close(socketFds[0]);
+        for (const auto& process : m_processes)
+        {
+            if (process.socketFd >= 0)
+                close(process.socketFd);
+        }
+
+        std::unique_ptr<LintWorker> worker = m_workerFactory(workerIndex);
+        RunWorkerProcess(*worker, socketFds[1], jobs);
+
+        // skip destructors and exit handlers of state shared with supervisor, such as output printer
+        std::cout.flush();
+        std::cerr.flush();
+        _exit(0);
+    }
+
+    close(socketFds[1]);
+    m_processes[workerIndex].pid = pid;
+    m_processes[workerIndex].socketFd = socketFds[0];
+    return true;
+}
+
+int WorkerProcessPool::StopWorkerProcess(unsigned workerIndex)
+{
+    WorkerProcess& process = m_processes[workerIndex];
+    if (process.pid <= 0)
+        return 0;
+
+    // closed socket makes worker exit after its current job
+    close(process.socketFd);
+
+    int status = 0;
+    while (waitpid(process.pid, &status, 0) < 0 && errno == EINTR)
+    {}
+
+    process = WorkerProcess();
+    return status;
+}
+
+bool WorkerProcessPool::SendNextJob(unsigned workerIndex, JobScheduler& scheduler)
+{
+    WorkerProcess& process = m_processes[workerIndex];
+
+    std::size_t jobIndex = 0;
+    if (!scheduler.GetNextJob(workerIndex, jobIndex))
+    {
+        StopWorkerProcess(workerIndex);
+        return false;
+    }
+
+    process.jobIndex = jobIndex;
+    process.busy = true;
+
+    // if worker died in the meantime, it is noticed as crash when waiting for result
+    SendMessage(process.socketFd, std::to_string(jobIndex));
+    return true;
+}
+
+void WorkerProcessPool::SetCrashedResult(const TranslationUnitJob& job,
+                                         const std::string& reason,
+                                         TranslationUnitResult& result)
+{
+    result = TranslationUnitResult();
+    result.crashed = true;
+    result.report.failed = true;
+    result.report.violations.push_back(ReportedViolation{
+        "lint crash",
+        Severity::Error,
+        "Processing of source file failed: worker process " + reason,
+        m_mainContext.sourceLocationHelper.CleanRawFilename(job.sourcePath),
+        1,
+        ""});
+}
+
+void WorkerProcessPool::RunWorkerProcess(LintWorker& worker, int socketFd, const std::vector<TranslationUnitJob>& jobs)
+{
+    // test-only hook, so that handling of crashed workers can be tested without a source file crashing Clang
+    const char* crashOnSourceFile = std::getenv("COLOBOT_LINT_TEST_CRASH_WORKER_ON");
+
+    std::string message;
+    while (ReceiveMessage(socketFd, message))
+    {
+        std::size_t jobIndex = std::strtoul(message.c_str(), nullptr, 10);
+        if (jobIndex >= jobs.size())
+            break;
+
+        if (crashOnSourceFile != nullptr && StringRef(jobs[jobIndex].sourcePath).endswith(crashOnSourceFile))
+            raise(SIGKILL);
+
+        TranslationUnitResult result;
+        worker.ProcessJob(jobs[jobIndex], result);
+
+        if (!SendMessage(socketFd, SerializeTranslationUnitResult(result)))
+            break;
+    }
+}
+
+// Source files without history are assumed to take average time of known ones,
+// so without any history the order is the same as order of source files
+std::vector<double> GetEstimatedJobCosts(const std::vector<TranslationUnitJob>& jobs, const TimingHistory& timingHistory)
+{
+    std::vector<double> jobCosts;
+    double knownCostSum = 0.0;
+    int knownCostCount = 0;
+    for (const auto& job : jobs)
+    {
+        double cost = timingHistory.GetEstimatedCost(job.sourcePath);
+        if (cost >= 0.0)
+        {
+            knownCostSum += cost;
+            ++knownCostCount;
+        }
+        jobCosts.push_back(cost);
+    }
+
+    double defaultCost = (knownCostCount > 0) ? (knownCostSum / knownCostCount) : 1.0;
+    for (auto& cost : jobCosts)
+    {
+        if (cost < 0.0)
+            cost = defaultCost;
+    }
+
+    return jobCosts;
+}
+
+std::string GetMainExecutable()
+{
+    // exists solely for the purpose of lookup of the resource path, same as in ClangTool
+    static int staticSymbol;
+    return sys::fs::getMainExecutable("colobot-lint", &staticSymbol);
+}
+
+#ifdef __linux__
+
+int ReadCgroupCpuQuota()
+{
+    // cgroup v2
+    {
+        std::ifstream str("/sys/fs/cgroup/cpu.max");
+        std::string quotaStr;
+        long long period = 0;
+        if (str >> quotaStr >> period)
+        {
+            long long quota = std::strtoll(quotaStr.c_str(), nullptr, 10); // "max" gives 0
+            if (quota <= 0 || period <= 0)
+                return 0;
+
+            return static_cast<int>((quota + period - 1) / period);
+        }
+    }
+
+    // cgroup v1
+    {
+        std::ifstream quotaStr("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+        std::ifstream periodStr("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+        long long quota = 0, period = 0;
+        if ((quotaStr >> quota) && (periodStr >> period))
+        {
+            if (quota <= 0 || period <= 0)
+                return 0;
+
+            return static_cast<int>((quota + period - 1) / period);
+        }
+    }
+
+    return 0;
+}
+
+#endif
+
+} // anonymous namespace
+
+unsigned GetAvailableCpuCount()
+{
+    int cpuCount = std::thread::hardware_concurrency();
+
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0)
+        cpuCount = CPU_COUNT(&cpuSet);
+
+    int cpuQuota = ReadCgroupCpuQuota();
+    if (cpuQuota > 0)
+        cpuCount = std::min(cpuCount, cpuQuota);
+#endif
+
+    return std::max(cpuCount, 1);
+}
+
+int RunParallelLint(const CompilationDatabase& compilations,
+                    const std::vector<std::string>& sourcePaths,
+                    Context& context,
+                    const ParallelLintOptions& options)
+{
+    const ShardSelection& shard = options.shard;
+
+    std::unique_ptr<HeaderCheckCompileCommands> headerCheckCompileCommands;
+    if (options.lintHeaders)
+        headerCheckCompileCommands = make_unique<HeaderCheckCompileCommands>(compilations);
+
+    IncludeIndex includeIndex;
+    if (!options.includeIndexFile.empty())
+        includeIndex.Load(options.includeIndexFile);
+
+    std::set<std::string> affectedSourceFiles;
+    if (options.skipUnchangedSourceFiles)
+        affectedSourceFiles = includeIndex.GetAffectedSourceFiles(options.changedFiles);
+
+    std::vector<TranslationUnitJob> jobs;
+    std::unordered_set<std::string> seenFiles;
+    int sourceFileIndex = -1;
+    for (const auto& sourcePath : sourcePaths)
+    {
+        std::string file = getAbsolutePath(sourcePath);
+
+        // path of header is matched against file names given by Clang, so it must be normalized
+        bool isHeaderCheck = options.lintHeaders && IsHeaderFile(file);
+        if (isHeaderCheck)
+            file = context.sourceLocationHelper.CleanRawFilename(file);
+
+        if (seenFiles.count(file) > 0)
+        {
+            if (context.verbose)
+            {
+                std::cerr << "Skipping " << file << " [already processed]" << std::endl;
+            }
+            if (context.statistics != nullptr)
+                context.statistics->translationUnitsSkipped++;
+            continue;
+        }
+        seenFiles.insert(file);
+
+        ++sourceFileIndex;
+        if (sourceFileIndex % shard.count != shard.index)
+            continue;
+
+        // source files unknown to include index are checked by worker
+        if (options.skipUnchangedSourceFiles)
+        {
+            std::string cleanFile = context.sourceLocationHelper.CleanRawFilename(file);
+            if (includeIndex.IsSourceFileKnown(cleanFile) && affectedSourceFiles.count(cleanFile) == 0)
+            {
+                if (context.verbose)
+                {
+                    std::cerr << "Skipping " << file << " [not affected by changes]" << std::endl;
+                }
+                continue;
+            }
+        }
+
+        std::uint64_t lookupStartTimeUs = TraceRecorder::GetCurrentTimeUs();
+        std::vector<CompileCommand> compileCommands = isHeaderCheck
+            ? headerCheckCompileCommands->GetCompileCommands(file)
+            : compilations.getCompileCommands(file);
+        if (context.traceRecorder != nullptr)
+        {
+            context.traceRecorder->AddSpan("compile command lookup", "phase",
+                                           lookupStartTimeUs, TraceRecorder::GetCurrentTimeUs(), file);
+        }
+        if (compileCommands.empty())
+        {
+            errs() << "Skipping " << file << ". Compile command not found.\n";
+            continue;
+        }
+
+        if (isHeaderCheck)
+            context.headerCheckSources[GetHeaderCheckSourcePath(file)] = file;
+
+        jobs.push_back(TranslationUnitJob{sourceFileIndex, file, isHeaderCheck, std::move(compileCommands), {}});
+    }
+
+    TimingHistory timingHistory;
+    if (!options.timingHistoryFile.empty())
+        timingHistory.Load(options.timingHistoryFile);
+
+    std::vector<double> jobCosts = GetEstimatedJobCosts(jobs, timingHistory);
+
+    std::unique_ptr<ResultCache> resultCache;
+    if (!options.cacheDirectory.empty())
+        resultCache = make_unique<ResultCache>(options.cacheDirectory, options.cacheMaxSize, context);
+
+    std::unique_ptr<PreambleCache> preambleCache;
+    if (options.reusePreambles)
+    {
+        preambleCache = make_unique<PreambleCache>();
+
+        std::vector<PreambleSource> preambleSources;
+        for (const auto& job : jobs)
+        {
+            for (const auto& compileCommand : job.compileCommands)
+            {
+                if (job.isHeaderCheck)
+                    preambleSources.push_back(PreambleSource{GetHeaderCheckSourcePath(job.sourcePath), job.sourcePath, &compileCommand});
+                else
+                    preambleSources.push_back(PreambleSource{job.sourcePath, "", &compileCommand});
+            }
+        }
+
+        std::vector<std::string> preambleKeys = preambleCache->AssignPreambles(preambleSources);
+
+        auto preambleKeyIt = preambleKeys.begin();
+        for (auto& job : jobs)
+        {
+            job.preambleKeys.assign(preambleKeyIt, preambleKeyIt + job.compileCommands.size());
+            preambleKeyIt += job.compileCommands.size();
+        }
+    }
+
+    FileManagerCache localFileManagerCache;
+    FileManagerCache& fileManagerCache = (options.fileManagerCache != nullptr)
+        ? *options.fileManagerCache
+        : localFileManagerCache;
+
+    ResultQueue results(jobs.size());
+    std::string mainExecutable = GetMainExecutable();
+
+    unsigned jobCount = std::max(1u, std::min<unsigned>(options.jobCount, jobs.size()));
+
+    JobScheduler scheduler(jobCosts, jobCount);
+
+    auto createWorker = [&](unsigned workerIndex)
+    {
+        return make_unique<LintWorker>(workerIndex, context, mainExecutable, fileManagerCache,
+                                       resultCache.get(), preambleCache.get(),
+                                       options.skipUnchangedSourceFiles ? &options.changedFiles : nullptr,
+                                       options.translationUnitLimits);
+    };
+
+    bool processingFailed = false;
+    std::size_t replayedCount = 0;
+    auto replayResult = [&](std::size_t index)
+    {
+        const TranslationUnitResult& result = results.WaitForResult(index);
+        ReplayTranslationUnitReport(result.report, context);
+        processingFailed = processingFailed || result.report.failed;
+        if (context.ruleProfiler != nullptr)
+            context.ruleProfiler->Merge(result.ruleProfile);
+        if (context.traceRecorder != nullptr)
+            context.traceRecorder->AddEvents(result.traceEvents);
+        if (context.statistics != nullptr)
+            context.statistics->Add(result.statistics);
+    };
+
+    if (options.useWorkerProcesses)
+    {
+        WorkerProcessPool pool(jobCount, createWorker, context);
+        pool.Run(scheduler, jobs, results, [&]()
+        {
+            while (replayedCount < jobs.size() && results.IsFinished(replayedCount))
+                replayResult(replayedCount++);
+        });
+    }
+    else
+    {
+        std::vector<std::unique_ptr<LintWorker>> workers;
+        for (unsigned i = 0; i < jobCount; ++i)
+            workers.push_back(createWorker(i));
+
+        std::vector<std::thread> threads;
+        for (auto& worker : workers)
+        {
+            LintWorker* workerPtr = worker.get();
+            threads.emplace_back([workerPtr, &scheduler, &jobs, &results]()
+            {
+                workerPtr->Run(scheduler, jobs, results);
+            });
+        }
+
+        while (replayedCount < jobs.size())
+            replayResult(replayedCount++);
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+
+    if (!options.timingHistoryFile.empty())
+    {
+        // cached, skipped and crashed results say nothing about the cost of actual processing
+        for (std::size_t i = 0; i < jobs.size(); ++i)
+        {
+            const TranslationUnitResult& result = results.GetResult(i);
+            if (!result.fromCache && !result.skipped && !result.crashed)
+                timingHistory.Record(jobs[i].sourcePath, result.timing);
+        }
+
+        timingHistory.Save(options.timingHistoryFile);
+    }
+
+    if (!options.includeIndexFile.empty())
+    {
+        std::map<std::string, std::set<std::string>> inputFilesBySourceFile;
+        for (std::size_t i = 0; i < jobs.size(); ++i)
+        {
+            TranslationUnitResult& result = results.GetResult(i);
+            if (!result.fromCache && !result.skipped && !result.crashed)
+            {
+                std::string cleanFile = context.sourceLocationHelper.CleanRawFilename(jobs[i].sourcePath);
+                inputFilesBySourceFile[cleanFile] = std::move(result.inputFiles);
+            }
+        }
+
+        includeIndex.Update(inputFilesBySourceFile);
+        includeIndex.Save(options.includeIndexFile);
+    }
+
+    if (resultCache != nullptr)
+        resultCache->RemoveLeastRecentlyUsedEntries();
+
+    if (preambleCache != nullptr)
+        preambleCache->PrintStatistics(std::cerr);
+
+    if (shard.count > 1)
+    {
+        for (std::size_t i = 0; i < jobs.size(); ++i)
+        {
+            const TranslationUnitReport& report = results.GetResult(i).report;
+            if (report.definedFunctions.empty() && report.undefinedFunctions.empty())
+                continue;
+
+            context.outputPrinter->PrintTranslationUnitSummary(jobs[i].sourceFileIndex, jobs[i].sourcePath, report);
+        }
+    }
+    else if (!options.skipUnchangedSourceFiles)
+    {
+        // functions may be defined in skipped source files, so this is known only when all are processed
+        UndefinedFunctionRule::PrintUndefinedFunctions(context);
+    }
+
+    return processingFailed ? 1 : 0;
+}
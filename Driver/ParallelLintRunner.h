@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Common/TranslationUnitLimits.h"
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+struct Context;
+class FileManagerCache;
+
+namespace clang
+{
+namespace tooling
+{
+class CompilationDatabase;
+} // namespace tooling
+} // namespace clang
+
+// Selects which part of source files is processed in sharded run
+struct ShardSelection
+{
+    unsigned index = 0; // zero-based
+    unsigned count = 1;
+};
+
+struct ParallelLintOptions
+{
+    unsigned jobCount = 1;
+    ShardSelection shard;
+    // if given, per-TU timings are read from this file to schedule longest source files first,
+    // and updated with timings of this run
+    std::string timingHistoryFile;
+    // if given, results of source files are cached in this directory and reused when none of files
+    // read while processing source file have changed
+    std::string cacheDirectory;
+    std::uint64_t cacheMaxSize = 0; // in bytes; 0 means no limit
+    // if set, include directives at the beginning of source files which are common to several source files
+    // are precompiled once and reused
+    bool reusePreambles = false;
+    // if set, header files among source files are checked as if they were included by fake header sources,
+    // which are synthesized in memory with compile commands of source files next to them
+    bool lintHeaders = false;
+    // if set, source files are processed only if they or any file they include is among changed files
+    bool skipUnchangedSourceFiles = false;
+    std::set<std::string> changedFiles; // clean absolute paths
+    // if given, files included by each source file are remembered in this file, so that next time
+    // source files not affected by changed files can be skipped without even preprocessing them
+    std::string includeIndexFile;
+    // if set, source files are processed by forked worker processes instead of threads, so that a crash
+    // on one source file is reported as error of that source file and does not stop the whole run
+    bool useWorkerProcesses = false;
+    // time and memory limits of processing each source file
+    TranslationUnitLimits translationUnitLimits;
+    // if given, FileManagers are taken from this cache instead of being created for this run only
+    FileManagerCache* fileManagerCache = nullptr;
+};
+
+// Number of CPUs that this process may actually use, taking into account CPU affinity and cgroup quota
+unsigned GetAvailableCpuCount();
+
+// Does the same as ClangTool::run(), but processes source files on given number of worker threads
+// Each worker has its own Context and SourceLocationHelper; the results of each source file are recorded
+// and then replayed to output printer of given context in order of source files, so the final report
+// is the same as it would be from serial run, regardless of order in which source files were processed
+// In sharded run, only every shard.count-th source file is processed and cross-TU state is printed
+// instead of violations that depend on it, so that shard reports can be combined later by report merge
+int RunParallelLint(const clang::tooling::CompilationDatabase& compilations,
+                    const std::vector<std::string>& sourcePaths,
+                    Context& context,
+                    const ParallelLintOptions& options);
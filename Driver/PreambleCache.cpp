@@ -0,0 +1,485 @@
+#include "Driver/PreambleCache.h"
+
+#include "ActionFactories.h"
+
+#include "Common/HashHelper.h"
+#include "Common/SourceLocationHelper.h"
+
+#include "Driver/CompileCommandHelper.h"
+
+#include "Handlers/BeginSourceFileHandler.h"
+
+#include <clang/Basic/SourceManager.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Tooling/ArgumentsAdjusters.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <clang/Tooling/Tooling.h>
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+using namespace llvm;
+using namespace clang;
+using namespace clang::tooling;
+
+namespace
+{
+
+bool ReadFile(const std::string& path, std::string& content)
+{
+    std::ifstream str(path.c_str(), std::ios::binary);
+    if (!str.good())
+        return false;
+
+    std::stringstream contentStr;
+    contentStr << str.rdbuf();
+    content = contentStr.str();
+    return true;
+}
+
+bool IsIncludeDirective(StringRef directive)
+{
+    if (!directive.startswith("include"))
+        return false;
+
+    StringRef rest = directive.drop_front(strlen("include")).ltrim();
+    return rest.startswith("\"") || rest.startswith("<");
+}
+
+// Leading include directives of file, with comments, blank lines, #pragma once and include guard skipped
+// Anything else (including conditional compilation and macro definitions) ends the prefix, as it could
+// change meaning of the following includes
+std::vector<std::string> GetIncludePrefix(const std::string& content)
+{
+    std::vector<std::string> includes;
+    std::string pendingGuard;
+    bool guardAllowed = true;
+    bool inBlockComment = false;
+
+    std::istringstream str(content);
+    std::string rawLine;
+    while (std::getline(str, rawLine))
+    {
+        StringRef line = StringRef(rawLine).trim();
+
+        if (inBlockComment)
+        {
+            std::size_t commentEnd = line.find("*/");
+            if (commentEnd == StringRef::npos)
+                continue;
+
+            inBlockComment = false;
+            line = line.drop_front(commentEnd + 2).trim();
+        }
+
+        if (line.startswith("/*"))
+        {
+            std::size_t commentEnd = line.find("*/", 2);
+            if (commentEnd == StringRef::npos)
+            {
+                inBlockComment = true;
+                continue;
+            }
+            line = line.drop_front(commentEnd + 2).trim();
+        }
+
+        if (line.empty() || line.startswith("//"))
+            continue;
+
+        if (!line.startswith("#") || line.endswith("\\") || line.find("/*") != StringRef::npos)
+            break;
+
+        StringRef directive = line.drop_front(1).ltrim();
+
+        if (!pendingGuard.empty())
+        {
+            if (directive != ("define " + pendingGuard))
+                break;
+
+            pendingGuard.clear();
+            continue;
+        }
+
+        if (directive == "pragma once")
+            continue;
+
+        if (guardAllowed && directive.startswith("ifndef "))
+        {
+            pendingGuard = directive.drop_front(strlen("ifndef ")).trim();
+            guardAllowed = false;
+            continue;
+        }
+
+        if (!IsIncludeDirective(directive))
+            break;
+
+        includes.push_back(line.str());
+        guardAllowed = false;
+    }
+
+    return includes;
+}
+
+bool IsQuotedInclude(const std::string& includeLine)
+{
+    return includeLine.find('"') != std::string::npos;
+}
+
+// Fake header source consists of single include of the actual header, which is looked up
+// in the same way as the compiler would do it
+std::string FindFakeSourceHeader(const std::string& sourcePath, const CompileCommand& compileCommand)
+{
+    std::string content;
+    if (!ReadFile(sourcePath, content))
+        return "";
+
+    std::vector<std::string> includes = GetIncludePrefix(content);
+    if (includes.size() != 1)
+        return "";
+
+    StringRef includeLine = includes.front();
+    bool quoted = IsQuotedInclude(includeLine);
+    std::size_t nameBegin = includeLine.find_first_of("\"<");
+    std::size_t nameEnd = includeLine.find_first_of("\">", nameBegin + 1);
+    if (nameEnd == StringRef::npos)
+        return "";
+
+    std::string headerName = includeLine.slice(nameBegin + 1, nameEnd).str();
+
+    std::vector<std::string> searchDirectories;
+    if (quoted)
+        searchDirectories.push_back(sys::path::parent_path(sourcePath));
+
+    const auto& commandLine = compileCommand.CommandLine;
+    for (std::size_t i = 1; i < commandLine.size(); ++i)
+    {
+        StringRef arg = commandLine[i];
+        for (StringRef option : {"-iquote", "-I", "-isystem"})
+        {
+            if (!arg.startswith(option) || (option == "-iquote" && !quoted))
+                continue;
+
+            std::string directory = arg.drop_front(option.size());
+            if (directory.empty() && i + 1 < commandLine.size())
+                directory = commandLine[++i];
+
+            searchDirectories.push_back(GetAbsolutePath(compileCommand.Directory, directory));
+            break;
+        }
+    }
+
+    for (const auto& directory : searchDirectories)
+    {
+        std::string headerPath = GetAbsolutePath(directory, headerName);
+        if (sys::fs::exists(headerPath))
+            return headerPath;
+    }
+
+    return "";
+}
+
+// Flags of compile command without output and source file, so that they can be compared between source files
+bool GetPreambleCommandLine(const std::string& sourcePath,
+                            const CompileCommand& compileCommand,
+                            std::vector<std::string>& commandLine)
+{
+    commandLine = getClangStripOutputAdjuster()(compileCommand.CommandLine);
+
+    auto sourceArg = FindSourceArgument(commandLine, compileCommand.Directory, sourcePath);
+    if (sourceArg == commandLine.end())
+        return false;
+
+    commandLine.erase(sourceArg);
+    commandLine.erase(std::remove(commandLine.begin() + 1, commandLine.end(), "-fsyntax-only"), commandLine.end());
+    return true;
+}
+
+class PrecompilePreambleAction : public GeneratePCHAction
+{
+public:
+    explicit PrecompilePreambleAction(std::set<std::string>& inputFiles)
+        : m_inputFiles(inputFiles)
+    {}
+
+    void EndSourceFileAction() override
+    {
+        CollectInputFiles(getCompilerInstance(), m_inputFiles);
+    }
+
+private:
+    std::set<std::string>& m_inputFiles;
+};
+
+class PreambleDiagnosticRecorder : public DiagnosticConsumer
+{
+public:
+    PreambleDiagnosticRecorder(std::vector<PreambleDiagnostic>& diagnostics,
+                               SourceLocationHelper& sourceLocationHelper)
+        : m_diagnostics(diagnostics),
+          m_sourceLocationHelper(sourceLocationHelper)
+    {}
+
+    void HandleDiagnostic(DiagnosticsEngine::Level level, const Diagnostic& info) override
+    {
+        DiagnosticConsumer::HandleDiagnostic(level, info);
+
+        if (level < DiagnosticsEngine::Level::Warning || !info.getLocation().isValid())
+            return;
+
+        SmallVector<char, 100> message;
+        info.FormatDiagnostic(message);
+
+        SourceManager& sourceManager = info.getSourceManager();
+        const FileEntry* fileEntry = sourceManager.getFileEntryForID(sourceManager.getFileID(info.getLocation()));
+
+        PreambleDiagnostic diagnostic;
+        diagnostic.level = level;
+        diagnostic.message = std::string(message.begin(), message.end());
+        diagnostic.fileName = (fileEntry != nullptr) ? m_sourceLocationHelper.CleanRawFilename(fileEntry->getName()) : "";
+        diagnostic.lineNumber = sourceManager.getPresumedLineNumber(info.getLocation());
+        m_diagnostics.push_back(std::move(diagnostic));
+    }
+
+private:
+    std::vector<PreambleDiagnostic>& m_diagnostics;
+    SourceLocationHelper& m_sourceLocationHelper;
+};
+
+} // anonymous namespace
+
+PreambleCache::PreambleCache()
+{}
+
+PreambleCache::~PreambleCache()
+{
+    if (m_temporaryDirectory.empty())
+        return;
+
+    for (const auto& entry : m_entries)
+    {
+        if (entry.second->state == EntryState::Built)
+            std::remove(entry.second->preamble.precompiledPath.c_str());
+    }
+
+    sys::fs::remove(m_temporaryDirectory);
+}
+
+std::vector<std::string> PreambleCache::AssignPreambles(const std::vector<PreambleSource>& sources)
+{
+    struct Candidate
+    {
+        std::string preambleSourcePath;
+        std::vector<std::string> includes;
+        std::vector<std::string> commandLine;
+        std::vector<std::string> prefixKeys; // key of first i+1 includes
+    };
+
+    std::vector<Candidate> candidates(sources.size());
+    std::unordered_map<std::string, int> prefixKeyCounts;
+
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+        const PreambleSource& source = sources[i];
+        const CompileCommand& compileCommand = *source.compileCommand;
+        Candidate& candidate = candidates[i];
+
+        if (!source.preambleSourcePath.empty())
+            candidate.preambleSourcePath = source.preambleSourcePath;
+        else if (BeginSourceFileHandler::IsFakeHeaderSource(source.sourcePath))
+            candidate.preambleSourcePath = FindFakeSourceHeader(source.sourcePath, compileCommand);
+        else
+            candidate.preambleSourcePath = source.sourcePath;
+
+        std::string content;
+        if (candidate.preambleSourcePath.empty() ||
+            !ReadFile(candidate.preambleSourcePath, content) ||
+            !GetPreambleCommandLine(source.sourcePath, compileCommand, candidate.commandLine))
+        {
+            continue;
+        }
+
+        candidate.includes = GetIncludePrefix(content);
+
+        MD5 flagsHash;
+        UpdateHash(flagsHash, compileCommand.Directory);
+        for (std::size_t arg = 1; arg < candidate.commandLine.size(); ++arg)
+            UpdateHash(flagsHash, candidate.commandLine[arg]);
+        std::string flagsKey = FinalizeHash(flagsHash);
+
+        // quoted includes are looked up relative to the including file first, so such preambles
+        // can be shared only by files in the same directory
+        bool hasQuotedInclude = false;
+        for (std::size_t prefixSize = 1; prefixSize <= candidate.includes.size(); ++prefixSize)
+        {
+            hasQuotedInclude = hasQuotedInclude || IsQuotedInclude(candidate.includes[prefixSize - 1]);
+
+            MD5 prefixHash;
+            UpdateHash(prefixHash, flagsKey);
+            UpdateHash(prefixHash, hasQuotedInclude ? sys::path::parent_path(candidate.preambleSourcePath) : "");
+            for (std::size_t include = 0; include < prefixSize; ++include)
+                UpdateHash(prefixHash, candidate.includes[include]);
+
+            candidate.prefixKeys.push_back(FinalizeHash(prefixHash));
+            ++prefixKeyCounts[candidate.prefixKeys.back()];
+        }
+    }
+
+    std::vector<std::string> preambleKeys(sources.size());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        const Candidate& candidate = candidates[i];
+
+        // the longest prefix that is worth precompiling
+        std::size_t prefixSize = candidate.prefixKeys.size();
+        while (prefixSize > 0 && prefixKeyCounts[candidate.prefixKeys[prefixSize - 1]] < 2)
+            --prefixSize;
+
+        if (prefixSize == 0)
+            continue;
+
+        const std::string& key = candidate.prefixKeys[prefixSize - 1];
+        preambleKeys[i] = key;
+
+        auto& entry = m_entries[key];
+        if (entry != nullptr)
+            continue;
+
+        entry = make_unique<Entry>();
+        entry->directory = sources[i].compileCommand->Directory;
+        entry->commandLine = candidate.commandLine;
+
+        SmallString<256> virtualPath(sys::path::parent_path(candidate.preambleSourcePath));
+        sys::path::append(virtualPath, "colobot-lint-preamble-" + key + ".h");
+        entry->preamble.virtualPath = virtualPath.str();
+
+        for (std::size_t include = 0; include < prefixSize; ++include)
+            entry->preamble.content += candidate.includes[include] + "\n";
+    }
+
+    return preambleKeys;
+}
+
+const Preamble* PreambleCache::GetPreamble(const std::string& key,
+                                           FileManager* fileManager,
+                                           const std::string& mainExecutable,
+                                           SourceLocationHelper& sourceLocationHelper)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+        ++m_statistics.misses;
+        return nullptr;
+    }
+
+    Entry& entry = *it->second;
+    if (entry.state == EntryState::NotBuilt)
+    {
+        if (!CreateTemporaryDirectory())
+        {
+            entry.state = EntryState::Failed;
+            ++m_statistics.failed;
+            ++m_statistics.misses;
+            return nullptr;
+        }
+
+        entry.state = EntryState::Building;
+        entry.preamble.precompiledPath = m_temporaryDirectory + "/" + key + ".pch";
+
+        // other workers needing the same preamble wait for it, which is still faster than parsing it again
+        lock.unlock();
+        bool built = Build(entry, fileManager, mainExecutable, sourceLocationHelper);
+        lock.lock();
+
+        entry.state = built ? EntryState::Built : EntryState::Failed;
+        ++(built ? m_statistics.built : m_statistics.failed);
+        ++m_statistics.misses;
+        m_entryBuilt.notify_all();
+
+        return built ? &entry.preamble : nullptr;
+    }
+
+    m_entryBuilt.wait(lock, [&entry]() { return entry.state != EntryState::Building; });
+
+    if (entry.state == EntryState::Failed)
+    {
+        ++m_statistics.misses;
+        return nullptr;
+    }
+
+    ++m_statistics.hits;
+    return &entry.preamble;
+}
+
+PreambleStatistics PreambleCache::GetStatistics()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+void PreambleCache::PrintStatistics(std::ostream& str)
+{
+    PreambleStatistics statistics = GetStatistics();
+    str << "Preambles: " << statistics.built << " precompiled, " << statistics.failed << " failed; "
+        << statistics.hits << " hits, " << statistics.misses << " misses" << std::endl;
+}
+
+bool PreambleCache::Build(Entry& entry,
+                          FileManager* fileManager,
+                          const std::string& mainExecutable,
+                          SourceLocationHelper& sourceLocationHelper)
+{
+    Preamble& preamble = entry.preamble;
+
+    CommandLineArguments commandLine = entry.commandLine;
+    commandLine[0] = mainExecutable;
+    commandLine.insert(commandLine.begin() + 1, {"-working-directory", entry.directory});
+    commandLine.insert(commandLine.end(), {"-x", "c++-header", preamble.virtualPath, "-o", preamble.precompiledPath});
+
+    ToolInvocation invocation(std::move(commandLine),
+                              new PrecompilePreambleAction(preamble.inputFiles),
+                              fileManager);
+    invocation.mapVirtualFile(preamble.virtualPath, preamble.content);
+
+    PreambleDiagnosticRecorder diagnosticRecorder(preamble.diagnostics, sourceLocationHelper);
+    invocation.setDiagnosticConsumer(&diagnosticRecorder);
+
+    bool built = invocation.run() && diagnosticRecorder.getNumErrors() == 0;
+
+    // preamble itself does not exist on disk
+    preamble.inputFiles.erase(preamble.virtualPath);
+
+    if (!built)
+        std::remove(preamble.precompiledPath.c_str());
+
+    return built;
+}
+
+bool PreambleCache::CreateTemporaryDirectory()
+{
+    if (!m_temporaryDirectory.empty())
+        return true;
+
+    SmallString<256> directory;
+    if (sys::fs::createUniqueDirectory("colobot-lint-preambles", directory))
+    {
+        std::cerr << "Failed to create directory for precompiled preambles" << std::endl;
+        return false;
+    }
+
+    m_temporaryDirectory = directory.str();
+    return true;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <clang/Basic/Diagnostic.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+class SourceLocationHelper;
+
+namespace clang
+{
+class FileManager;
+namespace tooling
+{
+struct CompileCommand;
+} // namespace tooling
+} // namespace clang
+
+// Warning reported while precompiling preamble; it is reported again for every source file using the preamble,
+// as the headers in preamble are not parsed again
+struct PreambleDiagnostic
+{
+    clang::DiagnosticsEngine::Level level;
+    std::string message;
+    std::string fileName;
+    int lineNumber;
+};
+
+struct Preamble
+{
+    // preamble is an in-memory file with the include directives, placed next to the file it was taken from,
+    // so that quoted includes are found in the same way
+    std::string virtualPath;
+    std::string content;
+    std::string precompiledPath;
+    std::vector<PreambleDiagnostic> diagnostics;
+    std::set<std::string> inputFiles;
+};
+
+struct PreambleSource
+{
+    std::string sourcePath;
+    // file from which preamble is taken, if not the source file itself (e.g. checked header of header check);
+    // if empty, it is found automatically
+    std::string preambleSourcePath;
+    const clang::tooling::CompileCommand* compileCommand;
+};
+
+struct PreambleStatistics
+{
+    unsigned built = 0;
+    unsigned failed = 0;
+    unsigned hits = 0;   // compile commands that reused preamble precompiled for another one
+    unsigned misses = 0; // compile commands that had to precompile preamble or could not use any
+};
+
+// Precompiled preambles (leading blocks of include directives) shared between compile commands in one run
+// Only include prefixes common to at least two compile commands with the same flags are precompiled,
+// each of them once, by the first worker that needs it. For fake header sources, preamble is taken from
+// the actual header file, so that the header itself is still parsed and checked as usual.
+// Headers in preamble must have include guards, as they are included again by the source file.
+class PreambleCache
+{
+public:
+    PreambleCache();
+    ~PreambleCache();
+
+    // returns preamble key for each compile command, or empty string if it does not share any preamble
+    std::vector<std::string> AssignPreambles(const std::vector<PreambleSource>& sources);
+
+    // precompiles preamble if needed; returns nullptr if key is empty or preamble could not be precompiled
+    const Preamble* GetPreamble(const std::string& key,
+                                clang::FileManager* fileManager,
+                                const std::string& mainExecutable,
+                                SourceLocationHelper& sourceLocationHelper);
+
+    PreambleStatistics GetStatistics();
+    void PrintStatistics(std::ostream& str);
+
+private:
+    enum class EntryState
+    {
+        NotBuilt,
+        Building,
+        Built,
+        Failed
+    };
+
+    struct Entry
+    {
+        EntryState state = EntryState::NotBuilt;
+        std::string directory;
+        std::vector<std::string> commandLine; // without source file
+        Preamble preamble;
+    };
+
+    bool Build(Entry& entry,
+               clang::FileManager* fileManager,
+               const std::string& mainExecutable,
+               SourceLocationHelper& sourceLocationHelper);
+    bool CreateTemporaryDirectory();
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_entryBuilt;
+    std::map<std::string, std::unique_ptr<Entry>> m_entries;
+    std::string m_temporaryDirectory;
+    PreambleStatistics m_statistics;
+};
@@ -0,0 +1,205 @@
+#include "Driver/RawTextLintRunner.h"
+
+#include "Common/Context.h"
+#include "Common/RecordingOutputPrinter.h"
+#include "Common/SourceLocationHelper.h"
+#include "Common/TranslationUnitReport.h"
+
+#include "Rules/LicenseInHeaderRule.h"
+#include "Rules/TodoRule.h"
+#include "Rules/WhitespaceRule.h"
+
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <unordered_set>
+
+#include <glob.h>
+
+using namespace llvm;
+
+namespace
+{
+
+bool IsGlobPattern(const std::string& path)
+{
+    return path.find_first_of("*?[") != std::string::npos;
+}
+
+// returns false if pattern doesn't match any file
+bool ExpandPathPattern(const std::string& pathPattern, std::vector<std::string>& paths)
+{
+    if (!IsGlobPattern(pathPattern))
+    {
+        paths.push_back(pathPattern);
+        return true;
+    }
+
+    glob_t globResult;
+    int ret = glob(pathPattern.c_str(), 0, nullptr, &globResult);
+    if (ret == 0)
+    {
+        for (std::size_t i = 0; i < globResult.gl_pathc; ++i)
+            paths.push_back(globResult.gl_pathv[i]);
+    }
+    globfree(&globResult);
+
+    return ret == 0;
+}
+
+class RawTextLintWorker
+{
+public:
+    RawTextLintWorker(const Context& mainContext);
+
+    void ProcessFile(const std::string& path, TranslationUnitReport& report);
+
+private:
+    SourceLocationHelper m_sourceLocationHelper;
+    Context m_context;
+    RecordingOutputPrinter* m_outputPrinter;
+    std::unique_ptr<TodoRule> m_todoRule;
+    std::unique_ptr<WhitespaceRule> m_whitespaceRule;
+    std::unique_ptr<LicenseInHeaderRule> m_licenseInHeaderRule;
+};
+
+template<typename RuleType>
+std::unique_ptr<RuleType> CreateRuleIfSelected(Context& context)
+{
+    if (!context.rulesSelection.empty() && context.rulesSelection.count(RuleType::GetName()) == 0)
+        return nullptr;
+
+    return make_unique<RuleType>(context);
+}
+
+RawTextLintWorker::RawTextLintWorker(const Context& mainContext)
+    : m_context(m_sourceLocationHelper,
+                make_unique<RecordingOutputPrinter>(m_sourceLocationHelper),
+                mainContext.projectLocalIncludePaths,
+                mainContext.licenseTemplateLines,
+                mainContext.rulesSelection,
+                mainContext.generatorSelection,
+                mainContext.verbose,
+                mainContext.debug),
+      m_outputPrinter(static_cast<RecordingOutputPrinter*>(m_context.outputPrinter.get())),
+      m_todoRule(CreateRuleIfSelected<TodoRule>(m_context)),
+      m_whitespaceRule(CreateRuleIfSelected<WhitespaceRule>(m_context)),
+      m_licenseInHeaderRule(CreateRuleIfSelected<LicenseInHeaderRule>(m_context))
+{
+    m_sourceLocationHelper.SetContext(&m_context);
+}
+
+void RawTextLintWorker::ProcessFile(const std::string& path, TranslationUnitReport& report)
+{
+    m_outputPrinter->SetReport(&report);
+
+    // large files are memory mapped instead of being read
+    auto buffer = MemoryBuffer::getFile(path);
+    if (!buffer)
+    {
+        std::cerr << "Could not read file " << path << ": " << buffer.getError().message() << std::endl;
+        report.failed = true;
+        m_outputPrinter->SetReport(nullptr);
+        return;
+    }
+
+    StringRef text = (*buffer)->getBuffer();
+
+    // the same order of rules as when file is processed by Clang
+    if (m_todoRule != nullptr)
+        m_todoRule->CheckFileText(path, text);
+    if (m_whitespaceRule != nullptr)
+        m_whitespaceRule->CheckFileText(path, text);
+    if (m_licenseInHeaderRule != nullptr)
+        m_licenseInHeaderRule->CheckFileText(path, text);
+
+    m_outputPrinter->SetReport(nullptr);
+}
+
+} // anonymous namespace
+
+std::vector<std::string> GetRawTextRuleNames()
+{
+    return { TodoRule::GetName(), WhitespaceRule::GetName(), LicenseInHeaderRule::GetName() };
+}
+
+int RunRawTextLint(const std::vector<std::string>& pathPatterns,
+                   Context& context,
+                   unsigned jobCount)
+{
+    std::vector<std::string> rawTextRuleNames = GetRawTextRuleNames();
+    for (const auto& rule : context.rulesSelection)
+    {
+        if (std::find(rawTextRuleNames.begin(), rawTextRuleNames.end(), rule) == rawTextRuleNames.end())
+        {
+            std::cerr << "Rule " << rule << " cannot be used in raw mode!" << std::endl;
+            return 1;
+        }
+    }
+
+    bool processingFailed = false;
+
+    std::vector<std::string> paths;
+    std::unordered_set<std::string> seenPaths;
+    for (const auto& pathPattern : pathPatterns)
+    {
+        std::vector<std::string> expandedPaths;
+        if (!ExpandPathPattern(pathPattern, expandedPaths))
+        {
+            std::cerr << "No files match " << pathPattern << std::endl;
+            processingFailed = true;
+            continue;
+        }
+
+        for (const auto& path : expandedPaths)
+        {
+            // file names are reported as clean absolute paths, the same as those given by Clang
+            SmallString<256> absolutePath(path);
+            sys::fs::make_absolute(absolutePath);
+            std::string cleanPath = context.sourceLocationHelper.CleanRawFilename(absolutePath);
+
+            if (seenPaths.insert(cleanPath).second)
+                paths.push_back(std::move(cleanPath));
+        }
+    }
+
+    std::vector<TranslationUnitReport> reports(paths.size());
+    std::atomic<std::size_t> nextPathIndex(0);
+
+    jobCount = std::max(1u, std::min<unsigned>(jobCount, paths.size()));
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < jobCount; ++i)
+    {
+        threads.emplace_back([&context, &paths, &reports, &nextPathIndex]()
+        {
+            RawTextLintWorker worker(context);
+            for (std::size_t index = nextPathIndex++; index < paths.size(); index = nextPathIndex++)
+            {
+                if (context.verbose)
+                {
+                    std::cerr << "Processing " + paths[index] + " [raw mode]\n";
+                }
+
+                worker.ProcessFile(paths[index], reports[index]);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (const auto& report : reports)
+    {
+        ReplayTranslationUnitReport(report, context);
+        processingFailed = processingFailed || report.failed;
+    }
+
+    return processingFailed ? 1 : 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct Context;
+
+// Names of rules which check only text of files and so can be run in raw mode
+std::vector<std::string> GetRawTextRuleNames();
+
+// Runs text-level rules (whitespace, license header and TODO comments) directly on given files,
+// without compilation database and Clang parser, so that it works also for files which are not compiled
+// Paths may be glob patterns; files are processed on given number of threads and their results
+// are replayed to output printer of given context in order of paths, as in serial run
+int RunRawTextLint(const std::vector<std::string>& pathPatterns,
+                   Context& context,
+                   unsigned jobCount);
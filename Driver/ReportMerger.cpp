@@ -0,0 +1,274 @@
+#include "Driver/ReportMerger.h"
+
+#include "Common/Context.h"
+#include "Common/OutputPrinter.h"
+#include "Common/TranslationUnitReport.h"
+
+#include "Rules/UndefinedFunctionRule.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <boost/optional.hpp>
+#include <boost/regex.hpp>
+
+#include <tinyxml.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <tuple>
+
+namespace
+{
+
+struct MergedViolation
+{
+    std::string fileName;
+    int lineNumber;
+    std::string ruleName;
+    std::string description;
+    Severity severity;
+
+    bool operator<(const MergedViolation& other) const
+    {
+        return std::tie(fileName, lineNumber, ruleName, description, severity) <
+            std::tie(other.fileName, other.lineNumber, other.ruleName, other.description, other.severity);
+    }
+};
+
+struct MergedReports
+{
+    std::set<MergedViolation> violations;
+    std::map<int, TranslationUnitReport> translationUnits;
+};
+
+boost::optional<Severity> ParseSeverity(const std::string& severity)
+{
+    if (severity == "style")
+        return Severity::Style;
+    else if (severity == "error")
+        return Severity::Error;
+    else if (severity == "warning")
+        return Severity::Warning;
+    else if (severity == "information")
+        return Severity::Information;
+
+    return boost::none;
+}
+
+int ParseInt(const char* str)
+{
+    return (str != nullptr) ? std::strtol(str, nullptr, 10) : 0;
+}
+
+std::string GetAttribute(const TiXmlElement* element, const char* name)
+{
+    const char* value = element->Attribute(name);
+    return (value != nullptr) ? value : "";
+}
+
+bool ParseXmlReport(const std::string& reportFileName, const std::string& content, MergedReports& mergedReports)
+{
+    TiXmlDocument document;
+    document.Parse(content.c_str());
+    if (document.Error())
+    {
+        std::cerr << "Could not parse report \"" << reportFileName << "\": " << document.ErrorDesc() << std::endl;
+        return false;
+    }
+
+    const TiXmlElement* resultsElement = document.FirstChildElement("results");
+    if (resultsElement == nullptr)
+    {
+        std::cerr << "Could not parse report \"" << reportFileName << "\": missing results element" << std::endl;
+        return false;
+    }
+
+    const TiXmlElement* errorsElement = resultsElement->FirstChildElement("errors");
+    if (errorsElement != nullptr)
+    {
+        for (const TiXmlElement* errorElement = errorsElement->FirstChildElement("error");
+             errorElement != nullptr;
+             errorElement = errorElement->NextSiblingElement("error"))
+        {
+            auto severity = ParseSeverity(GetAttribute(errorElement, "severity"));
+            const TiXmlElement* locationElement = errorElement->FirstChildElement("location");
+            if (!severity || locationElement == nullptr)
+            {
+                std::cerr << "Could not parse report \"" << reportFileName << "\": invalid error element" << std::endl;
+                return false;
+            }
+
+            MergedViolation violation;
+            violation.fileName = GetAttribute(locationElement, "file");
+            violation.lineNumber = ParseInt(locationElement->Attribute("line"));
+            violation.ruleName = GetAttribute(errorElement, "id");
+            violation.description = GetAttribute(errorElement, "msg");
+            violation.severity = *severity;
+            mergedReports.violations.insert(std::move(violation));
+        }
+    }
+
+    const TiXmlElement* translationUnitsElement = resultsElement->FirstChildElement("translation-units");
+    if (translationUnitsElement != nullptr)
+    {
+        for (const TiXmlElement* translationUnitElement = translationUnitsElement->FirstChildElement("translation-unit");
+             translationUnitElement != nullptr;
+             translationUnitElement = translationUnitElement->NextSiblingElement("translation-unit"))
+        {
+            int sourceFileIndex = ParseInt(translationUnitElement->Attribute("index"));
+            TranslationUnitReport& report = mergedReports.translationUnits[sourceFileIndex];
+
+            for (const TiXmlElement* functionElement = translationUnitElement->FirstChildElement("defined-function");
+                 functionElement != nullptr;
+                 functionElement = functionElement->NextSiblingElement("defined-function"))
+            {
+                report.definedFunctions.insert(GetAttribute(functionElement, "name"));
+            }
+
+            for (const TiXmlElement* functionElement = translationUnitElement->FirstChildElement("declared-function");
+                 functionElement != nullptr;
+                 functionElement = functionElement->NextSiblingElement("declared-function"))
+            {
+                SourceFileInfo info;
+                info.fileName = GetAttribute(functionElement, "file");
+                info.lineNumber = ParseInt(functionElement->Attribute("line"));
+                report.undefinedFunctions[GetAttribute(functionElement, "name")] = std::move(info);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ParsePlainTextReport(const std::string& reportFileName, const std::string& content, MergedReports& mergedReports)
+{
+    static const boost::regex violationPattern("^\\[(\\w+)\\] \\[([^\\]]+)\\] (.+?):(\\d+) (.*)$");
+    static const boost::regex translationUnitPattern("^\\[translation unit\\] (\\d+) (.*)$");
+    static const boost::regex definedFunctionPattern("^\\[defined function\\] (.*)$");
+    static const boost::regex declaredFunctionPattern("^\\[declared function\\] (.+?):(\\d+) (.*)$");
+
+    boost::optional<MergedViolation> pendingViolation;
+    TranslationUnitReport* currentTranslationUnit = nullptr;
+
+    auto flushPendingViolation = [&]()
+    {
+        if (pendingViolation)
+            mergedReports.violations.insert(std::move(*pendingViolation));
+        pendingViolation = boost::none;
+    };
+
+    std::istringstream str(content);
+    std::string line;
+    while (std::getline(str, line))
+    {
+        boost::smatch match;
+        if (boost::regex_match(line, match, translationUnitPattern))
+        {
+            flushPendingViolation();
+            currentTranslationUnit = &mergedReports.translationUnits[ParseInt(match[1].str().c_str())];
+        }
+        else if (boost::regex_match(line, match, definedFunctionPattern))
+        {
+            flushPendingViolation();
+            if (currentTranslationUnit == nullptr)
+            {
+                std::cerr << "Could not parse report \"" << reportFileName << "\": function outside translation unit" << std::endl;
+                return false;
+            }
+            currentTranslationUnit->definedFunctions.insert(match[1].str());
+        }
+        else if (boost::regex_match(line, match, declaredFunctionPattern))
+        {
+            flushPendingViolation();
+            if (currentTranslationUnit == nullptr)
+            {
+                std::cerr << "Could not parse report \"" << reportFileName << "\": function outside translation unit" << std::endl;
+                return false;
+            }
+            SourceFileInfo info;
+            info.fileName = match[1].str();
+            info.lineNumber = ParseInt(match[2].str().c_str());
+            currentTranslationUnit->undefinedFunctions[match[3].str()] = std::move(info);
+        }
+        else if (boost::regex_match(line, match, violationPattern) && ParseSeverity(match[1].str()))
+        {
+            flushPendingViolation();
+            MergedViolation violation;
+            violation.severity = *ParseSeverity(match[1].str());
+            violation.ruleName = match[2].str();
+            violation.fileName = match[3].str();
+            violation.lineNumber = ParseInt(match[4].str().c_str());
+            violation.description = match[5].str();
+            pendingViolation = std::move(violation);
+        }
+        else if (pendingViolation)
+        {
+            // descriptions of some diagnostics span multiple lines
+            pendingViolation->description += "\n" + line;
+        }
+        else if (!line.empty())
+        {
+            std::cerr << "Could not parse report \"" << reportFileName << "\": unexpected line \"" << line << "\"" << std::endl;
+            return false;
+        }
+    }
+
+    flushPendingViolation();
+    return true;
+}
+
+bool ParseReport(const std::string& reportFileName, MergedReports& mergedReports)
+{
+    std::ifstream file(reportFileName.c_str());
+    if (!file.good())
+    {
+        std::cerr << "Could not open report \"" << reportFileName << "\"!" << std::endl;
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string content = buffer.str();
+
+    std::size_t firstNonSpace = content.find_first_not_of(" \t\r\n");
+    if (firstNonSpace != std::string::npos && content[firstNonSpace] == '<')
+        return ParseXmlReport(reportFileName, content, mergedReports);
+
+    return ParsePlainTextReport(reportFileName, content, mergedReports);
+}
+
+} // anonymous namespace
+
+int MergeReports(const std::vector<std::string>& reportFileNames, Context& context)
+{
+    MergedReports mergedReports;
+    for (const auto& reportFileName : reportFileNames)
+    {
+        if (!ParseReport(reportFileName, mergedReports))
+            return 1;
+    }
+
+    for (const auto& violation : mergedReports.violations)
+    {
+        context.outputPrinter->PrintRuleViolation(
+            violation.ruleName,
+            violation.severity,
+            violation.description,
+            violation.fileName,
+            violation.lineNumber);
+    }
+
+    // translation units are replayed in the order of source files, as in single-process run
+    for (const auto& translationUnit : mergedReports.translationUnits)
+    {
+        ReplayTranslationUnitReport(translationUnit.second, context);
+    }
+
+    UndefinedFunctionRule::PrintUndefinedFunctions(context);
+
+    return 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct Context;
+
+// Combines reports from sharded runs (in XML or plain text format) into one report printed to output printer
+// of given context; violations are deduplicated and sorted, and undefined functions are resolved from cross-TU
+// state of all shards, so the result is the same as from single-process run
+int MergeReports(const std::vector<std::string>& reportFileNames, Context& context);
@@ -0,0 +1,260 @@
+#include "Driver/ResultCache.h"
+
+#include "ColobotLintConfig.h"
+
+#include "Common/Context.h"
+#include "Common/FileSystemHelper.h"
+#include "Common/HashHelper.h"
+#include "Common/TranslationUnitReport.h"
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+using namespace llvm;
+using namespace clang::tooling;
+
+namespace
+{
+
+const char* CACHE_ENTRY_HEADER = "colobot-lint result cache v1";
+
+struct CacheEntryFile
+{
+    std::string path;
+    std::int64_t lastUsedTimeNs;
+    std::uint64_t size;
+};
+
+} // anonymous namespace
+
+ResultCache::ResultCache(const std::string& directory, std::uint64_t maxSize, const Context& context)
+    : m_directory(directory),
+      m_maxSize(maxSize)
+{
+    MD5 hash;
+    UpdateHash(hash, CACHE_ENTRY_HEADER);
+    UpdateHash(hash, COLOBOT_LINT_VERSION_STR);
+    UpdateHash(hash, LLVM_VERSION_STRING);
+    UpdateHash(hash, context.generatorSelection);
+    for (const auto& rule : context.rulesSelection)
+        UpdateHash(hash, "rule=" + rule);
+    for (const auto& path : context.projectLocalIncludePaths)
+        UpdateHash(hash, "include=" + path);
+    for (const auto& line : context.licenseTemplateLines)
+        UpdateHash(hash, "license=" + line);
+    m_optionsHash = FinalizeHash(hash);
+}
+
+std::string ResultCache::GetKey(const std::string& sourcePath,
+                                const std::vector<CompileCommand>& compileCommands) const
+{
+    MD5 hash;
+    UpdateHash(hash, m_optionsHash);
+    UpdateHash(hash, sourcePath);
+    for (const auto& compileCommand : compileCommands)
+    {
+        UpdateHash(hash, compileCommand.Directory);
+        UpdateHash(hash, std::to_string(compileCommand.CommandLine.size()));
+        for (const auto& argument : compileCommand.CommandLine)
+            UpdateHash(hash, argument);
+    }
+    return FinalizeHash(hash);
+}
+
+bool ResultCache::Load(const std::string& key, TranslationUnitReport& report)
+{
+    std::string entryPath = GetEntryPath(key);
+    std::ifstream str(entryPath.c_str(), std::ios::binary);
+    if (!str.good())
+        return false;
+
+    std::string header;
+    std::getline(str, header);
+    if (header != CACHE_ENTRY_HEADER)
+        return false;
+
+    std::size_t inputFileCount = 0;
+    if (!(str >> inputFileCount) || str.get() != '\n')
+        return false;
+
+    for (std::size_t i = 0; i < inputFileCount; ++i)
+    {
+        std::string path, storedHash, currentHash;
+        if (!std::getline(str, path) || !std::getline(str, storedHash))
+            return false;
+
+        if (!GetFileHash(path, currentHash) || currentHash != storedHash)
+            return false;
+    }
+
+    TranslationUnitReport cachedReport;
+    if (!DeserializeTranslationUnitReport(str, cachedReport))
+        return false;
+
+    report = std::move(cachedReport);
+
+    // modification time of entry is used as time of last use when removing old entries
+    utime(entryPath.c_str(), nullptr);
+
+    return true;
+}
+
+void ResultCache::Store(const std::string& key,
+                        const std::set<std::string>& inputFiles,
+                        const TranslationUnitReport& report,
+                        std::int64_t processingStartTimeNs)
+{
+    std::ostringstream entry;
+    entry << CACHE_ENTRY_HEADER << "\n";
+    entry << inputFiles.size() << "\n";
+    for (const auto& inputFile : inputFiles)
+    {
+        std::string hash;
+        std::int64_t modificationTimeNs = 0;
+        if (!GetFileHash(inputFile, hash, &modificationTimeNs) || modificationTimeNs > processingStartTimeNs)
+            return;
+
+        // paths with newlines would break the format and are not worth supporting
+        if (inputFile.find('\n') != std::string::npos)
+            return;
+
+        entry << inputFile << "\n" << hash << "\n";
+    }
+    SerializeTranslationUnitReport(report, entry);
+
+    std::string entryPath = GetEntryPath(key);
+    if (sys::fs::create_directories(sys::path::parent_path(entryPath)))
+        return;
+
+    // written to unique temporary file and renamed, so that other runs sharing the cache
+    // never see partially written entry
+    std::string tempPath = entryPath + ".tmp." + std::to_string(getpid()) + "." +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    {
+        std::ofstream str(tempPath.c_str(), std::ios::binary);
+        str << entry.str();
+        if (!str.good())
+        {
+            std::remove(tempPath.c_str());
+            return;
+        }
+    }
+
+    if (std::rename(tempPath.c_str(), entryPath.c_str()) != 0)
+        std::remove(tempPath.c_str());
+}
+
+void ResultCache::RemoveLeastRecentlyUsedEntries()
+{
+    if (m_maxSize == 0)
+        return;
+
+    std::vector<CacheEntryFile> entryFiles;
+    std::uint64_t totalSize = 0;
+
+    std::error_code ec;
+    for (sys::fs::recursive_directory_iterator it(m_directory, ec), end; it != end && !ec; it.increment(ec))
+    {
+        struct stat fileStat;
+        if (stat(it->path().c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+            continue;
+
+        entryFiles.push_back(CacheEntryFile{it->path(), GetModificationTimeNs(fileStat), static_cast<std::uint64_t>(fileStat.st_size)});
+        totalSize += fileStat.st_size;
+    }
+
+    if (totalSize <= m_maxSize)
+        return;
+
+    std::sort(entryFiles.begin(), entryFiles.end(),
+              [](const CacheEntryFile& left, const CacheEntryFile& right)
+              {
+                  return std::tie(left.lastUsedTimeNs, left.path) < std::tie(right.lastUsedTimeNs, right.path);
+              });
+
+    for (const auto& entryFile : entryFiles)
+    {
+        if (totalSize <= m_maxSize)
+            break;
+
+        // entry may have been already removed by other run sharing the cache
+        std::remove(entryFile.path.c_str());
+        totalSize -= entryFile.size;
+    }
+}
+
+std::string ResultCache::GetEntryPath(const std::string& key) const
+{
+    SmallString<256> path(m_directory);
+    sys::path::append(path, key.substr(0, 2), key);
+    return path.str();
+}
+
+std::int64_t ResultCache::GetCurrentTimeNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool ResultCache::GetFileHash(const std::string& path, std::string& hash, std::int64_t* modificationTimeNs)
+{
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) != 0)
+        return false;
+
+    if (modificationTimeNs != nullptr)
+        *modificationTimeNs = GetModificationTimeNs(fileStat);
+
+    {
+        std::lock_guard<std::mutex> lock(m_fileHashesMutex);
+        auto it = m_fileHashes.find(path);
+        if (it != m_fileHashes.end() &&
+            it->second.modificationTimeNs == GetModificationTimeNs(fileStat) &&
+            it->second.size == static_cast<std::uint64_t>(fileStat.st_size))
+        {
+            hash = it->second.hash;
+            return true;
+        }
+    }
+
+    std::ifstream str(path.c_str(), std::ios::binary);
+    if (!str.good())
+        return false;
+
+    std::stringstream content;
+    content << str.rdbuf();
+
+    MD5 contentHash;
+    contentHash.update(content.str());
+    hash = FinalizeHash(contentHash);
+
+    FileHash fileHash;
+    fileHash.modificationTimeNs = GetModificationTimeNs(fileStat);
+    fileHash.size = fileStat.st_size;
+    fileHash.hash = hash;
+
+    std::lock_guard<std::mutex> lock(m_fileHashesMutex);
+    m_fileHashes[path] = std::move(fileHash);
+
+    return true;
+}
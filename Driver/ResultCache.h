@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+struct Context;
+struct TranslationUnitReport;
+
+namespace clang
+{
+namespace tooling
+{
+struct CompileCommand;
+} // namespace tooling
+} // namespace clang
+
+// Cache of results of source files, stored in a directory which may be shared between several runs
+// (also running at the same time)
+// Each entry is keyed on source file, its compile commands and options that affect results. Along with
+// the results, it stores hashes of contents of all files read while processing the source file, so entry
+// is valid only as long as none of these files (including headers) changed.
+// Entries are written atomically; when the cache grows over the size limit, least recently used
+// entries are removed.
+class ResultCache
+{
+public:
+    ResultCache(const std::string& directory, std::uint64_t maxSize, const Context& context);
+
+    std::string GetKey(const std::string& sourcePath,
+                       const std::vector<clang::tooling::CompileCommand>& compileCommands) const;
+
+    bool Load(const std::string& key, TranslationUnitReport& report);
+
+    // input files modified after processing started are not trusted, so such results are not stored
+    void Store(const std::string& key,
+               const std::set<std::string>& inputFiles,
+               const TranslationUnitReport& report,
+               std::int64_t processingStartTimeNs);
+
+    void RemoveLeastRecentlyUsedEntries();
+
+    static std::int64_t GetCurrentTimeNs();
+
+private:
+    struct FileHash
+    {
+        std::int64_t modificationTimeNs = 0;
+        std::uint64_t size = 0;
+        std::string hash;
+    };
+
+    std::string GetEntryPath(const std::string& key) const;
+    bool GetFileHash(const std::string& path, std::string& hash, std::int64_t* modificationTimeNs = nullptr);
+
+private:
+    const std::string m_directory;
+    const std::uint64_t m_maxSize;
+    std::string m_optionsHash;
+
+    std::mutex m_fileHashesMutex;
+    std::map<std::string, FileHash> m_fileHashes;
+};
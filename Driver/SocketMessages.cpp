@@ -0,0 +1,74 @@
+#include "Driver/SocketMessages.h"
+
+#include <cerrno>
+
+#include <sys/socket.h>
+#include <sys/types.h>
+
+namespace
+{
+
+bool ReceiveBytes(int socketFd, char* buffer, std::size_t size)
+{
+    std::size_t received = 0;
+    while (received < size)
+    {
+        ssize_t result = recv(socketFd, buffer + received, size - received, 0);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            return false;
+
+        received += result;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+bool SendMessage(int socketFd, const std::string& message)
+{
+    if (message.size() > MAX_MESSAGE_SIZE)
+        return false;
+
+    std::string data = std::to_string(message.size()) + "\n" + message;
+
+    std::size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t result = send(socketFd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result <= 0)
+            return false;
+
+        sent += result;
+    }
+
+    return true;
+}
+
+bool ReceiveMessage(int socketFd, std::string& message)
+{
+    std::size_t size = 0;
+    while (true)
+    {
+        char c = 0;
+        if (!ReceiveBytes(socketFd, &c, 1))
+            return false;
+
+        if (c == '\n')
+            break;
+
+        if (c < '0' || c > '9')
+            return false;
+
+        size = size * 10 + (c - '0');
+        if (size > MAX_MESSAGE_SIZE)
+            return false;
+    }
+
+    message.resize(size);
+    return size == 0 || ReceiveBytes(socketFd, &message[0], size);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Messages sent over stream sockets are prefixed with their length, so that they can be read without parsing
+// Used both between colobot-lint client and daemon, and between supervisor and worker processes
+// Messages larger than MAX_MESSAGE_SIZE are neither sent nor received, so that a broken or hostile peer
+// cannot make the other side allocate arbitrary amount of memory
+
+const std::size_t MAX_MESSAGE_SIZE = 256 * 1024 * 1024;
+
+bool SendMessage(int socketFd, const std::string& message);
+
+// returns false on error or if the other side closed the socket
+bool ReceiveMessage(int socketFd, std::string& message);
@@ -0,0 +1,98 @@
+#include "Driver/TimingHistory.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include <unistd.h>
+
+namespace
+{
+
+const char* TIMING_HISTORY_HEADER = "# colobot-lint timing history v1: <wall time ms> <peak memory kB> <source file>";
+
+} // anonymous namespace
+
+bool TimingHistory::Load(const std::string& fileName)
+{
+    std::ifstream str(fileName.c_str());
+    if (!str.good())
+        return true;
+
+    std::string line;
+    while (std::getline(str, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream lineStr(line);
+        TranslationUnitTiming timing;
+        std::string sourcePath;
+        lineStr >> timing.wallTimeMs >> timing.peakMemoryKb;
+        lineStr.get(); // separating space; source path may contain spaces itself
+        std::getline(lineStr, sourcePath);
+        if (lineStr.fail() || sourcePath.empty())
+        {
+            std::cerr << "Ignoring invalid timing history file \"" << fileName << "\"" << std::endl;
+            m_timings.clear();
+            return false;
+        }
+
+        m_timings[sourcePath] = timing;
+    }
+
+    return true;
+}
+
+bool TimingHistory::Save(const std::string& fileName) const
+{
+    // written to temporary file and renamed, so that concurrent runs never see partially written history
+    std::string tempFileName = fileName + ".tmp." + std::to_string(getpid());
+
+    {
+        std::ofstream str(tempFileName.c_str());
+        str << TIMING_HISTORY_HEADER << "\n";
+
+        // sorted, so that history file is stable between runs
+        std::map<std::string, TranslationUnitTiming> sortedTimings(m_timings.begin(), m_timings.end());
+        for (const auto& timing : sortedTimings)
+        {
+            str << std::fixed << std::setprecision(1) << timing.second.wallTimeMs << " "
+                << timing.second.peakMemoryKb << " "
+                << timing.first << "\n";
+        }
+
+        if (!str.good())
+        {
+            std::cerr << "Could not write timing history file \"" << fileName << "\"" << std::endl;
+            std::remove(tempFileName.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tempFileName.c_str(), fileName.c_str()) != 0)
+    {
+        std::cerr << "Could not write timing history file \"" << fileName << "\"" << std::endl;
+        std::remove(tempFileName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+void TimingHistory::Record(const std::string& sourcePath, const TranslationUnitTiming& timing)
+{
+    m_timings[sourcePath] = timing;
+}
+
+double TimingHistory::GetEstimatedCost(const std::string& sourcePath) const
+{
+    auto it = m_timings.find(sourcePath);
+    if (it == m_timings.end())
+        return -1.0;
+
+    return it->second.wallTimeMs;
+}
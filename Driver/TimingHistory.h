@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+struct TranslationUnitTiming
+{
+    double wallTimeMs = 0.0;
+    std::size_t peakMemoryKb = 0;
+};
+
+// Per-TU wall time and peak memory from previous runs, persisted in a small text file
+// Used to estimate cost of processing source files, so that longest ones can be scheduled first
+class TimingHistory
+{
+public:
+    // missing file is not an error, it just gives empty history
+    bool Load(const std::string& fileName);
+    bool Save(const std::string& fileName) const;
+
+    void Record(const std::string& sourcePath, const TranslationUnitTiming& timing);
+
+    // returns negative value if source file is not known
+    double GetEstimatedCost(const std::string& sourcePath) const;
+
+private:
+    std::unordered_map<std::string, TranslationUnitTiming> m_timings;
+};
@@ -4,45 +4,93 @@
 #include "Common/OutputPrinter.h"
 #include "Common/SourceLocationHelper.h"
 
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/ExprCXX.h>
+#include <clang/Basic/SourceManager.h>
+
 using namespace clang;
-using namespace clang::ast_matchers;
 
 DependencyGraphGenerator::DependencyGraphGenerator(Context& context)
     : Generator(context),
-      m_recordDeclMatcher(recordDecl().bind("recordDecl")),
-      m_memberCallExprMatcher(memberCallExpr(hasAncestor(methodDecl(hasDeclContext(recordDecl().bind("callerRecordDecl"))))).bind("memberCallExpr"))
+      m_sourceManager(nullptr)
 {}
 
-void DependencyGraphGenerator::RegisterASTMatcherCallback(MatchFinder& finder)
+void DependencyGraphGenerator::HandleTranslationUnit(ASTContext& context)
 {
-    finder.addMatcher(m_recordDeclMatcher, this);
-    finder.addMatcher(m_memberCallExprMatcher, this);
+    m_sourceManager = &context.getSourceManager();
+    m_mainFileID = m_context.sourceLocationHelper.GetMainFileID(*m_sourceManager);
+    m_callerRecordDecls.clear();
+    m_printedCalls.clear();
+
+    TraverseDecl(context.getTranslationUnitDecl());
 }
 
-void DependencyGraphGenerator::run(const MatchFinder::MatchResult& result)
+bool DependencyGraphGenerator::TraverseDecl(Decl* declaration)
 {
-    SourceManager& sourceManager = result.Context->getSourceManager();
+    if (declaration == nullptr)
+        return true;
+
+    // edges are printed only for code in main file, so there's no point in descending into headers
+    if (auto* translationUnit = dyn_cast<TranslationUnitDecl>(declaration))
+    {
+        for (auto* topLevelDeclaration : translationUnit->decls())
+        {
+            if (IsInMainFile(topLevelDeclaration) && ! TraverseDecl(topLevelDeclaration))
+                return false;
+        }
+
+        return true;
+    }
+
+    const auto* method = dyn_cast<CXXMethodDecl>(declaration);
+    if (method != nullptr)
+        m_callerRecordDecls.push_back(method->getParent());
 
-    const CXXRecordDecl* recordDecl = result.Nodes.getNodeAs<CXXRecordDecl>("recordDecl");
-    if (recordDecl != nullptr)
-        return HandleRecordDeclaration(recordDecl, sourceManager);
+    bool result = RecursiveASTVisitor<DependencyGraphGenerator>::TraverseDecl(declaration);
 
-    const CXXMemberCallExpr* memberCallExpr = result.Nodes.getNodeAs<CXXMemberCallExpr>("memberCallExpr");
-    const RecordDecl* callerRecordDecl = result.Nodes.getNodeAs<RecordDecl>("callerRecordDecl");
-    if (memberCallExpr != nullptr && callerRecordDecl != nullptr)
-        return HandleMemberCallExpression(memberCallExpr, callerRecordDecl, sourceManager);
+    if (method != nullptr)
+        m_callerRecordDecls.pop_back();
+
+    return result;
+}
+
+bool DependencyGraphGenerator::VisitCXXRecordDecl(CXXRecordDecl* recordDecl)
+{
+    HandleRecordDeclaration(recordDecl);
+    return true;
 }
 
-void DependencyGraphGenerator::HandleRecordDeclaration(const CXXRecordDecl* recordDecl,
-                                                       SourceManager& sourceManager)
+bool DependencyGraphGenerator::VisitCXXMemberCallExpr(CXXMemberCallExpr* memberCallExpr)
+{
+    if (! m_callerRecordDecls.empty())
+        HandleMemberCallExpression(memberCallExpr, m_callerRecordDecls.back());
+
+    return true;
+}
+
+bool DependencyGraphGenerator::IsInMainFile(const Decl* declaration)
+{
+    SourceLocation expansionLocation = m_sourceManager->getExpansionLoc(declaration->getLocation());
+    if (expansionLocation.isInvalid())
+        return false;
+
+    return m_sourceManager->getFileID(expansionLocation) == m_mainFileID;
+}
+
+void DependencyGraphGenerator::HandleRecordDeclaration(const CXXRecordDecl* recordDecl)
 {
     SourceLocation location = recordDecl->getLocation();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterestIgnoringExclusionZone(location, sourceManager))
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestIgnoringExclusionZone(location, *m_sourceManager))
         return;
 
     if (!recordDecl->isThisDeclarationADefinition())
         return;
 
+    // bases of instantiations are the same as written in class template, which is visited itself
+    if (isTemplateInstantiation(recordDecl->getTemplateSpecializationKind()))
+        return;
+
     std::string recordType = recordDecl->getQualifiedNameAsString();
 
     LangOptions languageOptions;
@@ -57,24 +105,29 @@ void DependencyGraphGenerator::HandleRecordDeclaration(const CXXRecordDecl* reco
 }
 
 void DependencyGraphGenerator::HandleMemberCallExpression(const CXXMemberCallExpr* memberCallExpr,
-                                                          const RecordDecl* callerRecordDecl,
-                                                          SourceManager& sourceManager)
+                                                          const RecordDecl* callerRecordDecl)
 {
     SourceLocation location = memberCallExpr->getLocStart();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterestIgnoringExclusionZone(location, sourceManager))
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestIgnoringExclusionZone(location, *m_sourceManager))
         return;
 
     const CXXRecordDecl* calleeRecordDecl = memberCallExpr->getRecordDecl();
     if (calleeRecordDecl == nullptr ||
-        !m_context.sourceLocationHelper.IsLocationInProjectSourceFile(calleeRecordDecl->getLocation(), sourceManager))
+        !m_context.sourceLocationHelper.IsLocationInProjectSourceFile(calleeRecordDecl->getLocation(), *m_sourceManager))
     {
         return;
     }
 
     std::string callerRecordType = callerRecordDecl->getQualifiedNameAsString();
     std::string calleeRecordType = calleeRecordDecl->getQualifiedNameAsString();
-    if (callerRecordType != calleeRecordType)
-    {
-        m_context.outputPrinter->PrintGraphEdge(callerRecordType, calleeRecordType);
-    }
+    if (callerRecordType == calleeRecordType)
+        return;
+
+    // each written call is printed once, so that edges are weighted by number of calls in source,
+    // not multiplied by number of instantiations of templates containing them
+    auto call = std::make_tuple(location.getRawEncoding(), callerRecordType, calleeRecordType);
+    if (! m_printedCalls.insert(call).second)
+        return;
+
+    m_context.outputPrinter->PrintGraphEdge(callerRecordType, calleeRecordType);
 }
@@ -2,29 +2,48 @@
 
 #include "Generators/Generator.h"
 
-#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/AST/RecursiveASTVisitor.h>
 
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Edges from classes to their base classes and to classes whose methods they call
+// Calls are found in one traversal of declarations in main file, which keeps stack of enclosing methods,
+// instead of looking for enclosing method of each call; every call is printed, so output printer counts them
 class DependencyGraphGenerator : public Generator,
-                                 public clang::ast_matchers::MatchFinder::MatchCallback
+                                 public clang::RecursiveASTVisitor<DependencyGraphGenerator>
 {
 public:
     DependencyGraphGenerator(Context& context);
 
-    void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& finder) override;
-
-    void run(const clang::ast_matchers::MatchFinder::MatchResult& result) override;
+    bool UsesASTMatchers() const override { return false; }
+    void HandleTranslationUnit(clang::ASTContext& context) override;
 
     static const char* GetName() { return "DependencyGraph"; }
 
+    // the same nodes as AST matchers see; calls in template instantiations are needed to resolve
+    // calls on dependent types, but each written call is counted only once
+    bool shouldVisitTemplateInstantiations() const { return true; }
+    bool shouldVisitImplicitCode() const { return true; }
+
+    bool TraverseDecl(clang::Decl* declaration);
+    bool VisitCXXRecordDecl(clang::CXXRecordDecl* recordDecl);
+    bool VisitCXXMemberCallExpr(clang::CXXMemberCallExpr* memberCallExpr);
+
 private:
-    void HandleRecordDeclaration(const clang::CXXRecordDecl* recordDecl,
-                                 clang::SourceManager& sourceManager);
+    bool IsInMainFile(const clang::Decl* declaration);
 
+    void HandleRecordDeclaration(const clang::CXXRecordDecl* recordDecl);
     void HandleMemberCallExpression(const clang::CXXMemberCallExpr* memberCallExpr,
-                                    const clang::RecordDecl* callerRecordDecl,
-                                    clang::SourceManager& sourceManager);
+                                    const clang::RecordDecl* callerRecordDecl);
 
 private:
-    clang::ast_matchers::DeclarationMatcher m_recordDeclMatcher;
-    clang::ast_matchers::StatementMatcher m_memberCallExprMatcher;
+    clang::SourceManager* m_sourceManager;
+    clang::FileID m_mainFileID;
+    // classes of methods enclosing visited node, innermost last
+    std::vector<const clang::RecordDecl*> m_callerRecordDecls;
+    // calls already printed: location of call, caller and callee
+    std::set<std::tuple<unsigned, std::string, std::string>> m_printedCalls;
 };
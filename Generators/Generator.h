@@ -5,6 +5,8 @@ struct Context;
 namespace clang
 {
 
+class ASTContext;
+
 namespace ast_matchers
 {
 class MatchFinder;
@@ -25,6 +27,16 @@ public:
     virtual void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& /*finder*/)
     {}
 
+    // generators with own traversal of AST don't need matchers to traverse it again
+    virtual bool UsesASTMatchers() const
+    {
+        return true;
+    }
+
+    // called after matchers are run
+    virtual void HandleTranslationUnit(clang::ASTContext& /*context*/)
+    {}
+
 protected:
     Context& m_context;
 };
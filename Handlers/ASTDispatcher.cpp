@@ -0,0 +1,370 @@
+#include "Handlers/ASTDispatcher.h"
+
+#include "Common/Context.h"
+#include "Common/SourceLocationHelper.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Decl.h>
+#include <clang/AST/DeclCXX.h>
+#include <clang/AST/DeclTemplate.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/Basic/SourceManager.h>
+
+#include <algorithm>
+#include <cassert>
+
+using namespace clang;
+
+namespace
+{
+
+TemplateSpecializationKind GetTemplateSpecializationKind(const Decl* declaration)
+{
+    if (const auto* functionDeclaration = dyn_cast<FunctionDecl>(declaration))
+        return functionDeclaration->getTemplateSpecializationKind();
+
+    if (const auto* recordDeclaration = dyn_cast<CXXRecordDecl>(declaration))
+        return recordDeclaration->getTemplateSpecializationKind();
+
+    if (const auto* variableDeclaration = dyn_cast<VarDecl>(declaration))
+        return variableDeclaration->getTemplateSpecializationKind();
+
+    return TSK_Undeclared;
+}
+
+} // anonymous namespace
+
+ASTDispatcher::ASTDispatcher(Context& context)
+    : m_context(context)
+{}
+
+void ASTDispatcher::AddCallback(DispatchedNodeKind kind, ASTDispatcherCallback* callback)
+{
+    m_callbacks[static_cast<std::size_t>(kind)].push_back(callback);
+
+    if (std::find(m_allCallbacks.begin(), m_allCallbacks.end(), callback) == m_allCallbacks.end())
+    {
+        m_allCallbacks.push_back(callback);
+        m_translationUnitCallbacks.push_back(TranslationUnitCallback{callback, nullptr});
+    }
+}
+
+void ASTDispatcher::SetMatchFinder(ast_matchers::MatchFinder* finder)
+{
+    m_finder = finder;
+}
+
+void ASTDispatcher::AddMatchCallback(ast_matchers::MatchFinder::MatchCallback* callback)
+{
+    if (std::find(m_matchCallbacks.begin(), m_matchCallbacks.end(), callback) == m_matchCallbacks.end())
+    {
+        m_matchCallbacks.push_back(callback);
+        m_translationUnitCallbacks.push_back(TranslationUnitCallback{nullptr, callback});
+    }
+}
+
+bool ASTDispatcher::HasCallbacks() const
+{
+    return !m_allCallbacks.empty() || !m_matchCallbacks.empty();
+}
+
+const ASTDispatcher::Callbacks& ASTDispatcher::GetCallbacks(DispatchedNodeKind kind) const
+{
+    return m_callbacks[static_cast<std::size_t>(kind)];
+}
+
+void ASTDispatcher::DispatchTranslationUnit(ASTContext& context)
+{
+    m_astContext = &context;
+    m_sourceManager = &context.getSourceManager();
+    m_mainFileID = m_context.sourceLocationHelper.GetMainFileID(*m_sourceManager);
+    m_nonWrittenCodeDepth = 0;
+    m_ancestors.clear();
+
+    for (const auto& translationUnitCallback : m_translationUnitCallbacks)
+    {
+        if (translationUnitCallback.matchCallback != nullptr)
+            translationUnitCallback.matchCallback->onStartOfTranslationUnit();
+        else
+            translationUnitCallback.callback->OnStartOfTranslationUnit(context);
+    }
+
+    TraverseDecl(context.getTranslationUnitDecl());
+
+    // violations found at end of translation unit are reported in order of rules
+    for (const auto& translationUnitCallback : m_translationUnitCallbacks)
+    {
+        if (translationUnitCallback.matchCallback != nullptr)
+            translationUnitCallback.matchCallback->onEndOfTranslationUnit();
+        else
+            translationUnitCallback.callback->OnEndOfTranslationUnit();
+    }
+}
+
+bool ASTDispatcher::TraverseMainFileDeclarations(TranslationUnitDecl* translationUnit)
+{
+    // translation unit itself is matched by rules working on whole file
+    Match(*translationUnit);
+
+    m_ancestors.push_back(ast_type_traits::DynTypedNode::create(*translationUnit));
+
+    bool result = true;
+    for (auto* declaration : translationUnit->decls())
+    {
+        if (! IsInMainFile(declaration))
+            continue;
+
+        result = TraverseDecl(declaration);
+        if (! result)
+            break;
+    }
+
+    m_ancestors.pop_back();
+
+    return result;
+}
+
+const ast_type_traits::DynTypedNode* ASTDispatcher::GetParentOfCurrentNode() const
+{
+    if (m_ancestors.empty())
+        return nullptr;
+
+    return &m_ancestors.back();
+}
+
+// Instantiations of templates are traversed only from their first declaration, so if template is declared
+// in some header and defined in main file, instantiations of its definition have to be traversed from here
+bool ASTDispatcher::TraverseInstantiationsOfTemplateDeclaredOutsideMainFile(Decl* declaration)
+{
+    if (auto* functionTemplate = dyn_cast<FunctionTemplateDecl>(declaration))
+    {
+        if (! functionTemplate->getTemplatedDecl()->isThisDeclarationADefinition() ||
+            IsInMainFile(functionTemplate->getCanonicalDecl()))
+        {
+            return true;
+        }
+
+        for (auto* specialization : functionTemplate->specializations())
+        {
+            if (isTemplateInstantiation(specialization->getTemplateSpecializationKind()) &&
+                ! TraverseDecl(specialization))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // out-of-line definition of member function of class template declared in header
+    auto* method = dyn_cast<CXXMethodDecl>(declaration);
+    if (method == nullptr || ! method->isOutOfLine() || ! method->isThisDeclarationADefinition())
+        return true;
+
+    ClassTemplateDecl* classTemplate = method->getParent()->getDescribedClassTemplate();
+    if (classTemplate == nullptr || IsInMainFile(classTemplate->getCanonicalDecl()))
+        return true;
+
+    for (auto* specialization : classTemplate->specializations())
+    {
+        // explicit instantiations and specializations are traversed where they are written
+        if (specialization->getSpecializationKind() != TSK_ImplicitInstantiation)
+            continue;
+
+        for (auto* instantiatedMethod : specialization->methods())
+        {
+            CXXMethodDecl* pattern = instantiatedMethod->getInstantiatedFromMemberFunction();
+            if (pattern == nullptr || pattern->getCanonicalDecl() != method->getCanonicalDecl())
+                continue;
+
+            if (! TraverseDecl(instantiatedMethod))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool ASTDispatcher::TraverseDecl(Decl* declaration)
+{
+    if (declaration == nullptr)
+        return true;
+
+    if (auto* translationUnit = dyn_cast<TranslationUnitDecl>(declaration))
+        return TraverseMainFileDeclarations(translationUnit);
+
+    bool isWrittenCode = m_nonWrittenCodeDepth == 0 && IsWrittenDeclaration(declaration);
+    // explicit instantiation of class template is written, but not its instantiated members
+    bool areChildrenWrittenCode = isWrittenCode &&
+                                  ! isTemplateInstantiation(GetTemplateSpecializationKind(declaration));
+
+    Match(*declaration);
+    DispatchDeclaration(declaration, isWrittenCode);
+
+    if (! areChildrenWrittenCode)
+        ++m_nonWrittenCodeDepth;
+    std::size_t ancestorCount = m_ancestors.size();
+    m_ancestors.push_back(ast_type_traits::DynTypedNode::create(*declaration));
+
+    bool result = RecursiveASTVisitor<ASTDispatcher>::TraverseDecl(declaration);
+
+    m_ancestors.pop_back();
+    assert(m_ancestors.size() == ancestorCount);
+    (void)ancestorCount; // used only in assertion
+    if (! areChildrenWrittenCode)
+        --m_nonWrittenCodeDepth;
+
+    if (result && isWrittenCode)
+        result = TraverseInstantiationsOfTemplateDeclaredOutsideMainFile(declaration);
+
+    return result;
+}
+
+bool ASTDispatcher::TraverseStmt(Stmt* statement)
+{
+    if (statement == nullptr)
+        return true;
+
+    int nonWrittenCodeDepth = m_nonWrittenCodeDepth;
+    if (m_writtenRangeInitializers.count(statement) > 0)
+        m_nonWrittenCodeDepth = 0;
+
+    Match(*statement);
+    if (m_nonWrittenCodeDepth == 0)
+        DispatchStatement(statement);
+
+    const auto* rangeBasedForStatement = dyn_cast<CXXForRangeStmt>(statement);
+    bool isWrittenRangeBasedFor = rangeBasedForStatement != nullptr && m_nonWrittenCodeDepth == 0;
+    if (isWrittenRangeBasedFor)
+        m_writtenRangeInitializers.insert(rangeBasedForStatement->getRangeInit());
+
+    std::size_t ancestorCount = m_ancestors.size();
+    m_ancestors.push_back(ast_type_traits::DynTypedNode::create(*statement));
+
+    bool result = RecursiveASTVisitor<ASTDispatcher>::TraverseStmt(statement);
+
+    m_ancestors.pop_back();
+    assert(m_ancestors.size() == ancestorCount);
+    (void)ancestorCount; // used only in assertion
+
+    if (isWrittenRangeBasedFor)
+        m_writtenRangeInitializers.erase(rangeBasedForStatement->getRangeInit());
+
+    m_nonWrittenCodeDepth = nonWrittenCodeDepth;
+
+    return result;
+}
+
+bool ASTDispatcher::TraverseConstructorInitializer(CXXCtorInitializer* initializer)
+{
+    // initializers of bases and members omitted in constructor are implicit code
+    bool isWritten = initializer->isWritten();
+    if (! isWritten)
+        ++m_nonWrittenCodeDepth;
+
+    bool result = RecursiveASTVisitor<ASTDispatcher>::TraverseConstructorInitializer(initializer);
+
+    if (! isWritten)
+        --m_nonWrittenCodeDepth;
+
+    return result;
+}
+
+bool ASTDispatcher::TraverseTypeLoc(TypeLoc typeLoc)
+{
+    if (typeLoc.isNull())
+        return true;
+
+    Match(typeLoc);
+    return RecursiveASTVisitor<ASTDispatcher>::TraverseTypeLoc(typeLoc);
+}
+
+bool ASTDispatcher::IsWrittenDeclaration(Decl* declaration)
+{
+    if (declaration->isImplicit())
+        return false;
+
+    TemplateSpecializationKind specializationKind = GetTemplateSpecializationKind(declaration);
+    if (specializationKind == TSK_ImplicitInstantiation)
+        return false;
+
+    if (isTemplateInstantiation(specializationKind) && ! isa<ClassTemplateSpecializationDecl>(declaration))
+        return false;
+
+    // there's no point descending into declarations outside main file
+    return m_sourceManager->getFileID(declaration->getLocation()) == m_mainFileID;
+}
+
+bool ASTDispatcher::IsInMainFile(const Decl* declaration)
+{
+    // declarations in main file coming from macros defined in headers also count
+    SourceLocation expansionLocation = m_sourceManager->getExpansionLoc(declaration->getLocation());
+    if (expansionLocation.isInvalid())
+        return false;
+
+    return m_sourceManager->getFileID(expansionLocation) == m_mainFileID;
+}
+
+bool ASTDispatcher::IsInSystemHeader(SourceLocation location)
+{
+    SourceLocation expansionLocation = m_sourceManager->getExpansionLoc(location);
+    if (expansionLocation.isInvalid())
+        return false;
+
+    return m_sourceManager->isInSystemHeader(expansionLocation);
+}
+
+void ASTDispatcher::DispatchDeclaration(Decl* declaration, bool isWrittenCode)
+{
+    DispatchedNodeKind kind = DispatchedNodeKind::Count;
+    if (isa<FunctionDecl>(declaration))
+        kind = DispatchedNodeKind::FunctionDeclaration;
+    else if (isa<VarDecl>(declaration))
+        kind = DispatchedNodeKind::VariableDeclaration;
+    else if (isa<FieldDecl>(declaration))
+        kind = DispatchedNodeKind::FieldDeclaration;
+
+    bool hasDeclarationCallbacks = kind != DispatchedNodeKind::Count &&
+                                   ! GetCallbacks(kind).empty() &&
+                                   ! declaration->isImplicit();
+    bool hasWrittenDeclarationCallbacks = isWrittenCode &&
+                                          ! GetCallbacks(DispatchedNodeKind::WrittenDeclaration).empty();
+
+    if (! hasDeclarationCallbacks && ! hasWrittenDeclarationCallbacks)
+        return;
+
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForAnyRule(declaration->getLocation(), *m_sourceManager))
+        return;
+
+    if (hasWrittenDeclarationCallbacks)
+    {
+        for (auto* callback : GetCallbacks(DispatchedNodeKind::WrittenDeclaration))
+            callback->OnWrittenDeclaration(declaration, *m_astContext);
+    }
+
+    if (! hasDeclarationCallbacks || IsInSystemHeader(declaration->getLocStart()))
+        return;
+
+    for (auto* callback : GetCallbacks(kind))
+    {
+        if (kind == DispatchedNodeKind::FunctionDeclaration)
+            callback->OnFunctionDeclaration(cast<FunctionDecl>(declaration), *m_astContext);
+        else if (kind == DispatchedNodeKind::VariableDeclaration)
+            callback->OnVariableDeclaration(cast<VarDecl>(declaration), *m_astContext);
+        else
+            callback->OnFieldDeclaration(cast<FieldDecl>(declaration), *m_astContext);
+    }
+}
+
+void ASTDispatcher::DispatchStatement(Stmt* statement)
+{
+    const Callbacks& callbacks = GetCallbacks(DispatchedNodeKind::WrittenStatement);
+    if (callbacks.empty())
+        return;
+
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForAnyRule(statement->getLocStart(), *m_sourceManager))
+        return;
+
+    for (auto* callback : callbacks)
+        callback->OnWrittenStatement(statement, *m_astContext);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <clang/AST/RecursiveASTVisitor.h>
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+struct Context;
+
+// Kinds of AST nodes which rules can register for in AST dispatcher
+enum class DispatchedNodeKind
+{
+    // declarations as AST matchers see them, including template instantiations,
+    // but without implicit declarations and declarations in system headers
+    FunctionDeclaration,
+    VariableDeclaration, // including function parameters
+    FieldDeclaration,
+
+    // declarations and statements as they are written in main file, as RecursiveASTVisitor with
+    // default settings sees them, so without template instantiations and implicit code
+    WrittenDeclaration,
+    WrittenStatement,
+
+    Count
+};
+
+// Callbacks of rule for nodes of kinds it was registered for
+// Nodes are dispatched only when they are located in main file outside of macro expansions
+// (location of declaration or beginning of statement), so rules have to check only their exclusion zones
+// with SourceLocationHelper::IsLocationOfInterestForRule
+class ASTDispatcherCallback
+{
+public:
+    virtual ~ASTDispatcherCallback() {}
+
+    virtual void OnStartOfTranslationUnit(clang::ASTContext& /*context*/) {}
+    virtual void OnEndOfTranslationUnit() {}
+
+    virtual void OnFunctionDeclaration(const clang::FunctionDecl* /*declaration*/, clang::ASTContext& /*context*/) {}
+    virtual void OnVariableDeclaration(const clang::VarDecl* /*declaration*/, clang::ASTContext& /*context*/) {}
+    virtual void OnFieldDeclaration(const clang::FieldDecl* /*declaration*/, clang::ASTContext& /*context*/) {}
+    virtual void OnWrittenDeclaration(const clang::Decl* /*declaration*/, clang::ASTContext& /*context*/) {}
+    virtual void OnWrittenStatement(const clang::Stmt* /*statement*/, clang::ASTContext& /*context*/) {}
+};
+
+// Single traversal of AST, dispatching nodes to all rules registered for their kind
+// Rules which would otherwise match the same kinds of nodes with their own matchers or visitors
+// share one walk through AST and one check of location of each node
+// Traversal is limited to top-level declarations in main file (actual header in fake header mode),
+// and template instantiations of code defined there, so that nodes in included headers,
+// which rules would discard anyway, are not even visited
+// Violations are reported in order of traversal; for the same node, matchers are run before dispatched callbacks,
+// and callbacks at start and end of translation unit are called in order in which rules registered them
+class ASTDispatcher : public clang::RecursiveASTVisitor<ASTDispatcher>
+{
+public:
+    ASTDispatcher(Context& context);
+
+    void AddCallback(DispatchedNodeKind kind, ASTDispatcherCallback* callback);
+    // matchers of rules are run on each node visited instead of in separate traversal of whole translation unit,
+    // so their callbacks are called at start and end of translation unit from here
+    // MatchFinder of Clang 3.6 cannot traverse only part of translation unit, so each node is matched separately;
+    // only declarations, statements and type locs are matched, as rules register matchers only for them
+    void SetMatchFinder(clang::ast_matchers::MatchFinder* finder);
+    void AddMatchCallback(clang::ast_matchers::MatchFinder::MatchCallback* callback);
+    bool HasCallbacks() const;
+
+    void DispatchTranslationUnit(clang::ASTContext& context);
+
+    // Parent of node being matched or dispatched, the same as first parent from ASTContext::getParents(),
+    // which would build parent map of whole translation unit, including headers
+    // Only declarations and statements are parents, as in parent map; null for translation unit
+    const clang::ast_type_traits::DynTypedNode* GetParentOfCurrentNode() const;
+
+    // the same traversal as in MatchFinder; written code is told apart while traversing
+    bool shouldVisitTemplateInstantiations() const { return true; }
+    bool shouldVisitImplicitCode() const { return true; }
+    // all statements must go through TraverseStmt below
+    bool shouldUseDataRecursionFor(clang::Stmt* /*statement*/) const { return false; }
+
+    bool TraverseDecl(clang::Decl* declaration);
+    bool TraverseStmt(clang::Stmt* statement);
+    bool TraverseConstructorInitializer(clang::CXXCtorInitializer* initializer);
+    bool TraverseTypeLoc(clang::TypeLoc typeLoc);
+
+private:
+    using Callbacks = std::vector<ASTDispatcherCallback*>;
+
+    const Callbacks& GetCallbacks(DispatchedNodeKind kind) const;
+
+    bool TraverseMainFileDeclarations(clang::TranslationUnitDecl* translationUnit);
+    bool TraverseInstantiationsOfTemplateDeclaredOutsideMainFile(clang::Decl* declaration);
+
+    template<typename T>
+    void Match(const T& node)
+    {
+        if (m_finder != nullptr)
+            m_finder->match(node, *m_astContext);
+    }
+
+    void DispatchDeclaration(clang::Decl* declaration, bool isWrittenCode);
+    void DispatchStatement(clang::Stmt* statement);
+
+    bool IsWrittenDeclaration(clang::Decl* declaration);
+    bool IsInMainFile(const clang::Decl* declaration);
+    bool IsInSystemHeader(clang::SourceLocation location);
+
+private:
+    Context& m_context;
+    std::array<Callbacks, static_cast<std::size_t>(DispatchedNodeKind::Count)> m_callbacks;
+    Callbacks m_allCallbacks; // each callback once
+    clang::ast_matchers::MatchFinder* m_finder = nullptr;
+    std::vector<clang::ast_matchers::MatchFinder::MatchCallback*> m_matchCallbacks;
+    // callbacks at start and end of translation unit, one of pointers set, in order of registration
+    struct TranslationUnitCallback
+    {
+        ASTDispatcherCallback* callback;
+        clang::ast_matchers::MatchFinder::MatchCallback* matchCallback;
+    };
+    std::vector<TranslationUnitCallback> m_translationUnitCallbacks;
+    clang::ASTContext* m_astContext = nullptr;
+    clang::SourceManager* m_sourceManager = nullptr;
+    clang::FileID m_mainFileID;
+    // greater than zero inside implicit code, template instantiations and declarations outside main file
+    int m_nonWrittenCodeDepth = 0;
+    // declarations and statements enclosing node being visited
+    llvm::SmallVector<clang::ast_type_traits::DynTypedNode, 32> m_ancestors;
+    // range initializers of range-based for loops are written, but traversed as initializers of implicit variables
+    llvm::SmallPtrSet<const clang::Stmt*, 4> m_writtenRangeInitializers;
+};
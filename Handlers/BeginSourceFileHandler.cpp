@@ -29,6 +29,8 @@ bool BeginSourceFileHandler::BeginSourceFileAction(CompilerInstance&, StringRef
         {
             std::cerr << "Skipping " << filenameStr << " [already processed]" << std::endl;
         }
+        if (m_context.statistics != nullptr)
+            m_context.statistics->translationUnitsSkipped++;
         return false;
     }
 
@@ -37,7 +39,18 @@ bool BeginSourceFileHandler::BeginSourceFileAction(CompilerInstance&, StringRef
         std::cerr << "Processing " << filenameStr;
     }
 
-    if (IsFakeHeaderSource(filename))
+    auto headerCheckSource = m_context.headerCheckSources.find(filenameStr);
+    if (headerCheckSource != m_context.headerCheckSources.end())
+    {
+        m_context.areWeInFakeHeaderSourceFile = true;
+        m_context.actualHeaderFileSuffix = headerCheckSource->second;
+
+        if (m_context.verbose)
+        {
+            std::cerr << " [header check mode]";
+        }
+    }
+    else if (IsFakeHeaderSource(filename))
     {
         m_context.areWeInFakeHeaderSourceFile = true;
         m_context.actualHeaderFileSuffix = GetActualHeaderFileSuffix(filename);
@@ -63,7 +76,13 @@ bool BeginSourceFileHandler::BeginSourceFileAction(CompilerInstance&, StringRef
         std::cerr << std::endl;
     }
 
+    // old style functions are remembered only to avoid reporting their local variables again,
+    // so there is no point in carrying them over to other translation units
+    m_context.reportedOldStyleFunctions.clear();
+
     m_context.processedFiles.insert(filenameStr);
+    if (m_context.statistics != nullptr)
+        m_context.statistics->translationUnitsProcessed++;
     return true;
 }
 
@@ -21,8 +21,9 @@ public:
 
     bool BeginSourceFileAction(clang::CompilerInstance& ci, llvm::StringRef filename);
 
+    static bool IsFakeHeaderSource(llvm::StringRef filename);
+
 private:
-    bool IsFakeHeaderSource(llvm::StringRef filename);
     std::string GetActualHeaderFileSuffix(llvm::StringRef filename);
 
 private:
@@ -15,6 +15,23 @@ DiagnosticHandler::DiagnosticHandler(Context& context)
 {}
 
 void DiagnosticHandler::HandleDiagnostic(DiagnosticsEngine::Level level, const Diagnostic& info)
+{
+    if (level < DiagnosticsEngine::Level::Warning)
+        return;
+
+    SourceManager& sourceManager = info.getSourceManager();
+    SourceLocation location = info.getLocation();
+
+    StringRef fileName = m_context.sourceLocationHelper.GetCleanFilename(location, sourceManager);
+    int lineNumber = sourceManager.getPresumedLineNumber(location);
+
+    HandleRecordedDiagnostic(level, GetDiagnosticString(info), fileName, lineNumber);
+}
+
+void DiagnosticHandler::HandleRecordedDiagnostic(DiagnosticsEngine::Level level,
+                                                 const std::string& diagnosticString,
+                                                 StringRef fileName,
+                                                 int lineNumber)
 {
     if (level == DiagnosticsEngine::Level::Error || level == DiagnosticsEngine::Level::Fatal)
     {
@@ -23,14 +40,18 @@ void DiagnosticHandler::HandleDiagnostic(DiagnosticsEngine::Level level, const D
             ReportDiagnostic("header file not self-contained",
                              Severity::Error,
                              "Including single header file should not result in compile error: %s",
-                             info);
+                             diagnosticString,
+                             fileName,
+                             lineNumber);
         }
         else
         {
             ReportDiagnostic("compile error",
                              Severity::Error,
                              "%s",
-                             info);
+                             diagnosticString,
+                             fileName,
+                             lineNumber);
         }
     }
     else if (level == DiagnosticsEngine::Level::Warning)
@@ -38,37 +59,30 @@ void DiagnosticHandler::HandleDiagnostic(DiagnosticsEngine::Level level, const D
         ReportDiagnostic("compile warning",
                          Severity::Warning,
                          "%s",
-                         info);
+                         diagnosticString,
+                         fileName,
+                         lineNumber);
     }
 }
 
 void DiagnosticHandler::ReportDiagnostic(const char* ruleName,
                                          Severity severity,
                                          const char* descriptionTemplate,
-                                         const Diagnostic& info)
+                                         const std::string& diagnosticString,
+                                         StringRef fileName,
+                                         int lineNumber)
 {
-    std::string diagnosticString = GetDiagnosticString(info);
-
-    SourceManager& sourceManager = info.getSourceManager();
-    SourceLocation location = info.getLocation();
-
-    StringRef fileName = m_context.sourceLocationHelper.GetCleanFilename(location, sourceManager);
-    int lineNumber = sourceManager.getPresumedLineNumber(location);
-
     std::string uniqueDiagnosticString = boost::str(boost::format("%s:%d: %s")
         % fileName.str() % lineNumber % diagnosticString);
 
-    if (m_reportedDiagnostics.count(uniqueDiagnosticString) == 0)
-    {
-        m_context.outputPrinter->PrintRuleViolation(
-            ruleName,
-            severity,
-            boost::str(boost::format(descriptionTemplate) % diagnosticString),
-            location,
-            sourceManager);
-
-        m_reportedDiagnostics.insert(uniqueDiagnosticString);
-    }
+    // the same diagnostic in header file may come from many translation units, but we want to report it only once
+    m_context.outputPrinter->PrintUniqueRuleViolation(
+        uniqueDiagnosticString,
+        ruleName,
+        severity,
+        boost::str(boost::format(descriptionTemplate) % diagnosticString),
+        fileName,
+        lineNumber);
 }
 
 std::string DiagnosticHandler::GetDiagnosticString(const Diagnostic& info)
@@ -4,7 +4,7 @@
 
 #include <clang/Basic/Diagnostic.h>
 
-#include <unordered_set>
+#include <string>
 
 struct Context;
 
@@ -15,13 +15,21 @@ public:
 
     void HandleDiagnostic(clang::DiagnosticsEngine::Level level, const clang::Diagnostic& info) override;
 
+    // diagnostic that was recorded earlier, when its source was not parsed as part of current source file
+    // (e.g. header in precompiled preamble)
+    void HandleRecordedDiagnostic(clang::DiagnosticsEngine::Level level,
+                                  const std::string& diagnosticString,
+                                  llvm::StringRef fileName,
+                                  int lineNumber);
+
 private:
     void ReportDiagnostic(const char* ruleName,
                           Severity severity,
                           const char* descriptionTemplate,
-                          const clang::Diagnostic& info);
+                          const std::string& diagnosticString,
+                          llvm::StringRef fileName,
+                          int lineNumber);
     std::string GetDiagnosticString(const clang::Diagnostic& info);
 
     Context& m_context;
-    std::unordered_set<std::string> m_reportedDiagnostics;
 };
@@ -55,7 +55,13 @@ bool ExclusionZoneCommentHandler::HandleComment(Preprocessor& pp, SourceRange co
                                                  pp.getSourceManager(),
                                                  pp.getLangOpts());
 
-    int lineNumber = pp.getSourceManager().getPresumedLineNumber(location);
+    HandleCommentText(commentText, pp.getSourceManager().getPresumedLineNumber(location));
+
+    return false;
+}
+
+void ExclusionZoneCommentHandler::HandleCommentText(StringRef commentText, int lineNumber)
+{
     int lineOffset = 0;
     while (! commentText.empty())
     {
@@ -64,8 +70,6 @@ bool ExclusionZoneCommentHandler::HandleComment(Preprocessor& pp, SourceRange co
         commentText = split.second;
         ++lineOffset;
     }
-
-    return false;
 }
 
 void ExclusionZoneCommentHandler::AtBeginOfMainFile()
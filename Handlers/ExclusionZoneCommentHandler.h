@@ -24,6 +24,9 @@ public:
 
     bool HandleComment(clang::Preprocessor& pp, clang::SourceRange comment) override;
 
+    // used also in raw mode, with comments found by raw lexer
+    void HandleCommentText(llvm::StringRef commentText, int lineNumber);
+
     void AtBeginOfMainFile();
     void AtEndOfMainFile();
 
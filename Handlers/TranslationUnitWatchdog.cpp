@@ -0,0 +1,126 @@
+#include "Handlers/TranslationUnitWatchdog.h"
+
+#include "Common/Context.h"
+#include "Common/OutputPrinter.h"
+#include "Common/SourceLocationHelper.h"
+
+#include <clang/AST/ASTContext.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Lex/Preprocessor.h>
+
+#include <boost/format.hpp>
+
+#include <iostream>
+
+using namespace clang;
+
+TranslationUnitWatchdog::TranslationUnitWatchdog(Context& context)
+    : m_context(context),
+      m_compilerInstance(nullptr),
+      m_aborted(false)
+{}
+
+void TranslationUnitWatchdog::AtBeginOfSourceFile(CompilerInstance& ci)
+{
+    m_compilerInstance = &ci;
+    m_startTime = std::chrono::steady_clock::now();
+    m_aborted = false;
+}
+
+void TranslationUnitWatchdog::AtEndOfSourceFile()
+{
+    const TranslationUnitLimits& limits = m_context.translationUnitLimits;
+    if (limits.softTimeLimitSeconds <= 0.0 || m_compilerInstance == nullptr)
+        return;
+
+    double elapsedSeconds = GetElapsedSeconds();
+    if (elapsedSeconds > limits.softTimeLimitSeconds)
+    {
+        std::cerr << boost::str(boost::format("Warning: processing of %s took %.1f s, more than soft limit of %g s\n")
+            % m_compilerInstance->getFrontendOpts().Inputs[0].getFile().str()
+            % elapsedSeconds
+            % limits.softTimeLimitSeconds);
+    }
+}
+
+bool TranslationUnitWatchdog::CheckLimits()
+{
+    if (m_aborted)
+        return false;
+
+    const TranslationUnitLimits& limits = m_context.translationUnitLimits;
+
+    if (limits.timeLimitSeconds > 0.0)
+    {
+        double elapsedSeconds = GetElapsedSeconds();
+        if (elapsedSeconds > limits.timeLimitSeconds)
+        {
+            ReportAbort("lint timeout",
+                        boost::str(boost::format("Processing of source file was aborted after %.1f s, "
+                                                 "exceeding time limit of %g s")
+                            % elapsedSeconds % limits.timeLimitSeconds));
+            return false;
+        }
+    }
+
+    if (limits.memoryLimitBytes > 0)
+    {
+        std::size_t memoryUsage = GetMemoryUsage(*m_compilerInstance);
+        if (memoryUsage > limits.memoryLimitBytes)
+        {
+            ReportAbort("lint memory limit",
+                        boost::str(boost::format("Processing of source file was aborted after using %d MB of memory, "
+                                                 "exceeding limit of %d MB")
+                            % (memoryUsage / (1024 * 1024)) % (limits.memoryLimitBytes / (1024 * 1024))));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::size_t TranslationUnitWatchdog::GetMemoryUsage(CompilerInstance& ci)
+{
+    std::size_t memoryUsage = 0;
+    if (ci.hasASTContext())
+    {
+        memoryUsage += ci.getASTContext().getASTAllocatedMemory();
+        memoryUsage += ci.getASTContext().getSideTableAllocatedMemory();
+    }
+    if (ci.hasPreprocessor())
+    {
+        memoryUsage += ci.getPreprocessor().getTotalMemory();
+    }
+    if (ci.hasSourceManager())
+    {
+        auto bufferSizes = ci.getSourceManager().getMemoryBufferSizes();
+        memoryUsage += bufferSizes.malloc_bytes + bufferSizes.mmap_bytes;
+        memoryUsage += ci.getSourceManager().getDataStructureSizes();
+    }
+    return memoryUsage;
+}
+
+double TranslationUnitWatchdog::GetElapsedSeconds() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+}
+
+void TranslationUnitWatchdog::ReportAbort(const char* ruleName, const std::string& description)
+{
+    m_aborted = true;
+    m_context.translationUnitAborted = true;
+
+    // in fake header mode, header may not be included yet
+    SourceManager& sourceManager = m_compilerInstance->getSourceManager();
+    FileID mainFileID = m_context.sourceLocationHelper.GetMainFileID(sourceManager);
+    if (mainFileID.isInvalid())
+        mainFileID = sourceManager.getMainFileID();
+
+    m_context.outputPrinter->PrintRuleViolation(
+        ruleName,
+        Severity::Error,
+        description,
+        m_context.sourceLocationHelper.GetCleanFilename(mainFileID, sourceManager),
+        1);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+struct Context;
+
+namespace clang
+{
+class CompilerInstance;
+}
+
+// Checks time and memory used for processing of source file against limits given in context
+// Processing cannot be interrupted at any time, so limits are checked at points where it can be stopped cleanly,
+// that is after each top-level declaration, and before AST matchers are run
+class TranslationUnitWatchdog
+{
+public:
+    TranslationUnitWatchdog(Context& context);
+
+    void AtBeginOfSourceFile(clang::CompilerInstance& ci);
+    void AtEndOfSourceFile();
+
+    // returns false if processing should be stopped; violation is reported the first time
+    bool CheckLimits();
+
+    // peak memory used by Clang for source file is the current memory, as AST and buffers only grow
+    static std::size_t GetMemoryUsage(clang::CompilerInstance& ci);
+
+private:
+    double GetElapsedSeconds() const;
+    void ReportAbort(const char* ruleName, const std::string& description);
+
+private:
+    Context& m_context;
+    clang::CompilerInstance* m_compilerInstance;
+    std::chrono::steady_clock::time_point m_startTime;
+    bool m_aborted;
+};
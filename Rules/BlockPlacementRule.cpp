@@ -3,61 +3,42 @@
 #include "Common/Context.h"
 #include "Common/OutputPrinter.h"
 #include "Common/SourceLocationHelper.h"
-#include "Common/TranslationUnitMatcher.h"
 
 #include <clang/AST/ASTContext.h>
-#include <clang/ASTMatchers/ASTMatchers.h>
 #include <clang/AST/Decl.h>
 #include <clang/AST/Stmt.h>
 
 #include <boost/format.hpp>
 
 using namespace clang;
-using namespace clang::ast_matchers;
 using namespace llvm;
 
 BlockPlacementRule::BlockPlacementRule(Context& context)
     : Rule(context)
 {}
 
-void BlockPlacementRule::RegisterASTMatcherCallback(ast_matchers::MatchFinder& finder)
+void BlockPlacementRule::RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher)
 {
-    finder.addMatcher(customTranslationUnitDecl().bind("translationUnit"), this);
+    // dispatcher skips declarations outside main file, like it skips template instantiations and implicit code
+    dispatcher.AddCallback(DispatchedNodeKind::WrittenDeclaration, GetDispatcherCallback(this));
+    dispatcher.AddCallback(DispatchedNodeKind::WrittenStatement, GetDispatcherCallback(this));
 }
 
-void BlockPlacementRule::run(const ast_matchers::MatchFinder::MatchResult& result)
+void BlockPlacementRule::OnStartOfTranslationUnit(ASTContext& context)
 {
-    const TranslationUnitDecl* translationUnitDeclaration = result.Nodes.getNodeAs<TranslationUnitDecl>("translationUnit");
-    if (translationUnitDeclaration == nullptr)
-        return;
-
     m_forbiddenLineNumbers.clear();
     m_reportedLineNumbers.clear();
 
-    m_astContext = result.Context;
-    m_mainFileID = m_context.sourceLocationHelper.GetMainFileID(m_astContext->getSourceManager());
-    TraverseDecl(const_cast<TranslationUnitDecl*>(translationUnitDeclaration));
+    m_astContext = &context;
 }
 
-bool BlockPlacementRule::TraverseDecl(Decl* declaration)
-{
-    if (declaration != nullptr && !isa<TranslationUnitDecl>(declaration))
-    {
-        SourceManager& sourceManager = m_astContext->getSourceManager();
-        if (sourceManager.getFileID(declaration->getLocation()) != m_mainFileID)
-            return true; // there's no point descending into declarations outside main file
-    }
-
-    return RecursiveASTVisitor<BlockPlacementRule>::TraverseDecl(declaration);
-}
-
-bool BlockPlacementRule::VisitDecl(Decl* declaration)
+void BlockPlacementRule::OnWrittenDeclaration(const Decl* declaration, ASTContext& /*context*/)
 {
     SourceManager& sourceManager = m_astContext->getSourceManager();
 
     SourceLocation location = declaration->getLocation();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, sourceManager))
-        return true; // recurse further
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForRule(GetName(), location, sourceManager))
+        return;
 
     int declarationStartLineNumber = sourceManager.getPresumedLineNumber(declaration->getLocStart());
     int declarationEndLineNumber = sourceManager.getPresumedLineNumber(declaration->getLocEnd());
@@ -66,18 +47,18 @@ bool BlockPlacementRule::VisitDecl(Decl* declaration)
         m_forbiddenLineNumbers.count(declarationEndLineNumber) > 0)
     {
         ReportViolation(declaration->getLocStart(), ViolationType::ClosingBrace /* of previous stmt or decl */);
-        return true; // recurse further
+        return;
     }
 
     if (! TagDecl::classof(declaration) &&     // class, struct, enum, union, etc.
         ! NamespaceDecl::classof(declaration)) // namespace
     {
-        return true; // recurse further
+        return;
     }
 
     // one-liners are allowed
     if (declarationStartLineNumber == declarationEndLineNumber)
-        return true; // recurse further
+        return;
 
     if (! IsDeclarationOpeningBracePlacedCorrectly(declaration->getLocStart(), declaration->getLocEnd()))
         ReportViolation(declaration->getLocStart(), ViolationType::OpeningBrace);
@@ -93,17 +74,15 @@ bool BlockPlacementRule::VisitDecl(Decl* declaration)
     if (recordDeclaration != nullptr && recordDeclaration->getName().empty()) {}
     else
         m_forbiddenLineNumbers.insert(declarationEndLineNumber);
-
-    return true; // recurse further
 }
 
-bool BlockPlacementRule::VisitStmt(Stmt* statement)
+void BlockPlacementRule::OnWrittenStatement(const Stmt* statement, ASTContext& /*context*/)
 {
     SourceManager& sourceManager = m_astContext->getSourceManager();
 
     SourceLocation location = statement->getLocStart();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, sourceManager))
-        return true; // recurse further
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForRule(GetName(), location, sourceManager))
+        return;
 
     int startLineNumber = sourceManager.getPresumedLineNumber(statement->getLocStart());
     int endLineNumber = sourceManager.getPresumedLineNumber(statement->getLocEnd());
@@ -112,18 +91,18 @@ bool BlockPlacementRule::VisitStmt(Stmt* statement)
         m_forbiddenLineNumbers.count(endLineNumber) > 0)
     {
         ReportViolation(statement->getLocStart(), ViolationType::ClosingBrace /* of previous stmt or decl */);
-        return true; // recurse further
+        return;
     }
 
     // one-liners are allowed
     if (startLineNumber == endLineNumber)
-        return true; // recurse further
+        return;
 
     // compound statement is name for a group of brace-enclosed statement(s)
     //  for example: if (x) { foo(); }
     const CompoundStmt* compountStatment = dyn_cast_or_null<CompoundStmt>(statement);
     if (compountStatment == nullptr)
-        return true; // recurse further
+        return;
 
     if (! IsStatementOpeningBracePlacedCorrectly(compountStatment->getLBracLoc()))
         ReportViolation(statement->getLocStart(), ViolationType::OpeningBrace);
@@ -135,8 +114,6 @@ bool BlockPlacementRule::VisitStmt(Stmt* statement)
     }
 
     m_forbiddenLineNumbers.insert(endLineNumber);
-
-    return true;
 }
 
 bool BlockPlacementRule::IsDeclarationOpeningBracePlacedCorrectly(const SourceLocation& locStart,
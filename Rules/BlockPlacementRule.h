@@ -2,25 +2,21 @@
 
 #include "Rules/Rule.h"
 
-#include <clang/ASTMatchers/ASTMatchFinder.h>
-#include <clang/AST/RecursiveASTVisitor.h>
+#include "Handlers/ASTDispatcher.h"
 
 #include <llvm/ADT/DenseSet.h>
 
 class BlockPlacementRule : public Rule,
-                           public clang::ast_matchers::MatchFinder::MatchCallback,
-                           public clang::RecursiveASTVisitor<BlockPlacementRule>
+                           public ASTDispatcherCallback
 {
 public:
     BlockPlacementRule(Context& context);
 
-    void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& finder) override;
-    void run(const clang::ast_matchers::MatchFinder::MatchResult& result) override;
+    void RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher) override;
 
-    bool TraverseDecl(clang::Decl* declaration);
-
-    bool VisitDecl(clang::Decl* declaration);
-    bool VisitStmt(clang::Stmt* statement);
+    void OnStartOfTranslationUnit(clang::ASTContext& context) override;
+    void OnWrittenDeclaration(const clang::Decl* declaration, clang::ASTContext& context) override;
+    void OnWrittenStatement(const clang::Stmt* statement, clang::ASTContext& context) override;
 
     static const char* GetName() { return "BlockPlacementRule"; }
 
@@ -40,7 +36,6 @@ private:
     void ReportViolation(const clang::SourceLocation& location, ViolationType type);
 
     clang::ASTContext* m_astContext = nullptr;
-    clang::FileID m_mainFileID;
     // forbidden lines are where we know we have closing braces
     // of previously visited statements or declarations
     llvm::DenseSet<int> m_forbiddenLineNumbers;
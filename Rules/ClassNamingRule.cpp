@@ -38,7 +38,7 @@ void ClassNamingRule::RegisterASTMatcherCallback(MatchFinder& finder)
                                 isLambda())),
                    isDefinition())
             .bind("recordDecl"),
-        this);
+        GetMatchCallback(this));
 }
 
 void ClassNamingRule::run(const MatchFinder::MatchResult& result)
@@ -74,7 +74,7 @@ void ClassNamingRule::run(const MatchFinder::MatchResult& result)
 
     if (recordDeclaration->isClass())
     {
-        if (! boost::regex_match(name.begin(), name.end(), m_classNamePattern))
+        if (! MatchNamePattern(name, m_classNamePattern, m_statistics))
         {
             m_context.outputPrinter->PrintRuleViolation(
                 "class naming",
@@ -89,7 +89,7 @@ void ClassNamingRule::run(const MatchFinder::MatchResult& result)
     else if (recordDeclaration->isStruct() ||
              recordDeclaration->isUnion())
     {
-        if (! boost::regex_match(name.begin(), name.end(), m_structOrUnionNamePattern))
+        if (! MatchNamePattern(name, m_structOrUnionNamePattern, m_statistics))
         {
             m_context.outputPrinter->PrintRuleViolation(
                 "class naming",
@@ -100,7 +100,7 @@ void ClassNamingRule::run(const MatchFinder::MatchResult& result)
                 location,
                 sourceManager);
         }
-        else if (boost::regex_match(name.begin(), name.end(), m_classNamePattern))
+        else if (MatchNamePattern(name, m_classNamePattern, m_statistics))
         {
             m_context.outputPrinter->PrintRuleViolation(
                 "class naming",
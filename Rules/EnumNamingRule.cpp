@@ -37,14 +37,14 @@ void EnumNamingRule::RegisterASTMatcherCallback(MatchFinder& finder)
                               isImplicit())),
                  isDefinition())
             .bind("enumDecl"),
-        this);
+        GetMatchCallback(this));
 
     finder.addMatcher(
         enumConstantDecl(unless(anyOf(isExpansionInSystemHeader(),
                                       isImplicit())),
                          hasDeclContext(enumDecl(isScopedUsingClassTag()).bind("enumDecl")))
             .bind("enumConstantDecl"),
-        this);
+        GetMatchCallback(this));
 }
 
 void EnumNamingRule::run(const MatchFinder::MatchResult& result)
@@ -89,7 +89,7 @@ void EnumNamingRule::HandleEnumDeclaration(const EnumDecl* enumDeclaration, ASTC
         return;
     }
 
-    if (! boost::regex_match(name.begin(), name.end(), m_enumNamePattern))
+    if (! MatchNamePattern(name, m_enumNamePattern, m_statistics))
     {
         m_context.outputPrinter->PrintRuleViolation(
             "enum naming",
@@ -111,7 +111,7 @@ void EnumNamingRule::HandleEnumConstantDeclaration(const EnumConstantDecl* enumC
         return;
 
     StringRef name = enumConstantDeclaration->getName();
-    if (! boost::regex_match(name.begin(), name.end(), m_enumConstantPattern))
+    if (! MatchNamePattern(name, m_enumConstantPattern, m_statistics))
     {
         m_context.outputPrinter->PrintRuleViolation(
             "enum naming",
@@ -5,96 +5,71 @@
 #include "Common/RegexHelper.h"
 #include "Common/SourceLocationHelper.h"
 
-#include <clang/AST/Decl.h>
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/DeclCXX.h>
 
 #include <boost/format.hpp>
 
 using namespace clang;
-using namespace clang::ast_matchers;
 
-namespace clang
-{
-namespace ast_matchers
-{
+FunctionNamingRule::FunctionNamingRule(Context& context)
+    : Rule(context),
+      m_functionOrMethodNamePattern(UPPER_CAMEL_CASE_PATTERN)
+{}
 
-AST_MATCHER(FunctionDecl, isMethod)
+void FunctionNamingRule::RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher)
 {
-    return CXXMethodDecl::classof(&Node);
+    dispatcher.AddCallback(DispatchedNodeKind::FunctionDeclaration, GetDispatcherCallback(this));
 }
 
-AST_MATCHER(CXXMethodDecl, isConstructor)
+void FunctionNamingRule::OnFunctionDeclaration(const FunctionDecl* functionDeclaration, ASTContext& context)
 {
-    return CXXConstructorDecl::classof(&Node);
-}
+    SourceManager& sourceManager = context.getSourceManager();
 
-AST_MATCHER(FunctionDecl, isOverloadedOperator)
-{
-    return Node.isOverloadedOperator();
+    const auto* methodDeclaration = dyn_cast<CXXMethodDecl>(functionDeclaration);
+    if (methodDeclaration != nullptr)
+    {
+        if (IsMethodToCheck(methodDeclaration))
+            HandleDeclaration("Method", methodDeclaration, sourceManager);
+    }
+    else
+    {
+        if (IsFunctionToCheck(functionDeclaration))
+            HandleDeclaration("Function", functionDeclaration, sourceManager);
+    }
 }
 
-AST_MATCHER(CXXMethodDecl, hasNonSimpleIdentifierName)
+bool FunctionNamingRule::IsMethodToCheck(const CXXMethodDecl* methodDeclaration)
 {
+    if (isa<CXXConstructorDecl>(methodDeclaration) || methodDeclaration->isOverloadedOperator())
+        return false;
+
     // functions with names that are not simple identifiers are for example
     // destructors and conversion operators
     // besides the fact that we should ignore such functions anyway
     // we have to check against this to avoid hitting runtime assert inside getName()
-    return !Node.getDeclName().isIdentifier();
-}
+    if (! methodDeclaration->getDeclName().isIdentifier())
+        return false;
 
-AST_MATCHER(CXXMethodDecl, isOverriddenVirtualMethod)
-{
     // overridden virtual methods in derived classes are not interesting to us
     // we should report violations only once in base class
-    return Node.isVirtual() && Node.size_overridden_methods() > 0;
-}
+    if (methodDeclaration->isVirtual() && methodDeclaration->size_overridden_methods() > 0)
+        return false;
 
-AST_MATCHER(CXXMethodDecl, isIteratorAccessMethod)
-{
     // iterator access functions for range-based for loop are allowed
-    auto name = Node.getName();
-    return name == "begin" || name == "end";
-}
-
-} // namespace ast_matchers
-} // namespace clang
-
-FunctionNamingRule::FunctionNamingRule(Context& context)
-    : Rule(context),
-      m_functionOrMethodNamePattern(UPPER_CAMEL_CASE_PATTERN)
-{}
-
-void FunctionNamingRule::RegisterASTMatcherCallback(MatchFinder& finder)
-{
-    finder.addMatcher(methodDecl(unless(anyOf(isExpansionInSystemHeader(),
-                                              isImplicit(),
-                                              isConstructor(),
-                                              isOverloadedOperator(),
-                                              hasNonSimpleIdentifierName(),
-                                              isOverriddenVirtualMethod(),
-                                              isIteratorAccessMethod())))
-                          .bind("methodDecl"),
-                      this);
-
-    finder.addMatcher(functionDecl(unless(anyOf(isExpansionInSystemHeader(),
-                                                isImplicit(),
-                                                isOverloadedOperator(),
-                                                isMethod(),
-                                                hasName("::main"))))
-                          .bind("functionDecl"),
-                      this);
+    auto name = methodDeclaration->getName();
+    return name != "begin" && name != "end";
 }
 
-void FunctionNamingRule::run(const MatchFinder::MatchResult& result)
+bool FunctionNamingRule::IsFunctionToCheck(const FunctionDecl* functionDeclaration)
 {
-    SourceManager& sourceManager = result.Context->getSourceManager();
-
-    const auto* methodDeclaration = result.Nodes.getNodeAs<CXXMethodDecl>("methodDecl");
-    if (methodDeclaration != nullptr)
-        return HandleDeclaration("Method", methodDeclaration, sourceManager);
+    if (functionDeclaration->isOverloadedOperator())
+        return false;
 
-    const auto* functionDeclaration = result.Nodes.getNodeAs<FunctionDecl>("functionDecl");
-    if (functionDeclaration != nullptr)
-        return HandleDeclaration("Function", functionDeclaration, sourceManager);
+    // global main() has its name by necessity
+    return ! (functionDeclaration->getDeclContext()->getRedeclContext()->isTranslationUnit() &&
+              functionDeclaration->getDeclName().isIdentifier() &&
+              functionDeclaration->getName() == "main");
 }
 
 void FunctionNamingRule::HandleDeclaration(const char* type,
@@ -102,7 +77,7 @@ void FunctionNamingRule::HandleDeclaration(const char* type,
                                            SourceManager& sourceManager)
 {
     SourceLocation location = declaration->getLocation();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, sourceManager))
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForRule(GetName(), location, sourceManager))
         return;
 
     const FunctionDecl* canonicalDeclaration = declaration->getCanonicalDecl();
@@ -112,7 +87,7 @@ void FunctionNamingRule::HandleDeclaration(const char* type,
     m_visitedDeclarations.insert(canonicalDeclaration);
 
     auto name = declaration->getName();
-    if (! boost::regex_match(name.begin(), name.end(), m_functionOrMethodNamePattern))
+    if (! MatchNamePattern(name, m_functionOrMethodNamePattern, m_statistics))
     {
         m_context.outputPrinter->PrintRuleViolation(
                 "function naming",
@@ -2,25 +2,28 @@
 
 #include "Rules/Rule.h"
 
-#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include "Handlers/ASTDispatcher.h"
 
 #include <llvm/ADT/DenseSet.h>
 
 #include <boost/regex.hpp>
 
 class FunctionNamingRule : public Rule,
-                           public clang::ast_matchers::MatchFinder::MatchCallback
+                           public ASTDispatcherCallback
 {
 public:
     FunctionNamingRule(Context& context);
 
-    void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& finder) override;
+    void RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher) override;
 
-    void run(const clang::ast_matchers::MatchFinder::MatchResult& result) override;
+    void OnFunctionDeclaration(const clang::FunctionDecl* functionDeclaration, clang::ASTContext& context) override;
 
     static const char* GetName() { return "FunctionNamingRule"; }
 
 private:
+    static bool IsMethodToCheck(const clang::CXXMethodDecl* methodDeclaration);
+    static bool IsFunctionToCheck(const clang::FunctionDecl* functionDeclaration);
+
     void HandleDeclaration(const char* type,
                            const clang::FunctionDecl* declaration,
                            clang::SourceManager& sourceManager);
@@ -4,6 +4,8 @@
 #include "Common/OutputPrinter.h"
 #include "Common/SourceLocationHelper.h"
 
+#include "Handlers/ASTDispatcher.h"
+
 #include <clang/Tooling/Tooling.h>
 #include <clang/ASTMatchers/ASTMatchers.h>
 #include <clang/AST/Expr.h>
@@ -14,12 +16,19 @@ using namespace clang;
 using namespace clang::ast_matchers;
 
 ImplicitBoolCastRule::ImplicitBoolCastRule(Context& context)
-    : Rule(context)
+    : Rule(context),
+      m_dispatcher(nullptr)
 {}
 
 void ImplicitBoolCastRule::RegisterASTMatcherCallback(MatchFinder& finder)
 {
-    finder.addMatcher(implicitCastExpr(unless(isExpansionInSystemHeader())).bind("implicitCastExpr"), this);
+    finder.addMatcher(implicitCastExpr(unless(isExpansionInSystemHeader())).bind("implicitCastExpr"), GetMatchCallback(this));
+}
+
+void ImplicitBoolCastRule::RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher)
+{
+    // matchers are run from traversal of AST dispatcher, which knows parents of matched nodes
+    m_dispatcher = &dispatcher;
 }
 
 void ImplicitBoolCastRule::run(const MatchFinder::MatchResult& result)
@@ -45,7 +54,7 @@ void ImplicitBoolCastRule::run(const MatchFinder::MatchResult& result)
             location,
             sourceManager);
     }
-    else if (IsImplicitCastFromBool(implicitCastExpr, result.Context))
+    else if (IsImplicitCastFromBool(implicitCastExpr))
     {
         std::string castTypeStr = implicitCastExpr->getType().getAsString();
 
@@ -69,7 +78,6 @@ bool ImplicitBoolCastRule::IsImplicitCastToBool(const ImplicitCastExpr* implicit
 }
 
 bool ImplicitBoolCastRule::IsImplicitCastFromBool(const ImplicitCastExpr* implicitCastExpr,
-                                                  ASTContext* astContext,
                                                   bool checkBoolComparison)
 {
     if (implicitCastExpr == nullptr)
@@ -88,7 +96,7 @@ bool ImplicitBoolCastRule::IsImplicitCastFromBool(const ImplicitCastExpr* implic
     // comparison of bools with == and != operators is allowed
     if (checkBoolComparison &&
         kind == CK_IntegralCast &&
-        IsComparisonOfBools(implicitCastExpr, astContext))
+        IsComparisonOfBools())
     {
         return false;
     }
@@ -101,13 +109,14 @@ bool ImplicitBoolCastRule::IsImplicitCastFromBool(const ImplicitCastExpr* implic
            subExpr->getType().getAsString() == "_Bool";
 }
 
-bool ImplicitBoolCastRule::IsComparisonOfBools(const ImplicitCastExpr* implicitCastExpr, ASTContext* astContext)
+// Checks parent of implicit cast being matched
+bool ImplicitBoolCastRule::IsComparisonOfBools()
 {
-    auto parents = astContext->getParents(*implicitCastExpr);
-    if (parents.size() == 0)
+    const ast_type_traits::DynTypedNode* parent = m_dispatcher->GetParentOfCurrentNode();
+    if (parent == nullptr)
         return false;
 
-    const BinaryOperator* binaryOperator = dyn_cast_or_null<const BinaryOperator>(parents.front().get<Stmt>());
+    const BinaryOperator* binaryOperator = dyn_cast_or_null<const BinaryOperator>(parent->get<Stmt>());
     if (binaryOperator == nullptr)
         return false;
 
@@ -120,6 +129,6 @@ bool ImplicitBoolCastRule::IsComparisonOfBools(const ImplicitCastExpr* implicitC
 
     const ImplicitCastExpr* lhsImplicitCast = dyn_cast_or_null<const ImplicitCastExpr>(binaryOperator->getLHS());
     const ImplicitCastExpr* rhsImplicitCast = dyn_cast_or_null<const ImplicitCastExpr>(binaryOperator->getRHS());
-    return IsImplicitCastFromBool(lhsImplicitCast, astContext, false) &&
-           IsImplicitCastFromBool(rhsImplicitCast, astContext, false);
+    return IsImplicitCastFromBool(lhsImplicitCast, false) &&
+           IsImplicitCastFromBool(rhsImplicitCast, false);
 }
@@ -11,6 +11,7 @@ public:
     ImplicitBoolCastRule(Context& context);
 
     void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& finder) override;
+    void RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher) override;
 
     void run(const clang::ast_matchers::MatchFinder::MatchResult& result) override;
 
@@ -19,7 +20,9 @@ public:
 private:
     bool IsImplicitCastToBool(const clang::ImplicitCastExpr* implicitCastExpr);
     bool IsImplicitCastFromBool(const clang::ImplicitCastExpr* implicitCastExpr,
-                                clang::ASTContext* astContext,
                                 bool checkBoolComparison = true);
-    bool IsComparisonOfBools(const clang::ImplicitCastExpr* implicitCastExpr, clang::ASTContext* astContext);
+    bool IsComparisonOfBools();
+
+private:
+    ASTDispatcher* m_dispatcher;
 };
@@ -2,6 +2,7 @@
 
 #include "Common/Context.h"
 #include "Common/OutputPrinter.h"
+#include "Common/RuleProfiler.h"
 #include "Common/SourceLocationHelper.h"
 
 #include <clang/Frontend/CompilerInstance.h>
@@ -19,10 +20,14 @@ using namespace llvm;
 class IncludeOrderPPCallbacks : public PPCallbacks
 {
 public:
-    IncludeOrderPPCallbacks(IncludeStyleRule& rule, Context& context, SourceManager& sourceManager)
+    IncludeOrderPPCallbacks(IncludeStyleRule& rule,
+                            Context& context,
+                            SourceManager& sourceManager,
+                            RuleProfileCounter* profileCounter)
         : m_rule(rule),
           m_context(context),
-          m_sourceManager(sourceManager)
+          m_sourceManager(sourceManager),
+          m_profileCounter(profileCounter)
     {}
 
     void InclusionDirective(SourceLocation hashLoc,
@@ -35,6 +40,8 @@ public:
                             StringRef /*relativePath*/,
                             const Module* /*imported*/) override
     {
+        RuleProfileTimer timer(m_profileCounter);
+
         if (file != nullptr &&
             m_context.sourceLocationHelper.IsLocationOfInterest(IncludeStyleRule::GetName(), hashLoc, m_sourceManager))
         {
@@ -45,6 +52,7 @@ public:
 
     void EndOfMainFile() override
     {
+        RuleProfileTimer timer(m_profileCounter);
         m_rule.AtEndOfMainFile(m_includeDirectives, m_sourceManager);
     }
 
@@ -52,6 +60,7 @@ private:
     IncludeStyleRule& m_rule;
     Context& m_context;
     SourceManager& m_sourceManager;
+    RuleProfileCounter* m_profileCounter;
     std::vector<IncludeDirective> m_includeDirectives;
 };
 
@@ -64,13 +73,20 @@ IncludeStyleRule::IncludeStyleRule(Context& context)
 void IncludeStyleRule::RegisterPreProcessorCallbacks(CompilerInstance& compiler)
 {
     compiler.getPreprocessor().addPPCallbacks(
-        make_unique<IncludeOrderPPCallbacks>(*this, m_context, compiler.getSourceManager()));
+        make_unique<IncludeOrderPPCallbacks>(*this, m_context, compiler.getSourceManager(),
+                                             GetPreprocessorCallbacksCounter()));
 }
 
 void IncludeStyleRule::RegisterASTMatcherCallback(MatchFinder& finder)
 {
     if (m_context.areWeInFakeHeaderSourceFile)
-        finder.addMatcher(recordDecl().bind("recordDecl"), this);
+        finder.addMatcher(recordDecl().bind("recordDecl"), GetMatchCallback(this));
+}
+
+RuleRequirement IncludeStyleRule::GetRequirement() const
+{
+    // in fake header mode, base class of main class is also checked
+    return m_context.areWeInFakeHeaderSourceFile ? RuleRequirement::AST : RuleRequirement::Preprocessor;
 }
 
 void IncludeStyleRule::run(const MatchFinder::MatchResult& result)
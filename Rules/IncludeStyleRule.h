@@ -40,6 +40,8 @@ public:
 
     void run(const clang::ast_matchers::MatchFinder::MatchResult& result) override;
 
+    RuleRequirement GetRequirement() const override;
+
     void AtEndOfMainFile(const IncludeDirectives& includeDirectives,
                          clang::SourceManager& sourceManager);
 
@@ -4,37 +4,30 @@
 #include "Common/OutputPrinter.h"
 #include "Common/SourceLocationHelper.h"
 
+#include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
 
 #include <boost/format.hpp>
 
 using namespace clang;
-using namespace clang::ast_matchers;
 
 
 InconsistentDeclarationParameterNameRule::InconsistentDeclarationParameterNameRule(Context& context)
     : Rule(context)
 {}
 
-void InconsistentDeclarationParameterNameRule::RegisterASTMatcherCallback(MatchFinder& finder)
+void InconsistentDeclarationParameterNameRule::RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher)
 {
-    finder.addMatcher(
-        functionDecl(unless(anyOf(isExpansionInSystemHeader(),
-                                  isImplicit())))
-            .bind("functionDecl"),
-        this);
+    dispatcher.AddCallback(DispatchedNodeKind::FunctionDeclaration, GetDispatcherCallback(this));
 }
 
-void InconsistentDeclarationParameterNameRule::run(const MatchFinder::MatchResult& result)
+void InconsistentDeclarationParameterNameRule::OnFunctionDeclaration(const FunctionDecl* functionDeclaration,
+                                                                     ASTContext& context)
 {
-    const FunctionDecl* functionDeclaration = result.Nodes.getNodeAs<FunctionDecl>("functionDecl");
-    if (functionDeclaration == nullptr)
-        return;
-
-    SourceManager& sourceManager = result.Context->getSourceManager();
+    SourceManager& sourceManager = context.getSourceManager();
 
     SourceLocation location = functionDeclaration->getLocation();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, sourceManager))
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForRule(GetName(), location, sourceManager))
         return;
 
     const FunctionDecl* canonicalFunctionDeclaration = functionDeclaration->getCanonicalDecl();
@@ -2,19 +2,19 @@
 
 #include "Rules/Rule.h"
 
-#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include "Handlers/ASTDispatcher.h"
 
 #include <llvm/ADT/DenseSet.h>
 
 class InconsistentDeclarationParameterNameRule : public Rule,
-                                                 public clang::ast_matchers::MatchFinder::MatchCallback
+                                                 public ASTDispatcherCallback
 {
 public:
     InconsistentDeclarationParameterNameRule(Context& context);
 
-    void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& finder) override;
+    void RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher) override;
 
-    void run(const clang::ast_matchers::MatchFinder::MatchResult& result) override;
+    void OnFunctionDeclaration(const clang::FunctionDecl* functionDeclaration, clang::ASTContext& context) override;
 
     static const char* GetName() { return "InconsistentDeclarationParameterNameRule"; }
 
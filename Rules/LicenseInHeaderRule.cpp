@@ -3,6 +3,7 @@
 #include "Common/Context.h"
 #include "Common/OutputPrinter.h"
 #include "Common/SourceLocationHelper.h"
+#include "Common/TextScanner.h"
 #include "Common/TranslationUnitMatcher.h"
 
 #include <clang/AST/ASTContext.h>
@@ -20,7 +21,7 @@ LicenseInHeaderRule::LicenseInHeaderRule(Context& context)
 
 void LicenseInHeaderRule::RegisterASTMatcherCallback(ast_matchers::MatchFinder& finder)
 {
-    finder.addMatcher(customTranslationUnitDecl().bind("translationUnitDecl"), this);
+    finder.addMatcher(customTranslationUnitDecl().bind("translationUnitDecl"), GetMatchCallback(this));
 }
 
 void LicenseInHeaderRule::run(const ast_matchers::MatchFinder::MatchResult& result)
@@ -36,24 +37,30 @@ void LicenseInHeaderRule::run(const ast_matchers::MatchFinder::MatchResult& resu
 
     FileID mainFileID = m_context.sourceLocationHelper.GetMainFileID(sourceManager);
 
-    MemoryBuffer* buffer = sourceManager.getBuffer(mainFileID);
-    const char* bufferChars = buffer->getBufferStart();
-    int bufferSize = buffer->getBufferSize();
-    if (bufferSize == 0)
+    StringRef fileName = m_context.sourceLocationHelper.GetCleanFilename(mainFileID, sourceManager);
+
+    CheckFileText(fileName, sourceManager.getBuffer(mainFileID)->getBuffer());
+}
+
+void LicenseInHeaderRule::CheckFileText(StringRef fileName, StringRef text)
+{
+    if (m_context.licenseTemplateLines.empty())
         return;
 
-    int bufferPos = 0;
+    if (text.empty())
+        return;
+
+    std::vector<TextLine> lines = ScanTextLines(text, m_context.licenseTemplateLines.size());
+
     int lineNumber = 0;
     for (const auto& licenseLine : m_context.licenseTemplateLines)
     {
+        StringRef line = (lineNumber < static_cast<int>(lines.size()))
+            ? text.substr(lines[lineNumber].offset, lines[lineNumber].length)
+            : StringRef();
         ++lineNumber;
-        StringRef line = GetNextBufferLine(bufferChars, bufferPos, bufferSize);
-        bufferPos += line.size();
-        bufferPos += 1; // newline character
         if (line != licenseLine)
         {
-            StringRef fileName = m_context.sourceLocationHelper.GetCleanFilename(mainFileID, sourceManager);
-
             m_context.outputPrinter->PrintRuleViolation(
                 "license header",
                 Severity::Style,
@@ -66,21 +73,3 @@ void LicenseInHeaderRule::run(const ast_matchers::MatchFinder::MatchResult& resu
         }
     }
 }
-
-StringRef LicenseInHeaderRule::GetNextBufferLine(const char* bufferChars, int currentPos, int bufferSize)
-{
-    if (currentPos >= bufferSize)
-        return StringRef();
-
-    int endLinePos = currentPos;
-    for (; endLinePos < bufferSize; ++endLinePos)
-    {
-        if (bufferChars[endLinePos] == '\n')
-            break;
-    }
-
-    if (endLinePos == currentPos)
-        return StringRef();
-
-    return StringRef(&bufferChars[currentPos], endLinePos - currentPos);
-}
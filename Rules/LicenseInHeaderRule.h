@@ -14,8 +14,10 @@ public:
 
     void run(const clang::ast_matchers::MatchFinder::MatchResult& Result) override;
 
-    static const char* GetName() { return "LicenseInHeaderRule"; }
+    RuleRequirement GetRequirement() const override { return RuleRequirement::RawText; }
+
+    // also used directly in raw mode, without Clang
+    void CheckFileText(llvm::StringRef fileName, llvm::StringRef text);
 
-private:
-    llvm::StringRef GetNextBufferLine(const char* bufferChars, int currentPos, int bufferSize);
+    static const char* GetName() { return "LicenseInHeaderRule"; }
 };
@@ -15,7 +15,6 @@
 
 using namespace llvm;
 using namespace clang;
-using namespace clang::ast_matchers;
 
 namespace
 {
@@ -83,32 +82,24 @@ OldStyleFunctionRule::OldStyleFunctionRule(Context& context)
     : Rule(context)
 {}
 
-void OldStyleFunctionRule::RegisterASTMatcherCallback(MatchFinder& finder)
+void OldStyleFunctionRule::RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher)
 {
-    finder.addMatcher(
-        functionDecl(unless(anyOf(isExpansionInSystemHeader(),
-                                  isImplicit())))
-            .bind("functionDecl"),
-        this);
+    dispatcher.AddCallback(DispatchedNodeKind::FunctionDeclaration, GetDispatcherCallback(this));
 }
 
-void OldStyleFunctionRule::run(const MatchFinder::MatchResult& result)
+void OldStyleFunctionRule::OnFunctionDeclaration(const FunctionDecl* functionDeclaration, ASTContext& context)
 {
-    const FunctionDecl* functionDeclaration = result.Nodes.getNodeAs<FunctionDecl>("functionDecl");
-    if (functionDeclaration == nullptr)
-        return;
-
-    SourceManager& sourceManager = result.Context->getSourceManager();
+    SourceManager& sourceManager = context.getSourceManager();
 
     SourceLocation location = functionDeclaration->getLocation();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, sourceManager))
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForRule(GetName(), location, sourceManager))
         return;
 
     Stmt* body = functionDeclaration->getBody();
     if (body == nullptr)
         return;
 
-    OldStyleDeclarationFinder finder(result.Context);
+    OldStyleDeclarationFinder finder(&context);
     finder.TraverseStmt(body);
 
     int oldStyleDeclarationCount = finder.GetOldStyleDeclarationsCount();
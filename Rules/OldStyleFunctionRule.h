@@ -2,17 +2,17 @@
 
 #include "Rules/Rule.h"
 
-#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include "Handlers/ASTDispatcher.h"
 
 class OldStyleFunctionRule : public Rule,
-                             public clang::ast_matchers::MatchFinder::MatchCallback
+                             public ASTDispatcherCallback
 {
 public:
     OldStyleFunctionRule(Context& context);
 
-    void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& finder) override;
+    void RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher) override;
 
-    void run(const clang::ast_matchers::MatchFinder::MatchResult& result) override;
+    void OnFunctionDeclaration(const clang::FunctionDecl* functionDeclaration, clang::ASTContext& context) override;
 
     static const char* GetName() { return "OldStyleFunctionRule"; }
 };
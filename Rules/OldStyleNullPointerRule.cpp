@@ -40,9 +40,9 @@ void OldStyleNullPointerRule::RegisterASTMatcherCallback(MatchFinder& finder)
         implicitCastExpr(unless(isExpansionInSystemHeader()),
                          isIntegerLiteralToPointerCast())
             .bind("zeroLiteralNullExpr"),
-        this);
+        GetMatchCallback(this));
 
-    finder.addMatcher(expr(has(customGnuNullExpr().bind("gnuNullExpr"))).bind("parentExpr"), this);
+    finder.addMatcher(expr(has(customGnuNullExpr().bind("gnuNullExpr"))).bind("parentExpr"), GetMatchCallback(this));
 }
 
 void OldStyleNullPointerRule::run(const MatchFinder::MatchResult& result)
@@ -3,7 +3,6 @@
 #include "Common/Context.h"
 #include "Common/OutputPrinter.h"
 #include "Common/SourceLocationHelper.h"
-#include "Common/TagTypeMatchers.h"
 #include "Common/TagTypeNameHelper.h"
 
 #include <clang/AST/Decl.h>
@@ -17,201 +16,17 @@ using namespace llvm;
 using namespace clang;
 using namespace clang::ast_matchers;
 
-namespace
-{
-
-QualType RecursivelyDesugarType(const QualType& type)
-{
-    QualType desugaredType = type;
-
-    while (true)
-    {
-        const ElaboratedType* elaboratedType = desugaredType->getAs<ElaboratedType>();
-        if (elaboratedType != nullptr)
-        {
-            desugaredType = elaboratedType->desugar();
-            continue;
-        }
-
-        if (desugaredType->isArrayType())
-        {
-            desugaredType = desugaredType->getAsArrayTypeUnsafe()->getElementType();
-            continue;
-        }
-
-        const PointerType* pointerType = desugaredType->getAs<PointerType>();
-        if (pointerType != nullptr)
-        {
-            desugaredType = pointerType->getPointeeType();
-            continue;
-        }
-
-        const ReferenceType* referenceType = desugaredType->getAs<ReferenceType>();
-        if (referenceType != nullptr)
-        {
-            desugaredType = referenceType->getPointeeType();
-            continue;
-        }
-
-        break;
-    }
-
-    return desugaredType;
-}
-
-QualType RecursivelyDesugarTypedefType(const QualType& type)
-{
-    QualType desugaredType = type;
-    bool haveTypedefType = false;
-
-    while (true)
-    {
-        const TypedefType* typedefType = desugaredType->getAs<TypedefType>();
-        if (typedefType != nullptr)
-        {
-            desugaredType = typedefType->desugar();
-            haveTypedefType = true;
-            continue;
-        }
-
-        const ElaboratedType* elaboratedType = desugaredType->getAs<ElaboratedType>();
-        if (elaboratedType != nullptr)
-        {
-            desugaredType = elaboratedType->desugar();
-            continue;
-        }
-
-        if (desugaredType->isArrayType())
-        {
-            desugaredType = desugaredType->getAsArrayTypeUnsafe()->getElementType();
-            continue;
-        }
-
-        const PointerType* pointerType = desugaredType->getAs<PointerType>();
-        if (pointerType != nullptr)
-        {
-            desugaredType = pointerType->getPointeeType();
-            continue;
-        }
-
-        const ReferenceType* referenceType = desugaredType->getAs<ReferenceType>();
-        if (referenceType != nullptr)
-        {
-            desugaredType = referenceType->getPointeeType();
-            continue;
-        }
-
-        break;
-    }
-
-    if (!haveTypedefType)
-    {
-        return QualType();
-    }
-
-    return desugaredType;
-}
-
-} // anonymous namespace
-
-namespace clang
-{
-namespace ast_matchers
-{
-
-AST_MATCHER_P(QualType, recursivelyDesugaredType, internal::Matcher<QualType>, InnerMatcher)
-{
-    if (Node.isNull())
-        return false;
-
-    QualType desugaredType = RecursivelyDesugarType(Node);
-    return InnerMatcher.matches(desugaredType, Finder, Builder);
-}
-
-AST_MATCHER_P(QualType, recursivelyDesugaredTypedefType, internal::Matcher<QualType>, InnerMatcher)
-{
-    if (Node.isNull())
-        return false;
-
-    QualType desugaredType = RecursivelyDesugarTypedefType(Node);
-    return InnerMatcher.matches(desugaredType, Finder, Builder);
-}
-
-AST_MATCHER_P(QualType, pointerOrReferenceTypeTo, internal::Matcher<QualType>, InnerMatcher)
-{
-    if (Node.isNull())
-        return false;
-
-    const PointerType* pointerType = Node->getAs<PointerType>();
-    if (pointerType != nullptr)
-    {
-        return InnerMatcher.matches(pointerType->getPointeeType(), Finder, Builder);
-    }
-
-    const ReferenceType* referenceType = Node->getAs<ReferenceType>();
-    if (referenceType != nullptr)
-    {
-        return InnerMatcher.matches(referenceType->getPointeeType(), Finder, Builder);
-    }
-
-    return false;
-}
-
-AST_MATCHER(TagDecl, isForwardDeclaration)
-{
-    return Node.getDefinition() == nullptr;
-}
-
-AST_MATCHER(EnumDecl, isScopedUsingClassTag)
-{
-    return Node.isScopedUsingClassTag();
-}
-
-} // namespace ast_matchers
-} // namespace clang
-
-
-internal::Matcher<QualType> CreateActualTagTypeMatcher()
-{
-    return qualType(hasDeclaration(tagDecl(
-        unless(isExpansionInSystemHeader()),
-        anyOf(classTemplateSpecializationDecl().bind("classTemplate"),
-              enumDecl(unless(isScopedUsingClassTag())).bind("oldStyleEnum"),
-              tagDecl(isForwardDeclaration()).bind("existingForwardDeclaration"),
-              anything()))
-           .bind("tagDecl")));
-}
-
-internal::Matcher<QualType> CreateTemplateTagTypeMatcher()
-{
-    return templateSpecializationType(
-        hasAnyTemplateArgument(
-            refersToType(
-                recursivelyDesugaredType(CreateActualTagTypeMatcher()))));
-}
-
-internal::Matcher<QualType> CreateTagTypeMatcher()
-{
-    return anyOf(qualType(recursivelyDesugaredTypedefType(CreateTemplateTagTypeMatcher())),
-                 qualType(recursivelyDesugaredTypedefType(CreateActualTagTypeMatcher())),
-                 qualType(recursivelyDesugaredType(CreateTemplateTagTypeMatcher())),
-                 qualType(pointerOrReferenceTypeTo(recursivelyDesugaredType(CreateActualTagTypeMatcher()))).bind("ptrOrRefType"),
-                 qualType(recursivelyDesugaredType(CreateActualTagTypeMatcher())));
-}
-
 PossibleForwardDeclarationRule::PossibleForwardDeclarationRule(Context& context)
     : Rule(context)
 {}
 
 void PossibleForwardDeclarationRule::RegisterASTMatcherCallback(MatchFinder& finder)
 {
-    finder.addMatcher(recordDecl().bind("recordDecl"), this);
-    finder.addMatcher(declRefExpr().bind("declRefExpr"), this);
-    finder.addMatcher(
-        decl(anyOf(valueDecl(hasType(CreateTagTypeMatcher())),
-                   functionDecl(returns(CreateTagTypeMatcher())))).bind("declWithTagType"),
-        this);
-    finder.addMatcher(expr(hasType(CreateTagTypeMatcher())).bind("exprWithTagType"), this);
+    finder.addMatcher(recordDecl().bind("recordDecl"), GetMatchCallback(this));
+    finder.addMatcher(declRefExpr().bind("declRefExpr"), GetMatchCallback(this));
+    // types are analyzed in callback, where results for the same types are reused
+    finder.addMatcher(valueDecl().bind("declWithTagType"), GetMatchCallback(this));
+    finder.addMatcher(expr().bind("exprWithTagType"), GetMatchCallback(this));
 }
 
 void PossibleForwardDeclarationRule::run(const MatchFinder::MatchResult& result)
@@ -226,37 +41,41 @@ void PossibleForwardDeclarationRule::run(const MatchFinder::MatchResult& result)
     if (recordDeclaration != nullptr)
         return HandleRecordDeclaration(recordDeclaration);
 
-    const TagDecl* tagDeclaration = result.Nodes.getNodeAs<TagDecl>("tagDecl");
-    if (tagDeclaration == nullptr)
-        return;
+    const ValueDecl* declarationWithTagType = result.Nodes.getNodeAs<ValueDecl>("declWithTagType");
+    if (declarationWithTagType != nullptr)
+    {
+        TagTypeInfo tagType = m_tagTypeAnalyzer.Analyze(declarationWithTagType->getType(), *m_sourceManager);
 
-    if (IsInBlacklistedProjectHeader(tagDeclaration))
-        return; // already blacklisted, so no point of checking further
+        const FunctionDecl* functionDeclaration = dyn_cast<FunctionDecl>(declarationWithTagType);
+        if (tagType.tagDeclaration == nullptr && functionDeclaration != nullptr)
+            tagType = m_tagTypeAnalyzer.Analyze(functionDeclaration->getReturnType(), *m_sourceManager);
 
-    if (! IsInDirectlyIncludedProjectHeader(tagDeclaration))
-        return;
+        return HandleDeclarationWithTagType(tagType, declarationWithTagType);
+    }
 
-    bool isExistingForwardDeclaration = result.Nodes.getNodeAs<Decl>("existingForwardDeclaration") != nullptr;
-    if (isExistingForwardDeclaration)
-        return;
+    const Expr* expressionWithTagType = result.Nodes.getNodeAs<Expr>("exprWithTagType");
+    if (expressionWithTagType != nullptr)
+    {
+        TagTypeInfo tagType = m_tagTypeAnalyzer.Analyze(expressionWithTagType->getType(), *m_sourceManager);
+        return HandleExpressionWithTagType(tagType, expressionWithTagType);
+    }
+}
 
-    tagDeclaration = tagDeclaration->getCanonicalDecl();
+const TagDecl* PossibleForwardDeclarationRule::GetTagDeclarationToCheck(const TagTypeInfo& tagType)
+{
+    if (tagType.tagDeclaration == nullptr)
+        return nullptr;
 
-    bool isPointerOrReferenceType = result.Nodes.getNodeAs<QualType>("ptrOrRefType") != nullptr;
-    bool isTemplateClassType = result.Nodes.getNodeAs<Decl>("classTemplate") != nullptr;
-    bool isOldStyleEnum = result.Nodes.getNodeAs<Decl>("oldStyleEnum") != nullptr;
+    if (IsInBlacklistedProjectHeader(tagType.tagDeclaration))
+        return nullptr; // already blacklisted, so no point of checking further
 
-    const Decl* declarationWithTagType = result.Nodes.getNodeAs<Decl>("declWithTagType");
-    if (declarationWithTagType != nullptr)
-        return HandleDeclarationWithTagType(tagDeclaration,
-                                            declarationWithTagType,
-                                            isPointerOrReferenceType,
-                                            isTemplateClassType,
-                                            isOldStyleEnum);
+    if (! IsInDirectlyIncludedProjectHeader(tagType.tagDeclaration))
+        return nullptr;
 
-    const Expr* expressionWithTagType = result.Nodes.getNodeAs<Expr>("exprWithTagType");
-    if (expressionWithTagType != nullptr)
-        return HandleExpressionWithTagType(tagDeclaration, expressionWithTagType);
+    if (tagType.isExistingForwardDeclaration)
+        return nullptr;
+
+    return tagType.tagDeclaration->getCanonicalDecl();
 }
 
 bool PossibleForwardDeclarationRule::IsInBlacklistedProjectHeader(const Decl* declaration)
@@ -341,19 +160,20 @@ void PossibleForwardDeclarationRule::HandleRecordDeclaration(const CXXRecordDecl
     }
 }
 
-void PossibleForwardDeclarationRule::HandleDeclarationWithTagType(const TagDecl* tagDeclaration,
-                                                                  const Decl* declarationWithTagType,
-                                                                  bool isPointerOrReferenceType,
-                                                                  bool isTemplateClassType,
-                                                                  bool isOldStyleEnum)
+void PossibleForwardDeclarationRule::HandleDeclarationWithTagType(const TagTypeInfo& tagType,
+                                                                  const Decl* declarationWithTagType)
 {
+    const TagDecl* tagDeclaration = GetTagDeclarationToCheck(tagType);
+    if (tagDeclaration == nullptr)
+        return;
+
     SourceLocation location = declarationWithTagType->getLocation();
     if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, *m_sourceManager))
         return;
 
-    if (isPointerOrReferenceType &&
-        !isTemplateClassType &&
-        !isOldStyleEnum &&
+    if (tagType.isPointerOrReferenceType &&
+        !tagType.isTemplateClassType &&
+        !tagType.isOldStyleEnum &&
         (isa<ParmVarDecl>(declarationWithTagType) ||
          isa<FieldDecl>(declarationWithTagType) ||
          isa<FunctionDecl>(declarationWithTagType)))
@@ -370,9 +190,13 @@ void PossibleForwardDeclarationRule::HandleDeclarationWithTagType(const TagDecl*
     }
 }
 
-void PossibleForwardDeclarationRule::HandleExpressionWithTagType(const TagDecl* tagDeclaration,
+void PossibleForwardDeclarationRule::HandleExpressionWithTagType(const TagTypeInfo& tagType,
                                                                  const Expr* expressionWithTagType)
 {
+    const TagDecl* tagDeclaration = GetTagDeclarationToCheck(tagType);
+    if (tagDeclaration == nullptr)
+        return;
+
     SourceLocation location = expressionWithTagType->getLocStart();
     if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, *m_sourceManager))
         return;
@@ -413,4 +237,5 @@ void PossibleForwardDeclarationRule::onEndOfTranslationUnit()
     }
 
     m_candidateForwardDeclarations.clear();
+    m_tagTypeAnalyzer.Clear();
 }
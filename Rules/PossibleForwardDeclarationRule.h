@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Common/TagTypeAnalyzer.h"
+
 #include "Rules/Rule.h"
 
 #include <clang/ASTMatchers/ASTMatchFinder.h>
@@ -28,16 +30,15 @@ private:
 
     void HandleDeclarationReferenceExpression(const clang::DeclRefExpr* declarationReferenceExpression);
     void HandleRecordDeclaration(const clang::CXXRecordDecl* recordDeclaration);
-    void HandleDeclarationWithTagType(const clang::TagDecl* tagDeclaration,
-                                      const clang::Decl* declarationWithTagType,
-                                      bool isPointerOrReferenceType,
-                                      bool isTemplateClassType,
-                                      bool isOldStyleEnum);
-    void HandleExpressionWithTagType(const clang::TagDecl* tagDeclaration,
+    const clang::TagDecl* GetTagDeclarationToCheck(const TagTypeInfo& tagType);
+    void HandleDeclarationWithTagType(const TagTypeInfo& tagType,
+                                      const clang::Decl* declarationWithTagType);
+    void HandleExpressionWithTagType(const TagTypeInfo& tagType,
                                      const clang::Expr* expressionWithTagType);
 
 private:
     clang::SourceManager* m_sourceManager;
     llvm::DenseMap<const clang::TagDecl*, clang::SourceLocation> m_candidateForwardDeclarations;
     llvm::DenseSet<clang::FileID> m_blacklistedProjectHeaders;
+    TagTypeAnalyzer m_tagTypeAnalyzer;
 };
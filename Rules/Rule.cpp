@@ -0,0 +1,200 @@
+#include "Rules/Rule.h"
+
+#include "Common/Context.h"
+#include "Common/RuleProfiler.h"
+#include "Common/Statistics.h"
+#include "Common/TraceRecorder.h"
+
+#include "Handlers/ASTDispatcher.h"
+
+#include <llvm/ADT/STLExtras.h>
+
+using namespace llvm;
+using namespace clang;
+using namespace clang::ast_matchers;
+
+namespace
+{
+
+// Forwards everything to rule's callback, measuring time spent in it and counting matches
+// Single matches are too many to be traced, but end of translation unit is where some rules do most of the work
+class InstrumentedMatchCallback : public MatchFinder::MatchCallback
+{
+public:
+    InstrumentedMatchCallback(MatchFinder::MatchCallback& callback,
+                              const char* ruleName,
+                              RuleProfileEntry* profileEntry,
+                              RuleStatistics* statistics,
+                              TraceRecorder* traceRecorder)
+        : m_callback(callback),
+          m_ruleName(ruleName),
+          m_profileEntry(profileEntry),
+          m_statistics(statistics),
+          m_traceRecorder(traceRecorder)
+    {}
+
+    void run(const MatchFinder::MatchResult& result) override
+    {
+        if (m_statistics != nullptr)
+            m_statistics->matchCallbacks++;
+
+        RuleProfileTimer timer(m_profileEntry != nullptr ? &m_profileEntry->matchCallbacks : nullptr);
+        m_callback.run(result);
+    }
+
+    void onStartOfTranslationUnit() override
+    {
+        RuleProfileTimer timer(m_profileEntry != nullptr ? &m_profileEntry->translationUnitCallbacks : nullptr);
+        m_callback.onStartOfTranslationUnit();
+    }
+
+    void onEndOfTranslationUnit() override
+    {
+        RuleProfileTimer timer(m_profileEntry != nullptr ? &m_profileEntry->translationUnitCallbacks : nullptr);
+        TraceSpan span(m_traceRecorder, std::string(m_ruleName) + "::onEndOfTranslationUnit", "rule");
+        m_callback.onEndOfTranslationUnit();
+    }
+
+private:
+    MatchFinder::MatchCallback& m_callback;
+    const char* m_ruleName;
+    RuleProfileEntry* m_profileEntry;
+    RuleStatistics* m_statistics;
+    TraceRecorder* m_traceRecorder;
+};
+
+// The same for callbacks of AST dispatcher
+class InstrumentedDispatcherCallback : public ASTDispatcherCallback
+{
+public:
+    InstrumentedDispatcherCallback(ASTDispatcherCallback& callback,
+                                   const char* ruleName,
+                                   RuleProfileEntry* profileEntry,
+                                   RuleStatistics* statistics,
+                                   TraceRecorder* traceRecorder)
+        : m_callback(callback),
+          m_ruleName(ruleName),
+          m_profileEntry(profileEntry),
+          m_statistics(statistics),
+          m_traceRecorder(traceRecorder)
+    {}
+
+    void OnStartOfTranslationUnit(ASTContext& context) override
+    {
+        RuleProfileTimer timer(m_profileEntry != nullptr ? &m_profileEntry->translationUnitCallbacks : nullptr);
+        m_callback.OnStartOfTranslationUnit(context);
+    }
+
+    void OnEndOfTranslationUnit() override
+    {
+        RuleProfileTimer timer(m_profileEntry != nullptr ? &m_profileEntry->translationUnitCallbacks : nullptr);
+        TraceSpan span(m_traceRecorder, std::string(m_ruleName) + "::onEndOfTranslationUnit", "rule");
+        m_callback.OnEndOfTranslationUnit();
+    }
+
+    void OnFunctionDeclaration(const FunctionDecl* declaration, ASTContext& context) override
+    {
+        RuleProfileTimer timer(CountCallback());
+        m_callback.OnFunctionDeclaration(declaration, context);
+    }
+
+    void OnVariableDeclaration(const VarDecl* declaration, ASTContext& context) override
+    {
+        RuleProfileTimer timer(CountCallback());
+        m_callback.OnVariableDeclaration(declaration, context);
+    }
+
+    void OnFieldDeclaration(const FieldDecl* declaration, ASTContext& context) override
+    {
+        RuleProfileTimer timer(CountCallback());
+        m_callback.OnFieldDeclaration(declaration, context);
+    }
+
+    void OnWrittenDeclaration(const Decl* declaration, ASTContext& context) override
+    {
+        RuleProfileTimer timer(CountCallback());
+        m_callback.OnWrittenDeclaration(declaration, context);
+    }
+
+    void OnWrittenStatement(const Stmt* statement, ASTContext& context) override
+    {
+        RuleProfileTimer timer(CountCallback());
+        m_callback.OnWrittenStatement(statement, context);
+    }
+
+private:
+    // dispatched nodes are counted as matches; returns counter for timer
+    RuleProfileCounter* CountCallback()
+    {
+        if (m_statistics != nullptr)
+            m_statistics->matchCallbacks++;
+
+        return (m_profileEntry != nullptr) ? &m_profileEntry->matchCallbacks : nullptr;
+    }
+
+private:
+    ASTDispatcherCallback& m_callback;
+    const char* m_ruleName;
+    RuleProfileEntry* m_profileEntry;
+    RuleStatistics* m_statistics;
+    TraceRecorder* m_traceRecorder;
+};
+
+} // anonymous namespace
+
+Rule::Rule(Context& context)
+    : m_context(context),
+      m_profileEntry(nullptr),
+      m_statistics(nullptr),
+      m_ruleName(nullptr),
+      m_matchCallback(nullptr)
+{}
+
+Rule::~Rule()
+{}
+
+void Rule::SetInstrumentation(const char* ruleName, RuleProfileEntry* profileEntry, RuleStatistics* statistics)
+{
+    m_ruleName = ruleName;
+    m_profileEntry = profileEntry;
+    m_statistics = statistics;
+}
+
+MatchFinder::MatchCallback* Rule::GetMatchCallback(MatchFinder::MatchCallback* callback)
+{
+    if (m_ruleName == nullptr)
+    {
+        m_matchCallback = callback;
+        return m_matchCallback;
+    }
+
+    // the same wrapper for all matchers, so that callbacks at start and end of translation unit
+    // are called as many times as without instrumentation
+    if (m_instrumentedCallback == nullptr)
+    {
+        m_instrumentedCallback = make_unique<InstrumentedMatchCallback>(
+            *callback, m_ruleName, m_profileEntry, m_statistics, m_context.traceRecorder.get());
+    }
+
+    m_matchCallback = m_instrumentedCallback.get();
+    return m_matchCallback;
+}
+
+ASTDispatcherCallback* Rule::GetDispatcherCallback(ASTDispatcherCallback* callback)
+{
+    if (m_ruleName == nullptr)
+        return callback;
+
+    if (m_instrumentedDispatcherCallback == nullptr)
+    {
+        m_instrumentedDispatcherCallback = make_unique<InstrumentedDispatcherCallback>(
+            *callback, m_ruleName, m_profileEntry, m_statistics, m_context.traceRecorder.get());
+    }
+
+    return m_instrumentedDispatcherCallback.get();
+}
+
+RuleProfileCounter* Rule::GetPreprocessorCallbacksCounter()
+{
+    return (m_profileEntry != nullptr) ? &m_profileEntry->preprocessorCallbacks : nullptr;
+}
@@ -1,36 +1,82 @@
 #pragma once
 
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+
+#include <memory>
+
+class ASTDispatcher;
+class ASTDispatcherCallback;
 struct Context;
+struct RuleProfileCounter;
+struct RuleProfileEntry;
+struct RuleStatistics;
 
 namespace clang
 {
-
 class CompilerInstance;
-
-namespace ast_matchers
-{
-class MatchFinder;
-} // namespace ast_matchers
-
 } // namespace clang
 
+// What rule needs from processing of source file
+// If none of selected rules need AST, source files are only preprocessed, which is much faster
+enum class RuleRequirement
+{
+    RawText,      // only contents of main file
+    Preprocessor, // preprocessor callbacks and comments
+    AST
+};
 
 class Rule
 {
 public:
-    Rule(Context& context)
-        : m_context(context)
-    {}
+    Rule(Context& context);
+    virtual ~Rule();
 
-    virtual ~Rule()
+    // only declaration, statement and type loc matchers are run (see ASTDispatcher::SetMatchFinder)
+    virtual void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& /*finder*/)
     {}
 
-    virtual void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& /*finder*/)
+    virtual void RegisterASTDispatcherCallbacks(ASTDispatcher& /*dispatcher*/)
     {}
 
     virtual void RegisterPreProcessorCallbacks(clang::CompilerInstance& /*ci*/)
     {}
 
+    // called after beginning of source file, so it may depend on whether we are in fake header source
+    virtual RuleRequirement GetRequirement() const
+    {
+        return RuleRequirement::AST;
+    }
+
+    // callback given to matchers by GetMatchCallback, or null if rule has no matchers
+    // matchers are run by AST dispatcher, which also calls this at start and end of translation unit
+    clang::ast_matchers::MatchFinder::MatchCallback* GetRegisteredMatchCallback() const
+    {
+        return m_matchCallback;
+    }
+
+    // set by rules factory if rules are profiled (see -profile-rules), traced (see -trace-file)
+    // or counted in statistics (see -stats)
+    void SetInstrumentation(const char* ruleName, RuleProfileEntry* profileEntry, RuleStatistics* statistics);
+
+protected:
+    // matcher callbacks are registered through this, so that time spent in them can be measured and traced
+    clang::ast_matchers::MatchFinder::MatchCallback* GetMatchCallback(
+        clang::ast_matchers::MatchFinder::MatchCallback* callback);
+
+    // the same for callbacks registered in AST dispatcher
+    ASTDispatcherCallback* GetDispatcherCallback(ASTDispatcherCallback* callback);
+
+    // for timing of preprocessor callbacks and comment handlers with RuleProfileTimer; null if not profiled
+    RuleProfileCounter* GetPreprocessorCallbacksCounter();
+
 protected:
     Context& m_context;
+    RuleProfileEntry* m_profileEntry; // null if not profiled
+    RuleStatistics* m_statistics; // null if statistics are not gathered
+
+private:
+    const char* m_ruleName;
+    clang::ast_matchers::MatchFinder::MatchCallback* m_matchCallback;
+    std::unique_ptr<clang::ast_matchers::MatchFinder::MatchCallback> m_instrumentedCallback;
+    std::unique_ptr<ASTDispatcherCallback> m_instrumentedDispatcherCallback;
 };
@@ -1,6 +1,7 @@
 #include "Rules/RulesFactory.h"
 
 #include "Common/Context.h"
+#include "Common/RuleProfiler.h"
 
 #include "Rules/BlockPlacementRule.h"
 #include "Rules/ClassNamingRule.h"
@@ -42,6 +43,18 @@ void AddRule(Container& rules, Context& context)
             std::cerr << "Using rule " << ruleName << std::endl;
         }
         rules.push_back(make_unique<RuleType>(context));
+        if (context.ruleProfiler != nullptr || context.traceRecorder != nullptr || context.statistics != nullptr)
+        {
+            RuleProfileEntry* profileEntry = nullptr;
+            if (context.ruleProfiler != nullptr)
+                profileEntry = &context.ruleProfiler->GetEntry(ruleName);
+
+            RuleStatistics* statistics = nullptr;
+            if (context.statistics != nullptr)
+                statistics = &context.statistics->rules[ruleName];
+
+            rules.back()->SetInstrumentation(RuleType::GetName(), profileEntry, statistics);
+        }
     }
     else
     {
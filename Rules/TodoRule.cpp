@@ -3,10 +3,16 @@
 #include "Common/Context.h"
 #include "Common/OutputPrinter.h"
 #include "Common/RegexHelper.h"
+#include "Common/RuleProfiler.h"
 #include "Common/SourceLocationHelper.h"
 
+#include "Handlers/ExclusionZoneCommentHandler.h"
+
 #include <clang/Frontend/CompilerInstance.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace llvm;
 using namespace clang;
 
@@ -22,6 +28,8 @@ void TodoRule::RegisterPreProcessorCallbacks(CompilerInstance& compiler)
 
 bool TodoRule::HandleComment(Preprocessor& pp, SourceRange range)
 {
+    RuleProfileTimer timer(GetPreprocessorCallbacksCounter());
+
     SourceLocation location = range.getBegin();
 
     SourceManager& sourceManager = pp.getSourceManager();
@@ -33,6 +41,67 @@ bool TodoRule::HandleComment(Preprocessor& pp, SourceRange range)
                                                  pp.getSourceManager(),
                                                  pp.getLangOpts());
 
+    CheckComment(commentText,
+                 m_context.sourceLocationHelper.GetCleanFilename(location, sourceManager),
+                 sourceManager.getPresumedLineNumber(location));
+
+    return false;
+}
+
+void TodoRule::CheckFileText(StringRef fileName, StringRef text)
+{
+    LangOptions langOptions;
+    langOptions.CPlusPlus = true;
+    langOptions.CPlusPlus11 = true;
+    langOptions.LineComment = true;
+
+    // raw lexer doesn't need source manager; locations of tokens are just offsets from given file location
+    SourceLocation fileLocation = SourceLocation::getFromRawEncoding(1);
+    Lexer lexer(fileLocation, langOptions, text.begin(), text.begin(), text.end());
+    lexer.SetCommentRetentionState(true);
+
+    struct RawComment
+    {
+        StringRef text;
+        int lineNumber;
+    };
+    std::vector<RawComment> comments;
+
+    std::size_t lineStartOffset = 0;
+    int lineNumber = 1;
+    Token token;
+    do
+    {
+        lexer.LexFromRawLexer(token);
+        if (token.isNot(tok::comment))
+            continue;
+
+        std::size_t commentOffset = token.getLocation().getRawEncoding() - fileLocation.getRawEncoding();
+        lineNumber += std::count(text.begin() + lineStartOffset, text.begin() + commentOffset, '\n');
+        lineStartOffset = commentOffset;
+
+        comments.push_back(RawComment{text.substr(commentOffset, token.getLength()), lineNumber});
+    }
+    while (token.isNot(tok::eof));
+
+    // exclusion zones have to be known before checking comments, the same as when file is processed by Clang
+    ExclusionZoneCommentHandler exclusionZoneCommentHandler(m_context);
+    exclusionZoneCommentHandler.AtBeginOfMainFile();
+    for (const auto& comment : comments)
+        exclusionZoneCommentHandler.HandleCommentText(comment.text, comment.lineNumber);
+    exclusionZoneCommentHandler.AtEndOfMainFile();
+
+    for (const auto& comment : comments)
+    {
+        if (m_context.sourceLocationHelper.IsLineInExclusionZone(GetName(), comment.lineNumber))
+            continue;
+
+        CheckComment(comment.text, fileName, comment.lineNumber);
+    }
+}
+
+void TodoRule::CheckComment(StringRef commentText, StringRef fileName, int lineNumber)
+{
     int lineOffset = 0;
     while (! commentText.empty())
     {
@@ -46,12 +115,9 @@ bool TodoRule::HandleComment(Preprocessor& pp, SourceRange range)
             m_context.outputPrinter->PrintRuleViolation("TODO comment",
                                                 Severity::Information,
                                                 GetStringRefResult(todoText, 1, commentLine).str(),
-                                                location,
-                                                sourceManager,
-                                                lineOffset);
+                                                fileName,
+                                                lineNumber + lineOffset);
         }
         ++lineOffset;
     }
-
-    return false;
 }
@@ -16,8 +16,17 @@ public:
 
     bool HandleComment(clang::Preprocessor& pp, clang::SourceRange range) override;
 
+    RuleRequirement GetRequirement() const override { return RuleRequirement::Preprocessor; }
+
+    // used in raw mode, where comments are found by raw lexer instead of preprocessor
+    // text must be null-terminated, as required by Clang lexer
+    void CheckFileText(llvm::StringRef fileName, llvm::StringRef text);
+
     static const char* GetName() { return "TodoRule"; }
 
+private:
+    void CheckComment(llvm::StringRef commentText, llvm::StringRef fileName, int lineNumber);
+
 private:
     boost::regex m_todoPattern;
 };
@@ -4,59 +4,48 @@
 #include "Common/OutputPrinter.h"
 #include "Common/SourceLocationHelper.h"
 
-#include <clang/AST/Decl.h>
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/DeclCXX.h>
 
 #include <boost/format.hpp>
 
 using namespace clang;
-using namespace clang::ast_matchers;
 
-namespace clang
+namespace
 {
-namespace ast_matchers
-{
-
-AST_MATCHER(FunctionDecl, isAnyTemplateKind)
-{
-    return Node.getTemplatedKind() != FunctionDecl::TK_NonTemplate;
-}
 
-AST_MATCHER(FunctionDecl, isDefaulted)
+bool IsPureMethod(const FunctionDecl* functionDeclaration)
 {
-    return Node.isDefaulted();
+    const auto* methodDeclaration = dyn_cast<CXXMethodDecl>(functionDeclaration);
+    return methodDeclaration != nullptr && methodDeclaration->isPure();
 }
 
-} // namespace ast_matchers
-} // namespace clang
+} // anonymous namespace
 
 
 UndefinedFunctionRule::UndefinedFunctionRule(Context& context)
     : Rule(context)
 {}
 
-void UndefinedFunctionRule::RegisterASTMatcherCallback(MatchFinder& finder)
+void UndefinedFunctionRule::RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher)
 {
-    finder.addMatcher(
-        functionDecl(unless(anyOf(isExpansionInSystemHeader(),
-                                  isImplicit(),
-                                  isDefaulted(),
-                                  isDeleted(),
-                                  isAnyTemplateKind())),
-                     unless(methodDecl(isPure())))
-            .bind("functionDecl"),
-    this);
+    dispatcher.AddCallback(DispatchedNodeKind::FunctionDeclaration, GetDispatcherCallback(this));
 }
 
-void UndefinedFunctionRule::run(const MatchFinder::MatchResult& result)
+void UndefinedFunctionRule::OnFunctionDeclaration(const FunctionDecl* functionDeclaration, ASTContext& context)
 {
-    SourceManager& sourceManager = *result.SourceManager;
-
-    const FunctionDecl* functionDeclaration = result.Nodes.getNodeAs<FunctionDecl>("functionDecl");
-    if (functionDeclaration == nullptr)
+    if (functionDeclaration->isDefaulted() ||
+        functionDeclaration->isDeleted() ||
+        functionDeclaration->getTemplatedKind() != FunctionDecl::TK_NonTemplate ||
+        IsPureMethod(functionDeclaration))
+    {
         return;
+    }
+
+    SourceManager& sourceManager = context.getSourceManager();
 
     SourceLocation location = functionDeclaration->getLocation();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, sourceManager))
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForRule(GetName(), location, sourceManager))
         return;
 
     std::string fullyQualifiedName = functionDeclaration->getQualifiedNameAsString();
@@ -79,14 +68,19 @@ void UndefinedFunctionRule::run(const MatchFinder::MatchResult& result)
     }
 }
 
-void UndefinedFunctionRule::onEndOfTranslationUnit()
+void UndefinedFunctionRule::OnEndOfTranslationUnit()
+{
+    PrintUndefinedFunctions(m_context);
+}
+
+void UndefinedFunctionRule::PrintUndefinedFunctions(Context& context)
 {
-    m_context.outputPrinter->ClearTentativeViolations();
+    context.outputPrinter->ClearTentativeViolations();
 
-    for (const auto& undefinedFunction : m_context.undefinedFunctions)
+    for (const auto& undefinedFunction : context.undefinedFunctions)
     {
         const bool tentative = true;
-        m_context.outputPrinter->PrintRuleViolation(
+        context.outputPrinter->PrintRuleViolation(
             "undefined function",
             Severity::Information,
             boost::str(boost::format("Function '%s' declared but never defined")
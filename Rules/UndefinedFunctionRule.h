@@ -2,19 +2,23 @@
 
 #include "Rules/Rule.h"
 
-#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include "Handlers/ASTDispatcher.h"
 
 class UndefinedFunctionRule : public Rule,
-                              public clang::ast_matchers::MatchFinder::MatchCallback
+                              public ASTDispatcherCallback
 {
 public:
     UndefinedFunctionRule(Context& context);
 
-    void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& finder) override;
+    void RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher) override;
 
-    void run(const clang::ast_matchers::MatchFinder::MatchResult& result) override;
+    void OnFunctionDeclaration(const clang::FunctionDecl* functionDeclaration, clang::ASTContext& context) override;
 
-    void onEndOfTranslationUnit() override;
+    void OnEndOfTranslationUnit() override;
+
+    // undefined functions can be reported only when all translation units have been processed,
+    // so they are printed as tentative violations which are replaced after every translation unit
+    static void PrintUndefinedFunctions(Context& context);
 
     static const char* GetName() { return "UndefinedFunctionRule"; }
 };
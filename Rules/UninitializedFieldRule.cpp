@@ -38,7 +38,7 @@ void UninitializedFieldRule::RegisterASTMatcherCallback(MatchFinder& finder)
                                 isImplicit(),
                                 isUnion())))
             .bind("recordDecl"),
-        this);
+        GetMatchCallback(this));
 
     finder.addMatcher(
         constructorDecl(unless(anyOf(isExpansionInSystemHeader(),
@@ -47,7 +47,7 @@ void UninitializedFieldRule::RegisterASTMatcherCallback(MatchFinder& finder)
                         isDefinition(),
                         hasDeclContext(recordDecl(unless(isUnion())).bind("parentRecordDecl")))
             .bind("constructorDecl"),
-        this);
+        GetMatchCallback(this));
 }
 
 void UninitializedFieldRule::run(const MatchFinder::MatchResult& result)
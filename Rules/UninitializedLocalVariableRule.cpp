@@ -5,39 +5,32 @@
 #include "Common/PodHelper.h"
 #include "Common/SourceLocationHelper.h"
 
+#include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
 
 #include <boost/format.hpp>
 
 using namespace clang;
-using namespace clang::ast_matchers;
 
 
 UninitializedLocalVariableRule::UninitializedLocalVariableRule(Context& context)
     : Rule(context)
 {}
 
-void UninitializedLocalVariableRule::RegisterASTMatcherCallback(MatchFinder& finder)
+void UninitializedLocalVariableRule::RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher)
 {
-    finder.addMatcher(
-        varDecl(unless(anyOf(isExpansionInSystemHeader(),
-                             isImplicit())),
-                unless(parmVarDecl()),
-                hasLocalStorage())
-            .bind("varDecl"),
-        this);
+    dispatcher.AddCallback(DispatchedNodeKind::VariableDeclaration, GetDispatcherCallback(this));
 }
 
-void UninitializedLocalVariableRule::run(const MatchFinder::MatchResult& result)
+void UninitializedLocalVariableRule::OnVariableDeclaration(const VarDecl* variableDeclaration, ASTContext& context)
 {
-    const VarDecl* variableDeclaration = result.Nodes.getNodeAs<VarDecl>("varDecl");
-    if (variableDeclaration == nullptr)
+    if (isa<ParmVarDecl>(variableDeclaration) || ! variableDeclaration->hasLocalStorage())
         return;
 
-    SourceManager& sourceManager = result.Context->getSourceManager();
+    SourceManager& sourceManager = context.getSourceManager();
 
     SourceLocation location = variableDeclaration->getLocation();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, sourceManager))
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForRule(GetName(), location, sourceManager))
         return;
 
     const DeclContext* declarationContext = variableDeclaration->getDeclContext();
@@ -50,7 +43,7 @@ void UninitializedLocalVariableRule::run(const MatchFinder::MatchResult& result)
             return;
     }
 
-    if (IsUninitializedPodVariable(variableDeclaration, result.Context))
+    if (IsUninitializedPodVariable(variableDeclaration, &context))
     {
         m_context.outputPrinter->PrintRuleViolation(
                 "uninitialized local variable",
@@ -28,14 +28,14 @@ void UnusedForwardDeclarationRule::RegisterASTMatcherCallback(MatchFinder& finde
         tagDecl(unless(anyOf(isExpansionInSystemHeader(),
                              isImplicit())))
             .bind("tagDecl"),
-        this);
+        GetMatchCallback(this));
 
     finder.addMatcher(
         typeLoc(unless(isExpansionInSystemHeader()),
                 loc(tagType(hasDeclaration(
                     tagDecl(unless(isExpansionInSystemHeader())).bind("tagDecl")))))
             .bind("tagTypeLoc"),
-        this);
+        GetMatchCallback(this));
 }
 
 void UnusedForwardDeclarationRule::run(const MatchFinder::MatchResult& result)
@@ -5,23 +5,12 @@
 #include "Common/RegexHelper.h"
 #include "Common/SourceLocationHelper.h"
 
+#include <clang/AST/ASTContext.h>
 #include <clang/AST/Decl.h>
 
 #include <boost/format.hpp>
 
 using namespace clang;
-using namespace clang::ast_matchers;
-
-namespace clang {
-namespace ast_matchers {
-
-AST_MATCHER(NamedDecl, hasEmptyName)
-{
-    return Node.getName().empty();
-}
-
-} // namespace ast_matchers
-} // namespace clang
 
 
 VariableNamingRule::VariableNamingRule(Context& context)
@@ -35,43 +24,25 @@ VariableNamingRule::VariableNamingRule(Context& context)
       m_deprecatedFieldNamePattern("m_[bp][[:upper:]].*") // deprecated m_bBool and m_pPtr
 {}
 
-void VariableNamingRule::RegisterASTMatcherCallback(MatchFinder& finder)
+void VariableNamingRule::RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher)
 {
-    finder.addMatcher(
-        varDecl(unless(anyOf(isExpansionInSystemHeader(), // ignore system headers
-                             isImplicit(),                // ignore implicit (compiler-generated) variables
-                             hasEmptyName())))            // unnamed function parameters are fine
-            .bind("varDecl"),
-        this);
-
-    finder.addMatcher(
-        fieldDecl(unless(anyOf(isExpansionInSystemHeader(),
-                               isImplicit(),
-                               hasEmptyName())))
-            .bind("fieldDecl"),
-        this);
+    // system headers and implicit (compiler-generated) variables are already skipped by dispatcher
+    dispatcher.AddCallback(DispatchedNodeKind::VariableDeclaration, GetDispatcherCallback(this));
+    dispatcher.AddCallback(DispatchedNodeKind::FieldDeclaration, GetDispatcherCallback(this));
 }
 
-void VariableNamingRule::run(const MatchFinder::MatchResult& result)
+void VariableNamingRule::OnVariableDeclaration(const VarDecl* variableDeclaration, ASTContext& context)
 {
-    const VarDecl* variableDeclaration = result.Nodes.getNodeAs<VarDecl>("varDecl");
-    if (variableDeclaration != nullptr)
-        return HandleVariableDeclaration(variableDeclaration, result.Context->getSourceManager());
+    auto name = variableDeclaration->getName();
+    if (name.empty())
+        return; // unnamed function parameters are fine
 
-    const FieldDecl* fieldDeclaration = result.Nodes.getNodeAs<FieldDecl>("fieldDecl");
-    if (fieldDeclaration != nullptr)
-        return HandleFieldDeclaration(fieldDeclaration, result.Context->getSourceManager());
-}
+    SourceManager& sourceManager = context.getSourceManager();
 
-void VariableNamingRule::HandleVariableDeclaration(const VarDecl* variableDeclaration,
-                                                   SourceManager& sourceManager)
-{
     SourceLocation location = variableDeclaration->getLocation();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, sourceManager))
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForRule(GetName(), location, sourceManager))
         return;
 
-    auto name = variableDeclaration->getName();
-
     // Static class members follow same rules as regular class members
     if (variableDeclaration->isStaticDataMember())
     {
@@ -80,7 +51,7 @@ void VariableNamingRule::HandleVariableDeclaration(const VarDecl* variableDeclar
     // Local, non-static variables in functions
     else if (variableDeclaration->hasLocalStorage())
     {
-        if (! boost::regex_match(name.begin(), name.end(), m_localVariableNamePattern))
+        if (! MatchNamePattern(name, m_localVariableNamePattern, m_statistics))
         {
               m_context.outputPrinter->PrintRuleViolation(
                 "variable naming",
@@ -90,7 +61,7 @@ void VariableNamingRule::HandleVariableDeclaration(const VarDecl* variableDeclar
                 location,
                 sourceManager);
         }
-        else if (boost::regex_match(name.begin(), name.end(), m_deprecatedVariableNamePattern))
+        else if (MatchNamePattern(name, m_deprecatedVariableNamePattern, m_statistics))
         {
             m_context.outputPrinter->PrintRuleViolation(
                 "variable naming",
@@ -106,7 +77,7 @@ void VariableNamingRule::HandleVariableDeclaration(const VarDecl* variableDeclar
     {
         if (variableDeclaration->getType().isConstQualified())
         {
-            if (! boost::regex_match(name.begin(), name.end(), m_constGlobalVariableNamePattern))
+            if (! MatchNamePattern(name, m_constGlobalVariableNamePattern, m_statistics))
             {
                 m_context.outputPrinter->PrintRuleViolation(
                     "variable naming",
@@ -119,7 +90,7 @@ void VariableNamingRule::HandleVariableDeclaration(const VarDecl* variableDeclar
         }
         else
         {
-            if (! boost::regex_match(name.begin(), name.end(), m_nonConstGlobalVariableNamePattern))
+            if (! MatchNamePattern(name, m_nonConstGlobalVariableNamePattern, m_statistics))
             {
                 m_context.outputPrinter->PrintRuleViolation(
                     "variable naming",
@@ -133,15 +104,18 @@ void VariableNamingRule::HandleVariableDeclaration(const VarDecl* variableDeclar
     }
 }
 
-void VariableNamingRule::HandleFieldDeclaration(const FieldDecl* fieldDeclaration,
-                                                SourceManager& sourceManager)
+void VariableNamingRule::OnFieldDeclaration(const FieldDecl* fieldDeclaration, ASTContext& context)
 {
+    auto name = fieldDeclaration->getName();
+    if (name.empty())
+        return; // unnamed bit fields and anonymous structs and unions
+
+    SourceManager& sourceManager = context.getSourceManager();
+
     SourceLocation location = fieldDeclaration->getLocation();
-    if (! m_context.sourceLocationHelper.IsLocationOfInterest(GetName(), location, sourceManager))
+    if (! m_context.sourceLocationHelper.IsLocationOfInterestForRule(GetName(), location, sourceManager))
         return;
 
-    auto name = fieldDeclaration->getName();
-
     ValidateFieldDeclaration(name, fieldDeclaration->getAccess(), location, sourceManager);
 }
 
@@ -152,7 +126,7 @@ void VariableNamingRule::ValidateFieldDeclaration(StringRef name,
 {
     if (access == AS_public)
     {
-        if (! boost::regex_match(name.begin(), name.end(), m_publicFieldNamePattern))
+        if (! MatchNamePattern(name, m_publicFieldNamePattern, m_statistics))
         {
             m_context.outputPrinter->PrintRuleViolation(
                 "variable naming",
@@ -165,7 +139,7 @@ void VariableNamingRule::ValidateFieldDeclaration(StringRef name,
     }
     else if (access == AS_protected || access == AS_private)
     {
-        if (! boost::regex_match(name.begin(), name.end(), m_privateOrProtectedFieldNamePattern))
+        if (! MatchNamePattern(name, m_privateOrProtectedFieldNamePattern, m_statistics))
         {
             std::string which = (access == AS_protected) ? "Protected" : "Private";
             m_context.outputPrinter->PrintRuleViolation(
@@ -177,7 +151,7 @@ void VariableNamingRule::ValidateFieldDeclaration(StringRef name,
                 location,
                 sourceManager);
         }
-        else if (boost::regex_match(name.begin(), name.end(), m_deprecatedFieldNamePattern))
+        else if (MatchNamePattern(name, m_deprecatedFieldNamePattern, m_statistics))
         {
             std::string which = (access == AS_protected) ? "Protected" : "Private";
             m_context.outputPrinter->PrintRuleViolation(
@@ -2,28 +2,24 @@
 
 #include "Rules/Rule.h"
 
-#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include "Handlers/ASTDispatcher.h"
 
 #include <boost/regex.hpp>
 
 class VariableNamingRule : public Rule,
-                           public clang::ast_matchers::MatchFinder::MatchCallback
+                           public ASTDispatcherCallback
 {
 public:
     VariableNamingRule(Context& context);
 
-    void RegisterASTMatcherCallback(clang::ast_matchers::MatchFinder& finder) override;
+    void RegisterASTDispatcherCallbacks(ASTDispatcher& dispatcher) override;
 
-    void run(const clang::ast_matchers::MatchFinder::MatchResult& result) override;
+    void OnVariableDeclaration(const clang::VarDecl* variableDeclaration, clang::ASTContext& context) override;
+    void OnFieldDeclaration(const clang::FieldDecl* fieldDeclaration, clang::ASTContext& context) override;
 
     static const char* GetName() { return "VariableNamingRule"; }
 
 private:
-    void HandleVariableDeclaration(const clang::VarDecl* variableDeclaration,
-                                   clang::SourceManager& sourceManager);
-
-    void HandleFieldDeclaration(const clang::FieldDecl* fieldDeclaration,
-                                clang::SourceManager& sourceManager);
 
     void ValidateFieldDeclaration(clang::StringRef name,
                                   clang::AccessSpecifier access,
@@ -3,6 +3,7 @@
 #include "Common/Context.h"
 #include "Common/OutputPrinter.h"
 #include "Common/SourceLocationHelper.h"
+#include "Common/TextScanner.h"
 #include "Common/TranslationUnitMatcher.h"
 
 #include <clang/AST/ASTContext.h>
@@ -17,7 +18,7 @@ WhitespaceRule::WhitespaceRule(Context& context)
 
 void WhitespaceRule::RegisterASTMatcherCallback(ast_matchers::MatchFinder& finder)
 {
-    finder.addMatcher(customTranslationUnitDecl().bind("translationUnitDecl"), this);
+    finder.addMatcher(customTranslationUnitDecl().bind("translationUnitDecl"), GetMatchCallback(this));
 }
 
 void WhitespaceRule::run(const ast_matchers::MatchFinder::MatchResult& result)
@@ -32,20 +33,18 @@ void WhitespaceRule::run(const ast_matchers::MatchFinder::MatchResult& result)
 
     StringRef fileName = m_context.sourceLocationHelper.GetCleanFilename(mainFileID, sourceManager);
 
-    MemoryBuffer* buffer = sourceManager.getBuffer(mainFileID);
-    const char* bufferChars = buffer->getBufferStart();
-    int bufferSize = buffer->getBufferSize();
-    if (bufferSize == 0)
+    CheckFileText(fileName, sourceManager.getBuffer(mainFileID)->getBuffer());
+}
+
+void WhitespaceRule::CheckFileText(StringRef fileName, StringRef text)
+{
+    if (text.empty())
         return;
 
     int lineNumber = 1;
-    bool haveWhitespace = false;
-    int numberOfTabs = 0;
-    for (int i = 0; i < bufferSize; ++i)
+    for (const auto& line : ScanTextLines(text))
     {
-        char ch = bufferChars[i];
-
-        if (ch == '\r')
+        if (line.Has(TextLine_HasCarriageReturn))
         {
             m_context.outputPrinter->PrintRuleViolation(
                 "whitespace",
@@ -57,50 +56,33 @@ void WhitespaceRule::run(const ast_matchers::MatchFinder::MatchResult& result)
             return;
         }
 
-        if (ch == '\n')
-        {
-            if (haveWhitespace)
-            {
-                m_context.outputPrinter->PrintRuleViolation(
-                    "whitespace",
-                    Severity::Style,
-                    "Whitespace at end of line",
-                    fileName,
-                    lineNumber);
-            }
-            if (numberOfTabs > 0)
-            {
-                m_context.outputPrinter->PrintRuleViolation(
-                    "whitespace",
-                    Severity::Style,
-                    "Tab character is not allowed as whitespace",
-                    fileName,
-                    lineNumber);
-            }
-
-            ++lineNumber;
-            haveWhitespace = false;
-            numberOfTabs = 0;
-            continue;
-        }
+        // last line without newline is reported below
+        if (! line.Has(TextLine_Terminated))
+            break;
 
-        if (ch == '\t')
+        if (line.Has(TextLine_TrailingWhitespace))
         {
-            ++numberOfTabs;
-            haveWhitespace = true;
-            continue;
+            m_context.outputPrinter->PrintRuleViolation(
+                "whitespace",
+                Severity::Style,
+                "Whitespace at end of line",
+                fileName,
+                lineNumber);
         }
-
-        if (ch == ' ')
+        if (line.Has(TextLine_HasTab))
         {
-            haveWhitespace = true;
-            continue;
+            m_context.outputPrinter->PrintRuleViolation(
+                "whitespace",
+                Severity::Style,
+                "Tab character is not allowed as whitespace",
+                fileName,
+                lineNumber);
         }
 
-        haveWhitespace = false;
+        ++lineNumber;
     }
 
-    if (bufferChars[bufferSize - 1] != '\n')
+    if (text.back() != '\n')
     {
         m_context.outputPrinter->PrintRuleViolation(
             "whitespace",
@@ -14,5 +14,10 @@ public:
 
     void run(const clang::ast_matchers::MatchFinder::MatchResult& result) override;
 
+    RuleRequirement GetRequirement() const override { return RuleRequirement::RawText; }
+
+    // also used directly in raw mode, without Clang
+    void CheckFileText(llvm::StringRef fileName, llvm::StringRef text);
+
     static const char* GetName() { return "WhitespaceRule"; }
 };
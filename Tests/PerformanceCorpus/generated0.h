@@ -0,0 +1,27 @@
+#pragma once
+
+
+class CGenerated0Class0
+{
+public:
+    int Function0(int parameter);
+    int Function1(int parameter);
+    int Function2(int parameter);
+    int Function3(int parameter);
+
+private:
+    int m_value = 0;
+};
+
+class CGenerated0Class1
+{
+public:
+    int Function0(int parameter);
+    int Function1(int parameter);
+    int Function2(int parameter);
+    int Function3(int parameter);
+
+private:
+    int m_value = 0;
+};
+
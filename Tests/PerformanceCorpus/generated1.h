@@ -0,0 +1,28 @@
+#pragma once
+
+#include "generated0.h"
+
+class CGenerated1Class0
+{
+public:
+    int Function0(int parameter);
+    int Function1(int parameter);
+    int Function2(int parameter);
+    int Function3(int parameter);
+
+private:
+    int m_value = 0;
+};
+
+class CGenerated1Class1
+{
+public:
+    int Function0(int parameter);
+    int Function1(int parameter);
+    int Function2(int parameter);
+    int Function3(int parameter);
+
+private:
+    int m_value = 0;
+};
+
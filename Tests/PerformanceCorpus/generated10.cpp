@@ -0,0 +1,330 @@
+#include "generated10.h"
+
+int CGenerated10Class0::Function0(int parameter)
+{
+    int value0 = parameter + m_value * 0;
+    if (parameter > 1)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        parameter -= i;
+    }
+    int value3 = parameter + m_value * 3;
+    if (parameter > 4)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        parameter -= i;
+    }
+    int value6 = parameter + m_value * 6;
+    if (parameter > 7)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        parameter -= i;
+    }
+    int value9 = parameter + m_value * 9;
+    if (parameter > 10)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 11; ++i)
+    {
+        parameter -= i;
+    }
+    return parameter;
+}
+
+int CGenerated10Class0::Function1(int parameter)
+{
+    int value0 = parameter + m_value * 0;
+    if (parameter > 1)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        parameter -= i;
+    }
+    int value3 = parameter + m_value * 3;
+    if (parameter > 4)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        parameter -= i;
+    }
+    int value6 = parameter + m_value * 6;
+    if (parameter > 7)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        parameter -= i;
+    }
+    int value9 = parameter + m_value * 9;
+    if (parameter > 10)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 11; ++i)
+    {
+        parameter -= i;
+    }
+    return parameter;
+}
+
+int CGenerated10Class0::Function2(int parameter)
+{
+    int value0 = parameter + m_value * 0;
+    if (parameter > 1)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        parameter -= i;
+    }
+    int value3 = parameter + m_value * 3;
+    if (parameter > 4)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        parameter -= i;
+    }
+    int value6 = parameter + m_value * 6;
+    if (parameter > 7)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        parameter -= i;
+    }
+    int value9 = parameter + m_value * 9;
+    if (parameter > 10)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 11; ++i)
+    {
+        parameter -= i;
+    }
+    return parameter;
+}
+
+int CGenerated10Class0::Function3(int parameter)
+{
+    int value0 = parameter + m_value * 0;
+    if (parameter > 1)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        parameter -= i;
+    }
+    int value3 = parameter + m_value * 3;
+    if (parameter > 4)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        parameter -= i;
+    }
+    int value6 = parameter + m_value * 6;
+    if (parameter > 7)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        parameter -= i;
+    }
+    int value9 = parameter + m_value * 9;
+    if (parameter > 10)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 11; ++i)
+    {
+        parameter -= i;
+    }
+    return parameter;
+}
+
+int CGenerated10Class1::Function0(int parameter)
+{
+    int value0 = parameter + m_value * 0;
+    if (parameter > 1)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        parameter -= i;
+    }
+    int value3 = parameter + m_value * 3;
+    if (parameter > 4)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        parameter -= i;
+    }
+    int value6 = parameter + m_value * 6;
+    if (parameter > 7)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        parameter -= i;
+    }
+    int value9 = parameter + m_value * 9;
+    if (parameter > 10)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 11; ++i)
+    {
+        parameter -= i;
+    }
+    return parameter;
+}
+
+int CGenerated10Class1::Function1(int parameter)
+{
+    int value0 = parameter + m_value * 0;
+    if (parameter > 1)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        parameter -= i;
+    }
+    int value3 = parameter + m_value * 3;
+    if (parameter > 4)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        parameter -= i;
+    }
+    int value6 = parameter + m_value * 6;
+    if (parameter > 7)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        parameter -= i;
+    }
+    int value9 = parameter + m_value * 9;
+    if (parameter > 10)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 11; ++i)
+    {
+        parameter -= i;
+    }
+    return parameter;
+}
+
+int CGenerated10Class1::Function2(int parameter)
+{
+    int value0 = parameter + m_value * 0;
+    if (parameter > 1)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        parameter -= i;
+    }
+    int value3 = parameter + m_value * 3;
+    if (parameter > 4)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        parameter -= i;
+    }
+    int value6 = parameter + m_value * 6;
+    if (parameter > 7)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        parameter -= i;
+    }
+    int value9 = parameter + m_value * 9;
+    if (parameter > 10)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 11; ++i)
+    {
+        parameter -= i;
+    }
+    return parameter;
+}
+
+int CGenerated10Class1::Function3(int parameter)
+{
+    int value0 = parameter + m_value * 0;
+    if (parameter > 1)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 2; ++i)
+    {
+        parameter -= i;
+    }
+    int value3 = parameter + m_value * 3;
+    if (parameter > 4)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 5; ++i)
+    {
+        parameter -= i;
+    }
+    int value6 = parameter + m_value * 6;
+    if (parameter > 7)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        parameter -= i;
+    }
+    int value9 = parameter + m_value * 9;
+    if (parameter > 10)
+    {
+        m_value += parameter;
+    }
+    for (int i = 0; i < 11; ++i)
+    {
+        parameter -= i;
+    }
+    return parameter;
+}
+
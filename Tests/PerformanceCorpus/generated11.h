@@ -0,0 +1,30 @@
+#pragma once
+
+#include "generated8.h"
+#include "generated9.h"
+#include "generated10.h"
+
+class CGenerated11Class0
+{
+public:
+    int Function0(int parameter);
+    int Function1(int parameter);
+    int Function2(int parameter);
+    int Function3(int parameter);
+
+private:
+    int m_value = 0;
+};
+
+class CGenerated11Class1
+{
+public:
+    int Function0(int parameter);
+    int Function1(int parameter);
+    int Function2(int parameter);
+    int Function3(int parameter);
+
+private:
+    int m_value = 0;
+};
+
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "generated9.h"
+#include "generated10.h"
+#include "generated11.h"
+
+class CGenerated12Class0
+{
+public:
+    int Function0(int parameter);
+    int Function1(int parameter);
+    int Function2(int parameter);
+    int Function3(int parameter);
+
+private:
+    int m_value = 0;
+};
+
+class CGenerated12Class1
+{
+public:
+    int Function0(int parameter);
+    int Function1(int parameter);
+    int Function2(int parameter);
+    int Function3(int parameter);
+
+private:
+    int m_value = 0;
+};
+
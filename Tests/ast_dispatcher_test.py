@@ -0,0 +1,42 @@
+import test_support
+
+class ASTDispatcherTest(test_support.TestBase):
+    def test_violations_of_matcher_and_dispatcher_rules_are_reported_in_source_order(self):
+        self.assert_colobot_lint_result(
+            source_file_lines = [
+                'void first_function()',
+                '{',
+                '    delete new int;',
+                '}',
+                'void second_function()',
+                '{',
+                '    delete new char;',
+                '}'
+            ],
+            rules_selection = ['FunctionNamingRule', 'NakedNewRule'],
+            expected_errors = [
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'first_function' should be named in UpperCamelCase style",
+                    'line': '1'
+                },
+                {
+                    'id': 'naked new',
+                    'severity': 'warning',
+                    'msg': "Naked new called with type 'int'",
+                    'line': '3'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'second_function' should be named in UpperCamelCase style",
+                    'line': '5'
+                },
+                {
+                    'id': 'naked new',
+                    'severity': 'warning',
+                    'msg': "Naked new called with type 'char'",
+                    'line': '7'
+                }
+            ])
@@ -0,0 +1,103 @@
+import test_support
+import json
+import os
+import shutil
+import subprocess
+import time
+
+this_dir = os.path.dirname(os.path.realpath(__file__))
+corpus_dir = os.path.join(this_dir, 'PerformanceCorpus')
+
+# relative slowdown or memory growth over baseline which fails the test
+time_tolerance = 0.3
+memory_tolerance = 0.15
+
+repetitions = 3
+
+update_baseline = os.environ.get('COLOBOT_LINT_UPDATE_PERFORMANCE_BASELINE') == '1'
+
+# Baseline is only valid for the machine it was measured on, so it is kept in build directory,
+# next to colobot-lint executable, and not in source tree
+def get_baseline_file_name():
+    build_dir = os.path.dirname(os.path.realpath(test_support.colobot_lint_exectuable))
+    return os.path.join(build_dir, 'performance_baseline.json')
+
+def load_baseline():
+    if not os.path.exists(get_baseline_file_name()):
+        return {}
+    with open(get_baseline_file_name()) as f:
+        return json.load(f)
+
+def save_baseline(baseline):
+    with open(get_baseline_file_name(), 'w') as f:
+        json.dump(baseline, f, indent = 2, sort_keys = True)
+        f.write('\n')
+
+# Returns wall time and peak RSS of one colobot-lint run over the corpus
+def run_colobot_lint_on_corpus(build_dir, additional_options):
+    source_files = sorted(os.path.join(build_dir, file_name)
+                          for file_name in os.listdir(build_dir) if file_name.endswith('.cpp'))
+
+    command = ([test_support.colobot_lint_exectuable] +
+               ['-p', build_dir, '-output-format', 'xml', '-output-file', os.devnull] +
+               additional_options +
+               source_files)
+
+    start_time = time.time()
+    process = subprocess.Popen(command, stdout = subprocess.DEVNULL)
+    _, status, rusage = os.wait4(process.pid, 0)
+    return status, time.time() - start_time, rusage.ru_maxrss
+
+# Performance tests are named *_perftest.py, so they are not run with correctness tests
+# They compare against baseline measured on the same machine and fail if there is none;
+# set COLOBOT_LINT_UPDATE_PERFORMANCE_BASELINE=1 to record it first and again after intended changes
+class CorpusPerformanceTest(test_support.TestBase):
+    def measure(self, additional_options):
+        with test_support.TempBuildDir() as build_dir:
+            for file_name in os.listdir(corpus_dir):
+                if file_name.endswith('.h') or file_name.endswith('.cpp'):
+                    shutil.copy(os.path.join(corpus_dir, file_name), build_dir)
+
+            test_support.write_compilation_database(
+                build_directory = build_dir,
+                source_file_names = [os.path.join(build_dir, file_name)
+                                     for file_name in os.listdir(build_dir) if file_name.endswith('.cpp')],
+                additional_compile_flags = ['-I' + build_dir])
+
+            # fastest run is least affected by other processes running on the machine
+            wall_times = []
+            peak_rss_kbs = []
+            for _ in range(repetitions):
+                status, wall_time, peak_rss_kb = run_colobot_lint_on_corpus(build_dir, additional_options)
+                self.assertEqual(status, 0)
+                wall_times.append(wall_time)
+                peak_rss_kbs.append(peak_rss_kb)
+
+            return { 'wallTimeSeconds': min(wall_times), 'peakRssKb': min(peak_rss_kbs) }
+
+    def assert_no_regression(self, scenario, additional_options):
+        baseline = load_baseline()
+        if not update_baseline and scenario not in baseline:
+            self.fail('no performance baseline for {} in {}; record it with COLOBOT_LINT_UPDATE_PERFORMANCE_BASELINE=1'
+                      .format(scenario, get_baseline_file_name()))
+
+        measurement = self.measure(additional_options)
+
+        if update_baseline:
+            baseline[scenario] = measurement
+            save_baseline(baseline)
+            return
+
+        expected = baseline[scenario]
+        self.assertLessEqual(measurement['wallTimeSeconds'], expected['wallTimeSeconds'] * (1 + time_tolerance),
+                             'time regression in {}: {:.2f} s, baseline {:.2f} s'.format(
+                                 scenario, measurement['wallTimeSeconds'], expected['wallTimeSeconds']))
+        self.assertLessEqual(measurement['peakRssKb'], expected['peakRssKb'] * (1 + memory_tolerance),
+                             'memory regression in {}: {} KB, baseline {} KB'.format(
+                                 scenario, measurement['peakRssKb'], expected['peakRssKb']))
+
+    def test_serial_all_rules(self):
+        self.assert_no_regression('serial all rules', ['-j', '1'])
+
+    def test_parallel_all_rules(self):
+        self.assert_no_regression('parallel all rules', ['-j', '4'])
@@ -0,0 +1,148 @@
+import test_support
+import os
+import socket
+import stat
+import subprocess
+import time
+
+class DaemonTest(test_support.TestBase):
+    def start_daemon(self, socket_path):
+        daemon = subprocess.Popen([test_support.colobot_lint_exectuable, '-daemon', '-daemon-socket', socket_path])
+        for i in range(100):
+            if os.path.exists(socket_path):
+                break
+            time.sleep(0.1)
+        self.assertTrue(os.path.exists(socket_path))
+        return daemon
+
+    def stop_daemon(self, daemon, socket_path):
+        daemon.terminate()
+        self.assertEqual(daemon.wait(), 0)
+        self.assertFalse(os.path.exists(socket_path))
+
+    def run_client(self, build_dir, socket_path, extra_options = []):
+        return subprocess.check_output([test_support.colobot_lint_exectuable] +
+                                       ['-daemon-socket', socket_path] +
+                                       ['-p', build_dir] +
+                                       ['-output-format', 'xml'] +
+                                       ['-only-rule', 'FunctionNamingRule'] +
+                                       extra_options +
+                                       [os.path.join(build_dir, 'one.cpp'), os.path.join(build_dir, 'two.cpp')])
+
+    def prepare_files(self, build_dir, one_lines):
+        test_support.write_file_lines(os.path.join(build_dir, 'one.cpp'), one_lines)
+        test_support.write_file_lines(os.path.join(build_dir, 'two.cpp'), ['void two_function() {}'])
+        test_support.write_compilation_database(
+            build_directory = build_dir,
+            source_file_names = [os.path.join(build_dir, 'one.cpp'), os.path.join(build_dir, 'two.cpp')])
+
+    def assert_function_naming_violations(self, output, function_names):
+        self.assert_xml_output_match(
+            output,
+            [
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function '{0}' should be named in UpperCamelCase style".format(function_name),
+                    'line': '1'
+                }
+                for function_name in function_names
+            ])
+
+    def test_daemon_processes_requests(self):
+        with test_support.TempBuildDir() as build_dir:
+            socket_path = os.path.join(build_dir, 'daemon.sock')
+            self.prepare_files(build_dir, ['void one_function() {}'])
+
+            daemon = self.start_daemon(socket_path)
+            try:
+                self.assert_function_naming_violations(self.run_client(build_dir, socket_path),
+                                                       ['one_function', 'two_function'])
+
+                self.prepare_files(build_dir, ['void OneFunction() {}'])
+                self.assert_function_naming_violations(self.run_client(build_dir, socket_path),
+                                                       ['two_function'])
+            finally:
+                self.stop_daemon(daemon, socket_path)
+
+    def test_client_falls_back_to_local_processing(self):
+        with test_support.TempBuildDir() as build_dir:
+            socket_path = os.path.join(build_dir, 'daemon.sock')
+            self.prepare_files(build_dir, ['void one_function() {}'])
+
+            self.assert_function_naming_violations(self.run_client(build_dir, socket_path),
+                                                   ['one_function', 'two_function'])
+
+    def test_daemon_processes_only_changed_files(self):
+        with test_support.TempBuildDir() as build_dir:
+            socket_path = os.path.join(build_dir, 'daemon.sock')
+            self.prepare_files(build_dir, ['void one_function() {}'])
+
+            daemon = self.start_daemon(socket_path)
+            try:
+                output = self.run_client(build_dir, socket_path,
+                                         ['-changed-files', os.path.join(build_dir, 'two.cpp')])
+                self.assert_function_naming_violations(output, ['two_function'])
+            finally:
+                self.stop_daemon(daemon, socket_path)
+
+    def test_client_rejects_stats(self):
+        with test_support.TempBuildDir() as build_dir:
+            socket_path = os.path.join(build_dir, 'daemon.sock')
+            self.prepare_files(build_dir, ['void one_function() {}'])
+
+            with self.assertRaises(subprocess.CalledProcessError):
+                self.run_client(build_dir, socket_path, ['-stats'])
+
+    def send_raw_request(self, socket_path, data):
+        client = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        client.connect(socket_path)
+        client.sendall(data)
+        response = b''
+        while True:
+            received = client.recv(4096)
+            if not received:
+                break
+            response += received
+        client.close()
+        return response
+
+    def test_daemon_socket_is_accessible_only_by_owner(self):
+        with test_support.TempBuildDir() as build_dir:
+            socket_path = os.path.join(build_dir, 'daemon.sock')
+
+            daemon = self.start_daemon(socket_path)
+            try:
+                self.assertEqual(stat.S_IMODE(os.stat(socket_path).st_mode), 0o600)
+            finally:
+                self.stop_daemon(daemon, socket_path)
+
+    def test_daemon_rejects_too_large_message(self):
+        with test_support.TempBuildDir() as build_dir:
+            socket_path = os.path.join(build_dir, 'daemon.sock')
+            self.prepare_files(build_dir, ['void one_function() {}'])
+
+            daemon = self.start_daemon(socket_path)
+            try:
+                response = self.send_raw_request(socket_path, b'99999999999999999999\n')
+                self.assertIn(b'Invalid lint request', response)
+
+                self.assert_function_naming_violations(self.run_client(build_dir, socket_path),
+                                                       ['one_function', 'two_function'])
+            finally:
+                self.stop_daemon(daemon, socket_path)
+
+    def test_daemon_rejects_string_longer_than_message(self):
+        with test_support.TempBuildDir() as build_dir:
+            socket_path = os.path.join(build_dir, 'daemon.sock')
+            self.prepare_files(build_dir, ['void one_function() {}'])
+
+            daemon = self.start_daemon(socket_path)
+            try:
+                response = self.send_raw_request(socket_path, b'18\n99999999999999999:')
+                self.assertIn(b'Invalid lint request', response)
+
+                self.assert_function_naming_violations(self.run_client(build_dir, socket_path),
+                                                       ['one_function', 'two_function'])
+            finally:
+                self.stop_daemon(daemon, socket_path)
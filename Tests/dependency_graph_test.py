@@ -0,0 +1,120 @@
+import test_support
+import os
+import subprocess
+
+class DependencyGraphTest(test_support.TestBase):
+    def generate_graph(self, source_files_data, target_file):
+        with test_support.TempBuildDir() as build_dir:
+            for file_subpath, lines in source_files_data.items():
+                test_support.mkdir_p(os.path.join(build_dir, os.path.dirname(file_subpath)))
+                test_support.write_file_lines(os.path.join(build_dir, file_subpath), lines)
+
+            source_file = os.path.join(build_dir, target_file)
+            test_support.write_compilation_database(
+                build_directory = build_dir,
+                source_file_names = [source_file],
+                additional_compile_flags = ['-I' + build_dir])
+
+            command = ([test_support.colobot_lint_exectuable] +
+                       ['-p', build_dir, '-generate-graph', 'DependencyGraph'] +
+                       ['-project-local-include-path', os.path.join(build_dir, 'project')] +
+                       [source_file])
+
+            output = subprocess.check_output(command).decode('utf-8')
+            return sorted(line.strip() for line in output.splitlines() if '->' in line)
+
+    def test_calls_are_counted_as_edge_weights(self):
+        edges = self.generate_graph(
+            source_files_data = {
+                'project/callee.h': [
+                    'class CCallee',
+                    '{',
+                    'public:',
+                    '    void Foo();',
+                    '    void Bar();',
+                    '};',
+                    'class COther',
+                    '{',
+                    'public:',
+                    '    void Baz();',
+                    '};'
+                ],
+                'src.cpp': [
+                    '#include "project/callee.h"',
+                    'class CCaller : public CCallee',
+                    '{',
+                    'public:',
+                    '    void Run(CCallee& callee, COther& other);',
+                    '};',
+                    'void CCaller::Run(CCallee& callee, COther& other)',
+                    '{',
+                    '    callee.Foo();',
+                    '    callee.Bar();',
+                    '    callee.Foo();',
+                    '    other.Baz();',
+                    '}'
+                ]
+            },
+            target_file = 'src.cpp')
+
+        self.assertEqual(edges, [
+            '"CCaller" -> "CCallee" [weight=3, label="3"]',
+            '"CCaller" -> "CCallee" [color="red"]',
+            '"CCaller" -> "COther"'
+        ])
+
+    def test_calls_in_template_instantiations_are_counted_once(self):
+        edges = self.generate_graph(
+            source_files_data = {
+                'project/callee.h': [
+                    'class CCallee',
+                    '{',
+                    'public:',
+                    '    void Foo();',
+                    '};'
+                ],
+                'src.cpp': [
+                    '#include "project/callee.h"',
+                    'template<typename T>',
+                    'class CHolder',
+                    '{',
+                    'public:',
+                    '    void Run(CCallee& callee)',
+                    '    {',
+                    '        callee.Foo();',
+                    '        callee.Foo();',
+                    '    }',
+                    '};',
+                    'void RunAll(CCallee& callee)',
+                    '{',
+                    '    CHolder<int>().Run(callee);',
+                    '    CHolder<float>().Run(callee);',
+                    '}'
+                ]
+            },
+            target_file = 'src.cpp')
+
+        self.assertEqual(edges, [
+            '"CHolder" -> "CCallee" [weight=2, label="2"]'
+        ])
+
+    def test_inheritance_of_class_template_is_printed_once(self):
+        edges = self.generate_graph(
+            source_files_data = {
+                'src.cpp': [
+                    'class CBase {};',
+                    'template<typename T>',
+                    'class CDerived : public CBase',
+                    '{};',
+                    'void UseAll()',
+                    '{',
+                    '    CDerived<int> first;',
+                    '    CDerived<float> second;',
+                    '}'
+                ]
+            },
+            target_file = 'src.cpp')
+
+        self.assertEqual(edges, [
+            '"CDerived" -> "CBase" [color="red"]'
+        ])
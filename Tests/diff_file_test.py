@@ -0,0 +1,123 @@
+import test_support
+import os
+import subprocess
+
+class DiffFileTest(test_support.TestBase):
+    def run_with_diff(self, diff_lines):
+        with test_support.TempBuildDir() as build_dir:
+            source_files_data = {
+                'header.h': [
+                    'int HeaderFunction() { return; }',
+                    ''
+                ],
+                'one.cpp': [
+                    '#include "header.h"',
+                    'void one_function() {}',
+                    ''
+                ],
+                'two.cpp': [
+                    'void two_function() {}',
+                    'void two_function_changed() {}',
+                    ''
+                ],
+                'three.cpp': [
+                    'void three_function() {}',
+                    ''
+                ],
+                'changes.diff': diff_lines
+            }
+            for file_subpath, lines in source_files_data.items():
+                test_support.write_file_lines(os.path.join(build_dir, file_subpath), lines)
+
+            source_files = [os.path.join(build_dir, file_subpath)
+                            for file_subpath in ['one.cpp', 'two.cpp', 'three.cpp']]
+            test_support.write_compilation_database(
+                build_directory = build_dir,
+                source_file_names = source_files,
+                additional_compile_flags = ['-I' + build_dir])
+
+            command = ([test_support.colobot_lint_exectuable] +
+                       ['-p', build_dir, '-output-format', 'xml', '-verbose', '-j', '2'] +
+                       ['-only-rule', 'FunctionNamingRule', '-only-rule', 'UndefinedFunctionRule'] +
+                       ['-project-local-include-path', build_dir] +
+                       ['-diff-file', 'changes.diff'] +
+                       source_files)
+
+            # paths in diff are relative to current directory
+            process = subprocess.Popen(command, cwd = build_dir, stdout = subprocess.PIPE, stderr = subprocess.PIPE)
+            output, error_output = process.communicate()
+            return output, error_output.decode('utf-8')
+
+    def test_only_changed_lines_and_affected_source_files(self):
+        output, error_output = self.run_with_diff([
+            'diff --git a/header.h b/header.h',
+            '--- a/header.h',
+            '+++ b/header.h',
+            '@@ -1 +1 @@',
+            '-int HeaderFunction() { return 0; }',
+            '+int HeaderFunction() { return; }',
+            'diff --git a/two.cpp b/two.cpp',
+            '--- a/two.cpp',
+            '+++ b/two.cpp',
+            '@@ -1,0 +2 @@',
+            '+void two_function_changed() {}',
+            ''
+        ])
+
+        self.assert_xml_output_match(
+            output,
+            [
+                {
+                    'id': 'compile error',
+                    'severity': 'error',
+                    'msg': "non-void function 'HeaderFunction' should return a value",
+                    'line': '1'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'two_function_changed' should be named in UpperCamelCase style",
+                    'line': '2'
+                }
+            ])
+
+        self.assertNotIn('one.cpp [not affected by changes]', error_output)
+        self.assertNotIn('two.cpp [not affected by changes]', error_output)
+        self.assertIn('three.cpp [not affected by changes]', error_output)
+
+    def test_empty_diff(self):
+        output, error_output = self.run_with_diff([''])
+
+        self.assert_xml_output_match(output, [])
+        self.assertIn('one.cpp [not affected by changes]', error_output)
+        self.assertIn('two.cpp [not affected by changes]', error_output)
+        self.assertIn('three.cpp [not affected by changes]', error_output)
+
+    def test_added_line_looking_like_file_header(self):
+        output, error_output = self.run_with_diff([
+            'diff --git a/two.cpp b/two.cpp',
+            '--- a/two.cpp',
+            '+++ b/two.cpp',
+            '@@ -0,0 +1 @@',
+            '+++ i;',
+            '@@ -1,0 +2 @@',
+            '+void two_function_changed() {}',
+            ''
+        ])
+
+        self.assert_xml_output_match(
+            output,
+            [
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'two_function' should be named in UpperCamelCase style",
+                    'line': '1'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'two_function_changed' should be named in UpperCamelCase style",
+                    'line': '2'
+                }
+            ])
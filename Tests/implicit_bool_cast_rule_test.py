@@ -107,3 +107,25 @@ class ImplicitBoolCastRuleTest(test_support.TestBase):
                 '}'
             ],
             expected_errors = [])
+
+    def test_ignore_comparison_of_bools_in_nested_code(self):
+        self.assert_colobot_lint_result(
+            source_file_lines = [
+                'template<typename T>',
+                'struct Foo',
+                '{',
+                '  bool Bar(bool a, bool b)',
+                '  {',
+                '    bool result = (a == b) && (a != b);',
+                '    return result;',
+                '  }',
+                '};',
+                'bool Baz() { return Foo<int>().Bar(true, false); }',
+                'int value = true;'
+            ],
+            expected_errors = [
+                {
+                    'msg': "Implicit cast bool -> 'int'",
+                    'line': '11'
+                }
+            ])
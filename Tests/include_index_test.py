@@ -0,0 +1,105 @@
+import test_support
+import os
+import subprocess
+
+class IncludeIndexTest(test_support.TestBase):
+    def prepare_files(self, build_dir):
+        source_files_data = {
+            'one.h': [
+                'void OneHeaderFunction();',
+                ''
+            ],
+            'two.h': [
+                'void TwoHeaderFunction();',
+                ''
+            ],
+            'one.cpp': [
+                '#include "one.h"',
+                'void one_function() {}',
+                ''
+            ],
+            'two.cpp': [
+                '#include "two.h"',
+                'void two_function() {}',
+                ''
+            ],
+            'three.cpp': [
+                '#include "one.h"',
+                '#include "two.h"',
+                'void three_function() {}',
+                ''
+            ]
+        }
+        for file_subpath, lines in source_files_data.items():
+            test_support.write_file_lines(os.path.join(build_dir, file_subpath), lines)
+
+        source_files = [os.path.join(build_dir, file_subpath)
+                        for file_subpath in ['one.cpp', 'two.cpp', 'three.cpp']]
+        test_support.write_compilation_database(
+            build_directory = build_dir,
+            source_file_names = source_files,
+            additional_compile_flags = ['-I' + build_dir])
+        return source_files
+
+    def run_colobot_lint(self, build_dir, source_files, additional_options):
+        command = ([test_support.colobot_lint_exectuable] +
+                   ['-p', build_dir, '-output-format', 'xml', '-verbose'] +
+                   ['-only-rule', 'FunctionNamingRule'] +
+                   ['-project-local-include-path', build_dir] +
+                   ['-include-index-file', os.path.join(build_dir, 'include-index.txt')] +
+                   additional_options +
+                   source_files)
+
+        process = subprocess.Popen(command, stdout = subprocess.PIPE, stderr = subprocess.PIPE)
+        output, error_output = process.communicate()
+        self.assertEqual(process.returncode, 0)
+        return output, error_output.decode('utf-8')
+
+    def test_only_source_files_including_changed_header_are_processed(self):
+        with test_support.TempBuildDir() as build_dir:
+            source_files = self.prepare_files(build_dir)
+
+            self.run_colobot_lint(build_dir, source_files, [])
+            self.assertTrue(os.path.exists(os.path.join(build_dir, 'include-index.txt')))
+
+            output, error_output = self.run_colobot_lint(
+                build_dir, source_files, ['-changed-files', os.path.join(build_dir, 'two.h')])
+
+            self.assert_xml_output_match(
+                output,
+                [
+                    {
+                        'id': 'function naming',
+                        'severity': 'style',
+                        'msg': "Function 'two_function' should be named in UpperCamelCase style",
+                        'line': '2'
+                    },
+                    {
+                        'id': 'function naming',
+                        'severity': 'style',
+                        'msg': "Function 'three_function' should be named in UpperCamelCase style",
+                        'line': '3'
+                    }
+                ])
+
+            self.assertIn('one.cpp [not affected by changes]', error_output)
+
+    def test_changed_source_file_is_processed(self):
+        with test_support.TempBuildDir() as build_dir:
+            source_files = self.prepare_files(build_dir)
+
+            self.run_colobot_lint(build_dir, source_files, [])
+
+            output, _ = self.run_colobot_lint(
+                build_dir, source_files, ['-changed-files', os.path.join(build_dir, 'one.cpp')])
+
+            self.assert_xml_output_match(
+                output,
+                [
+                    {
+                        'id': 'function naming',
+                        'severity': 'style',
+                        'msg': "Function 'one_function' should be named in UpperCamelCase style",
+                        'line': '2'
+                    }
+                ])
@@ -0,0 +1,51 @@
+import test_support
+
+class LintHeadersTest(test_support.TestBase):
+    def test_header_not_self_contained(self):
+        self.assert_colobot_lint_result_with_custom_files(
+            source_files_data = {
+                'foo/bar.h' : [
+                    'Bar Foo() {}',
+                    ''
+                ],
+                'foo/bar.cpp': [
+                    'void bad_function() {}',
+                    ''
+                ]
+            },
+            compilation_database_files = ['foo/bar.cpp'],
+            target_files = ['foo/bar.h', 'foo/bar.cpp'],
+            rules_selection = ['FunctionNamingRule'],
+            additional_options = ['-lint-headers', '-project-local-include-path', '$TEMP_DIR'],
+            expected_errors = [
+                {
+                    'id': 'header file not self-contained',
+                    'severity': 'error',
+                    'msg': "Including single header file should not result in compile error: unknown type name 'Bar'",
+                    'line': '1'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'bad_function' should be named in UpperCamelCase style",
+                    'line': '1'
+                }
+            ])
+
+    def test_compile_flags_are_taken_from_closest_source_file(self):
+        self.assert_colobot_lint_result_with_custom_files(
+            source_files_data = {
+                'foo/sub/baz.h' : [
+                    'HEADER_TYPE Baz();',
+                    ''
+                ],
+                'foo/bar.cpp': [
+                    'void Bar() {}',
+                    ''
+                ]
+            },
+            compilation_database_files = ['foo/bar.cpp'],
+            target_files = ['foo/sub/baz.h'],
+            additional_compile_flags = ['-DHEADER_TYPE=int'],
+            additional_options = ['-lint-headers', '-project-local-include-path', '$TEMP_DIR'],
+            expected_errors = [])
@@ -2,12 +2,12 @@
 import unittest
 import os
 
-def list_tests():
+def list_tests(pattern = '*_test.py'):
     tests = []
 
     loader = unittest.TestLoader()
     this_dir = os.path.dirname(os.path.realpath(__file__))
-    testmodules = loader.discover(this_dir, pattern='*_test.py')
+    testmodules = loader.discover(this_dir, pattern=pattern)
 
     # .py modules
     for testmodule in testmodules:
@@ -21,5 +21,8 @@ def list_tests():
     return tests
 
 if __name__ == '__main__':
-    for test in list_tests():
+    # performance tests are listed separately, so that they can be registered with their own label
+    import sys
+    pattern = '*_perftest.py' if '--performance' in sys.argv[1:] else '*_test.py'
+    for test in list_tests(pattern):
         print(test)
\ No newline at end of file
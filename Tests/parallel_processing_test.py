@@ -0,0 +1,76 @@
+import test_support
+
+class ParallelProcessingTest(test_support.TestBase):
+    def run_with_job_count(self, job_count):
+        return test_support.run_colobot_lint_with_prepared_files(
+            source_files_data = {
+                'header.h': [
+                    'void Foo();',
+                    'void Bar();',
+                    'int Unused(int x) { return; }'
+                ],
+                'one.cpp': [
+                    '#include "header.h"',
+                    'void Foo() {}',
+                    'void one_function() {}'
+                ],
+                'two.cpp': [
+                    '#include "header.h"',
+                    'void Baz();',
+                    'void two_function() {}'
+                ],
+                'three.cpp': [
+                    '#include "header.h"',
+                    'void Baz() {}',
+                    'void three_function() {}'
+                ],
+                'fake_header_sources/header.cpp': [
+                    '#include "header.h"'
+                ]
+            },
+            compilation_database_files = ['one.cpp', 'two.cpp', 'three.cpp', 'fake_header_sources/header.cpp'],
+            target_files = ['one.cpp', 'two.cpp', 'three.cpp', 'fake_header_sources/header.cpp'],
+            rules_selection = ['FunctionNamingRule', 'UndefinedFunctionRule'],
+            additional_compile_flags = ['-I$TEMP_DIR'],
+            additional_options = ['-project-local-include-path', '$TEMP_DIR', '-j', str(job_count)])
+
+    def test_parallel_output_is_same_as_serial_output(self):
+        serial_output = self.run_with_job_count(1)
+        for job_count in [2, 3, 4]:
+            self.assertEqual(self.run_with_job_count(job_count), serial_output)
+
+    def test_parallel_output_content(self):
+        self.assert_xml_output_match(
+            self.run_with_job_count(4),
+            [
+                {
+                    'id': 'compile error',
+                    'severity': 'error',
+                    'msg': 'non-void function \'Unused\' should return a value',
+                    'line': '3'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'one_function' should be named in UpperCamelCase style",
+                    'line': '3'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'two_function' should be named in UpperCamelCase style",
+                    'line': '3'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'three_function' should be named in UpperCamelCase style",
+                    'line': '3'
+                },
+                {
+                    'id': 'undefined function',
+                    'severity': 'information',
+                    'msg': "Function 'Bar' declared but never defined",
+                    'line': '2'
+                }
+            ])
@@ -191,6 +191,18 @@ class PossibleForwardDeclarationRuleTest(test_support.TestBase):
             ],
             expected_errors = [])
 
+    def test_forward_declaration_impossible_with_typedef_of_pointer_after_pointer(self):
+        self.assert_result_with_header_files(
+            main_file_lines_without_includes = [
+                'typedef Foo* FooPtr;',
+                'void FooFunc(Foo*);',
+                'void BarFunc(FooPtr);'
+            ],
+            project_header_lines = [
+                'class Foo {};'
+            ],
+            expected_errors = [])
+
     def test_forward_declaration_possible_with_enum_class(self):
         self.assert_result_with_header_files(
             main_file_lines_without_includes = [
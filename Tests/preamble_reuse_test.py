@@ -0,0 +1,116 @@
+import test_support
+import os
+import subprocess
+
+class PreambleReuseTest(test_support.TestBase):
+    def prepare_files(self, build_dir):
+        source_files_data = {
+            'common.h': [
+                '#pragma once',
+                '#warning common header warning',
+                'void Foo();',
+                'void Bar();'
+            ],
+            'other.h': [
+                '#ifndef OTHER_H',
+                '#define OTHER_H',
+                'void Baz();',
+                '#endif'
+            ],
+            'one.cpp': [
+                '// comment before includes',
+                '#include "common.h"',
+                '#include "other.h"',
+                'void Foo() {}',
+                'void one_function() {}'
+            ],
+            'two.cpp': [
+                '#include "common.h"',
+                '#include "other.h"',
+                'void Baz() {}',
+                'void two_function() {}'
+            ],
+            'three.cpp': [
+                '#include "other.h"',
+                'void three_function() {}'
+            ],
+            'fake_header_sources/common.cpp': [
+                '#include "common.h"'
+            ]
+        }
+        for file_subpath, lines in source_files_data.items():
+            test_support.mkdir_p(os.path.join(build_dir, os.path.dirname(file_subpath)))
+            test_support.write_file_lines(os.path.join(build_dir, file_subpath), lines)
+
+        source_files = [os.path.join(build_dir, file_subpath)
+                        for file_subpath in ['one.cpp', 'two.cpp', 'three.cpp', 'fake_header_sources/common.cpp']]
+        test_support.write_compilation_database(
+            build_directory = build_dir,
+            source_file_names = source_files,
+            additional_compile_flags = ['-I' + build_dir])
+        return source_files
+
+    def run_colobot_lint(self, build_dir, source_files, additional_options):
+        command = ([test_support.colobot_lint_exectuable] +
+                   ['-p', build_dir] +
+                   ['-output-format', 'xml'] +
+                   ['-only-rule', 'FunctionNamingRule', '-only-rule', 'UndefinedFunctionRule'] +
+                   ['-project-local-include-path', build_dir, '-j', '2'] +
+                   additional_options +
+                   source_files)
+
+        process = subprocess.Popen(command, stdout = subprocess.PIPE, stderr = subprocess.PIPE)
+        output, error_output = process.communicate()
+        self.assertEqual(process.returncode, 0)
+        return output, error_output.decode('utf-8')
+
+    def test_output_is_same_with_reused_preambles(self):
+        with test_support.TempBuildDir() as build_dir:
+            source_files = self.prepare_files(build_dir)
+
+            output, _ = self.run_colobot_lint(build_dir, source_files, [])
+            preamble_output, _ = self.run_colobot_lint(build_dir, source_files, ['-reuse-preambles'])
+            self.assertEqual(preamble_output, output)
+
+            self.assert_xml_output_match(
+                preamble_output,
+                [
+                    {
+                        'id': 'compile warning',
+                        'severity': 'warning',
+                        'msg': 'common header warning',
+                        'line': '2'
+                    },
+                    {
+                        'id': 'function naming',
+                        'severity': 'style',
+                        'msg': "Function 'one_function' should be named in UpperCamelCase style",
+                        'line': '5'
+                    },
+                    {
+                        'id': 'function naming',
+                        'severity': 'style',
+                        'msg': "Function 'two_function' should be named in UpperCamelCase style",
+                        'line': '4'
+                    },
+                    {
+                        'id': 'function naming',
+                        'severity': 'style',
+                        'msg': "Function 'three_function' should be named in UpperCamelCase style",
+                        'line': '2'
+                    },
+                    {
+                        'id': 'undefined function',
+                        'severity': 'information',
+                        'msg': "Function 'Bar' declared but never defined",
+                        'line': '4'
+                    }
+                ])
+
+    def test_preamble_statistics(self):
+        with test_support.TempBuildDir() as build_dir:
+            source_files = self.prepare_files(build_dir)
+
+            # only one.cpp and two.cpp start with the same includes
+            _, error_output = self.run_colobot_lint(build_dir, source_files, ['-reuse-preambles'])
+            self.assertIn('Preambles: 1 precompiled, 0 failed; 1 hits, 3 misses', error_output)
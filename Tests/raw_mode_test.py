@@ -0,0 +1,129 @@
+import test_support
+import os
+import subprocess
+
+class RawModeTest(test_support.TestBase):
+    def run_raw_mode(self, build_dir, source_files_data, arguments):
+        for file_subpath, lines in source_files_data.items():
+            test_support.mkdir_p(os.path.join(build_dir, os.path.dirname(file_subpath)))
+            test_support.write_file_lines(os.path.join(build_dir, file_subpath), lines)
+
+        command = ([test_support.colobot_lint_exectuable, '-raw', '-output-format', 'xml', '-j', '2'] +
+                   [argument.replace('$TEMP_DIR', build_dir) for argument in arguments])
+
+        process = subprocess.Popen(command, stdout = subprocess.PIPE, stderr = subprocess.PIPE)
+        output, _ = process.communicate()
+        return process.returncode, output
+
+    def test_text_rules_without_compilation_database(self):
+        with test_support.TempBuildDir() as build_dir:
+            license_file = os.path.join(build_dir, 'license.txt')
+            test_support.write_file_lines(license_file, ['// License'])
+
+            return_code, output = self.run_raw_mode(
+                build_dir,
+                {
+                    'src/main.cpp': [
+                        '// License',
+                        'This is not even C++ code;   ',
+                        '/* TODO: first',
+                        '   TODO: second */',
+                        ''
+                    ],
+                    'src/a.h': [
+                        '// License',
+                        '\tint x;',
+                        ''
+                    ],
+                    'src/b.h': [
+                        '// Bad license',
+                        ''
+                    ]
+                },
+                ['-license-template-file', license_file, '$TEMP_DIR/src/main.cpp', '$TEMP_DIR/src/*.h'])
+
+            self.assertEqual(return_code, 0)
+            self.assert_xml_output_match(
+                output,
+                [
+                    {
+                        'id': 'TODO comment',
+                        'severity': 'information',
+                        'msg': 'TODO: first',
+                        'line': '3'
+                    },
+                    {
+                        'id': 'TODO comment',
+                        'severity': 'information',
+                        'msg': 'TODO: second',
+                        'line': '4'
+                    },
+                    {
+                        'id': 'whitespace',
+                        'severity': 'style',
+                        'msg': 'Whitespace at end of line',
+                        'line': '2'
+                    },
+                    {
+                        'id': 'whitespace',
+                        'severity': 'style',
+                        'msg': 'Tab character is not allowed as whitespace',
+                        'line': '2'
+                    },
+                    {
+                        'id': 'license header',
+                        'severity': 'style',
+                        'msg': "File doesn't have proper license header; expected line was '// License'",
+                        'line': '1'
+                    }
+                ])
+
+    def test_only_text_rules_can_be_selected(self):
+        with test_support.TempBuildDir() as build_dir:
+            return_code, _ = self.run_raw_mode(
+                build_dir,
+                {
+                    'main.cpp': ['']
+                },
+                ['-only-rule', 'FunctionNamingRule', '$TEMP_DIR/main.cpp'])
+
+            self.assertEqual(return_code, 1)
+
+    def test_todo_comments_in_exclusion_zones_are_skipped(self):
+        with test_support.TempBuildDir() as build_dir:
+            return_code, output = self.run_raw_mode(
+                build_dir,
+                {
+                    'main.cpp': [
+                        '// TODO: reported',
+                        '// @colobot-lint-exclude TodoRule',
+                        '// TODO: excluded by rule name',
+                        '// @end-colobot-lint-exclude',
+                        '// @colobot-lint-exclude *',
+                        '/* TODO: excluded by wildcard */',
+                        '// @end-colobot-lint-exclude',
+                        '// @colobot-lint-exclude WhitespaceRule',
+                        '// TODO: in zone of other rule',
+                        '// @end-colobot-lint-exclude',
+                        ''
+                    ]
+                },
+                ['-only-rule', 'TodoRule', '$TEMP_DIR/main.cpp'])
+
+            self.assertEqual(return_code, 0)
+            self.assert_xml_output_match(
+                output,
+                [
+                    {
+                        'id': 'TODO comment',
+                        'severity': 'information',
+                        'msg': 'TODO: reported',
+                        'line': '1'
+                    },
+                    {
+                        'id': 'TODO comment',
+                        'severity': 'information',
+                        'msg': 'TODO: in zone of other rule',
+                        'line': '9'
+                    }
+                ])
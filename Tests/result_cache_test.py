@@ -0,0 +1,71 @@
+import test_support
+import os
+import subprocess
+
+class ResultCacheTest(test_support.TestBase):
+    def run_with_cache(self, build_dir, cache_dir):
+        command = ([test_support.colobot_lint_exectuable] +
+                   ['-p', build_dir] +
+                   ['-output-format', 'xml'] +
+                   ['-only-rule', 'FunctionNamingRule'] +
+                   ['-project-local-include-path', build_dir] +
+                   ['-cache-dir', cache_dir, '-verbose'] +
+                   [os.path.join(build_dir, 'one.cpp'), os.path.join(build_dir, 'two.cpp')])
+
+        process = subprocess.Popen(command, stdout = subprocess.PIPE, stderr = subprocess.PIPE)
+        output, verbose_output = process.communicate()
+        self.assertEqual(process.returncode, 0)
+        return output, verbose_output.decode('utf-8')
+
+    def prepare_files(self, build_dir, header_lines):
+        test_support.write_file_lines(os.path.join(build_dir, 'header.h'), header_lines)
+        test_support.write_file_lines(os.path.join(build_dir, 'one.cpp'), ['#include "header.h"', 'void one_function() {}'])
+        test_support.write_file_lines(os.path.join(build_dir, 'two.cpp'), ['void two_function() {}'])
+        test_support.write_compilation_database(
+            build_directory = build_dir,
+            source_file_names = [os.path.join(build_dir, 'one.cpp'), os.path.join(build_dir, 'two.cpp')])
+
+    def test_cached_results_are_reused(self):
+        with test_support.TempBuildDir() as build_dir, test_support.TempBuildDir() as cache_dir:
+            self.prepare_files(build_dir, ['void HeaderFunction();'])
+
+            first_output, first_verbose_output = self.run_with_cache(build_dir, cache_dir)
+            self.assertNotIn('Using cached results', first_verbose_output)
+
+            second_output, second_verbose_output = self.run_with_cache(build_dir, cache_dir)
+            self.assertIn('Using cached results for ' + os.path.join(build_dir, 'one.cpp'), second_verbose_output)
+            self.assertIn('Using cached results for ' + os.path.join(build_dir, 'two.cpp'), second_verbose_output)
+            self.assertEqual(first_output, second_output)
+
+    def test_cached_results_are_invalidated_by_header_change(self):
+        with test_support.TempBuildDir() as build_dir, test_support.TempBuildDir() as cache_dir:
+            self.prepare_files(build_dir, ['void HeaderFunction();'])
+            self.run_with_cache(build_dir, cache_dir)
+
+            self.prepare_files(build_dir, ['void header_function() {}'])
+            output, verbose_output = self.run_with_cache(build_dir, cache_dir)
+            self.assertNotIn('Using cached results for ' + os.path.join(build_dir, 'one.cpp'), verbose_output)
+            self.assertIn('Using cached results for ' + os.path.join(build_dir, 'two.cpp'), verbose_output)
+
+            self.assert_xml_output_match(
+                output,
+                [
+                    {
+                        'id': 'function naming',
+                        'severity': 'style',
+                        'msg': "Function 'header_function' should be named in UpperCamelCase style",
+                        'line': '1'
+                    },
+                    {
+                        'id': 'function naming',
+                        'severity': 'style',
+                        'msg': "Function 'one_function' should be named in UpperCamelCase style",
+                        'line': '2'
+                    },
+                    {
+                        'id': 'function naming',
+                        'severity': 'style',
+                        'msg': "Function 'two_function' should be named in UpperCamelCase style",
+                        'line': '1'
+                    }
+                ])
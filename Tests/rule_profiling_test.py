@@ -0,0 +1,47 @@
+import test_support
+import json
+import os
+
+class RuleProfilingTest(test_support.TestBase):
+    def run_with_profiling(self, additional_options):
+        with test_support.TempBuildDir() as profile_dir:
+            profile_file = os.path.join(profile_dir, 'profile.json')
+            test_support.run_colobot_lint_with_prepared_files(
+                source_files_data = {
+                    'one.cpp': [
+                        '// TODO: something',
+                        'void one_function() {}',
+                        'int* OneFunction() { return new int; }'
+                    ],
+                    'two.cpp': [
+                        'void two_function() {}'
+                    ]
+                },
+                compilation_database_files = ['one.cpp', 'two.cpp'],
+                target_files = ['one.cpp', 'two.cpp'],
+                rules_selection = ['FunctionNamingRule', 'NakedNewRule', 'TodoRule'],
+                additional_options = ['-profile-rules-file', profile_file] + additional_options)
+
+            with open(profile_file) as f:
+                return dict((rule['name'], rule) for rule in json.load(f)['rules'])
+
+    def assert_profile_content(self, profile):
+        self.assertEqual(sorted(profile.keys()), ['FunctionNamingRule', 'NakedNewRule', 'TodoRule'])
+
+        self.assertEqual(profile['FunctionNamingRule']['matchCallbacks']['calls'], 3)
+        self.assertEqual(profile['FunctionNamingRule']['locationChecks']['calls'], 3)
+        self.assertEqual(profile['NakedNewRule']['matchCallbacks']['calls'], 1)
+        self.assertEqual(profile['TodoRule']['matchCallbacks']['calls'], 0)
+        self.assertEqual(profile['TodoRule']['preprocessorCallbacks']['calls'], 1)
+
+        for rule in profile.values():
+            self.assertTrue(rule['totalTimeMs'] >= rule['matchCallbacks']['timeMs'])
+
+    def test_serial_profile(self):
+        self.assert_profile_content(self.run_with_profiling(['-j', '1']))
+
+    def test_parallel_profile(self):
+        self.assert_profile_content(self.run_with_profiling(['-j', '2']))
+
+    def test_worker_processes_profile(self):
+        self.assert_profile_content(self.run_with_profiling(['-j', '2', '-worker-processes']))
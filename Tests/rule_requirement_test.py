@@ -0,0 +1,70 @@
+import test_support
+
+class RuleRequirementTest(test_support.TestBase):
+    def test_semantic_errors_are_not_reported_without_ast_rules(self):
+        self.assert_colobot_lint_result(
+            source_file_lines = [
+                '// TODO: comment',
+                'void Foo()',
+                '{',
+                '    undeclared_variable = 0;   ',
+                '}',
+                ''
+            ],
+            rules_selection = ['TodoRule', 'WhitespaceRule'],
+            expected_errors = [
+                {
+                    'id': 'TODO comment',
+                    'severity': 'information',
+                    'msg': 'TODO: comment',
+                    'line': '1'
+                },
+                {
+                    'id': 'whitespace',
+                    'severity': 'style',
+                    'msg': 'Whitespace at end of line',
+                    'line': '4'
+                }
+            ])
+
+    def test_semantic_errors_are_reported_with_ast_rule(self):
+        self.assert_colobot_lint_result(
+            source_file_lines = [
+                '// TODO: comment',
+                'void Foo()',
+                '{',
+                '    undeclared_variable = 0;',
+                '}',
+                ''
+            ],
+            rules_selection = ['TodoRule', 'FunctionNamingRule'],
+            expected_errors = [
+                {
+                    'id': 'TODO comment',
+                    'severity': 'information',
+                    'msg': 'TODO: comment',
+                    'line': '1'
+                },
+                {
+                    'id': 'compile error',
+                    'severity': 'error',
+                    'msg': "use of undeclared identifier 'undeclared_variable'",
+                    'line': '4'
+                }
+            ])
+
+    def test_preprocessor_errors_are_reported_without_ast_rules(self):
+        self.assert_colobot_lint_result(
+            source_file_lines = [
+                '#include "missing_header.h"',
+                ''
+            ],
+            rules_selection = ['TodoRule'],
+            expected_errors = [
+                {
+                    'id': 'compile error',
+                    'severity': 'error',
+                    'msg': "'missing_header.h' file not found",
+                    'line': '1'
+                }
+            ])
@@ -30,9 +30,14 @@ if options.filter:
 if len(remaining_args) == 0:
     remaining_args = ['discover', '-s', this_dir, '-t', this_dir, '-p', '*_test.py']
 
+env = { 'COLOBOT_LINT': os.path.realpath(options.colobot_lint_executable),
+        'DEBUG': '1' if options.debug_flag else '0' }
+# performance tests record their baseline when asked to
+if 'COLOBOT_LINT_UPDATE_PERFORMANCE_BASELINE' in os.environ:
+    env['COLOBOT_LINT_UPDATE_PERFORMANCE_BASELINE'] = os.environ['COLOBOT_LINT_UPDATE_PERFORMANCE_BASELINE']
+
 code = subprocess.call([python_interp, '-m', 'unittest'] + remaining_args,
                        cwd = this_dir,
-                       env = { 'COLOBOT_LINT': os.path.realpath(options.colobot_lint_executable),
-                               'DEBUG': '1' if options.debug_flag else '0' })
+                       env = env)
 
 sys.exit(code)
\ No newline at end of file
@@ -0,0 +1,139 @@
+import test_support
+import os
+import subprocess
+
+class ShardMergeTest(test_support.TestBase):
+    def run_shard(self, shard):
+        return test_support.run_colobot_lint_with_prepared_files(
+            source_files_data = {
+                'header.h': [
+                    'void Foo();',
+                    'void Bar();',
+                    'int Unused(int x) { return; }'
+                ],
+                'one.cpp': [
+                    '#include "header.h"',
+                    'void Foo() {}',
+                    'void one_function() {}'
+                ],
+                'two.cpp': [
+                    '#include "header.h"',
+                    'void Baz();',
+                    'void two_function() {}'
+                ],
+                'three.cpp': [
+                    '#include "header.h"',
+                    'void Baz() {}',
+                    'void three_function() {}'
+                ],
+                'fake_header_sources/header.cpp': [
+                    '#include "header.h"'
+                ]
+            },
+            compilation_database_files = ['one.cpp', 'two.cpp', 'three.cpp', 'fake_header_sources/header.cpp'],
+            target_files = ['one.cpp', 'two.cpp', 'three.cpp', 'fake_header_sources/header.cpp'],
+            rules_selection = ['FunctionNamingRule', 'UndefinedFunctionRule'],
+            additional_compile_flags = ['-I$TEMP_DIR'],
+            additional_options = ['-project-local-include-path', '$TEMP_DIR', '-shard', shard])
+
+    def merge_reports(self, reports):
+        with test_support.TempBuildDir() as temp_dir:
+            report_files = []
+            for index, report in enumerate(reports):
+                report_file = os.path.join(temp_dir, 'report{0}'.format(index))
+                with open(report_file, 'wb') as f:
+                    f.write(report)
+                report_files.append(report_file)
+
+            return subprocess.check_output([test_support.colobot_lint_exectuable, '-merge',
+                                            '-output-format', 'xml'] + report_files)
+
+    def assert_merged_output(self, xml_output):
+        self.assert_xml_output_match(
+            xml_output,
+            [
+                {
+                    'id': 'compile error',
+                    'severity': 'error',
+                    'msg': 'non-void function \'Unused\' should return a value',
+                    'line': '3'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'one_function' should be named in UpperCamelCase style",
+                    'line': '3'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'three_function' should be named in UpperCamelCase style",
+                    'line': '3'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'two_function' should be named in UpperCamelCase style",
+                    'line': '3'
+                },
+                {
+                    'id': 'undefined function',
+                    'severity': 'information',
+                    'msg': "Function 'Bar' declared but never defined",
+                    'line': '2'
+                }
+            ])
+
+    def test_merge_xml_shard_reports(self):
+        for shard_count in [2, 3, 4]:
+            reports = [self.run_shard('{0}/{1}'.format(i, shard_count)) for i in range(1, shard_count + 1)]
+            self.assert_merged_output(self.merge_reports(reports))
+
+    def test_merge_plain_shard_reports(self):
+        reports = [
+            b'\n'.join([
+                b"[error] [compile error] header.h:3 non-void function 'Unused' should return a value",
+                b"[style] [function naming] two.cpp:3 Function 'two_function' should be named in UpperCamelCase style",
+                b'[translation unit] 1 two.cpp',
+                b'[declared function] header.h:1 Foo',
+                b'[declared function] header.h:2 Bar',
+                b'[declared function] two.cpp:2 Baz',
+                b''
+            ]),
+            b'\n'.join([
+                b"[error] [compile error] header.h:3 non-void function 'Unused' should return a value",
+                b"[style] [function naming] one.cpp:3 Function 'one_function' should be named in UpperCamelCase style",
+                b"[style] [function naming] three.cpp:3 Function 'three_function' should be named in UpperCamelCase style",
+                b'[translation unit] 0 one.cpp',
+                b'[defined function] Foo',
+                b'[declared function] header.h:2 Bar',
+                b'[translation unit] 2 three.cpp',
+                b'[defined function] Baz',
+                b'[declared function] header.h:1 Foo',
+                b'[declared function] header.h:2 Bar',
+                b''
+            ])
+        ]
+        self.assert_merged_output(self.merge_reports(reports))
+
+    def test_merge_deduplicates_violations(self):
+        reports = [self.run_shard('{0}/2'.format(i)) for i in [1, 2]]
+        self.assert_merged_output(self.merge_reports(reports + reports))
+
+    def test_shard_reports_do_not_contain_undefined_functions(self):
+        self.assert_xml_output_match(
+            self.run_shard('2/2'),
+            [
+                {
+                    'id': 'compile error',
+                    'severity': 'error',
+                    'msg': 'non-void function \'Unused\' should return a value',
+                    'line': '3'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'two_function' should be named in UpperCamelCase style",
+                    'line': '3'
+                }
+            ])
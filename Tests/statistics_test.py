@@ -0,0 +1,89 @@
+import test_support
+import os
+import re
+import subprocess
+
+class StatisticsTest(test_support.TestBase):
+    def run_with_stats(self, additional_options, rule = 'FunctionNamingRule', source_files_data = None):
+        if source_files_data is None:
+            source_files_data = {
+                'one.cpp': [
+                    'void one_function() {}',
+                    'void OneFunction() {}'
+                ],
+                'two.cpp': [
+                    'void TwoFunction() {}'
+                ]
+            }
+
+        with test_support.TempBuildDir() as build_dir:
+            for file_subpath, lines in source_files_data.items():
+                test_support.write_file_lines(os.path.join(build_dir, file_subpath), lines)
+
+            source_files = [os.path.join(build_dir, file_subpath) for file_subpath in ['one.cpp', 'two.cpp']]
+            test_support.write_compilation_database(
+                build_directory = build_dir,
+                source_file_names = source_files)
+
+            # one.cpp is given twice, so that it is skipped the second time
+            command = ([test_support.colobot_lint_exectuable] +
+                       ['-p', build_dir, '-output-format', 'xml', '-stats'] +
+                       ['-only-rule', rule] +
+                       additional_options +
+                       source_files + [source_files[0]])
+
+            process = subprocess.Popen(command, stdout = subprocess.PIPE, stderr = subprocess.PIPE)
+            _, error_output = process.communicate()
+            self.assertEqual(process.returncode, 0)
+            return error_output.decode('utf-8')
+
+    def get_counter(self, error_output, name):
+        match = re.search(r'^' + re.escape(name) + r'\s+(\d+)', error_output, re.MULTILINE)
+        self.assertIsNotNone(match, name)
+        return int(match.group(1))
+
+    def assert_statistics(self, error_output):
+        self.assertEqual(self.get_counter(error_output, 'Source files processed'), 2)
+        self.assertEqual(self.get_counter(error_output, 'Source files skipped as already processed'), 1)
+        self.assertEqual(self.get_counter(error_output, 'Violations printed'), 1)
+        self.assertEqual(self.get_counter(error_output, 'Violations dropped by output filters'), 0)
+        self.assertTrue(self.get_counter(error_output, 'Location checks') >= 3)
+
+        match = re.search(r'^FunctionNamingRule\s+(\d+)\s+(\d+)$', error_output, re.MULTILINE)
+        self.assertIsNotNone(match)
+        self.assertTrue(int(match.group(1)) >= 3)
+        self.assertEqual(int(match.group(2)), 3)
+
+    def test_serial_statistics(self):
+        self.assert_statistics(self.run_with_stats(['-j', '1']))
+
+    def test_parallel_statistics(self):
+        self.assert_statistics(self.run_with_stats(['-j', '2']))
+
+    def test_worker_processes_statistics(self):
+        self.assert_statistics(self.run_with_stats(['-j', '2', '-worker-processes']))
+
+    def run_undefined_function_rule_with_stats(self, additional_options):
+        return self.run_with_stats(
+            additional_options,
+            rule = 'UndefinedFunctionRule',
+            source_files_data = {
+                'one.cpp': [
+                    'void Undefined();',
+                    'void DefinedInTwo();'
+                ],
+                'two.cpp': [
+                    'void DefinedInTwo() {}'
+                ]
+            })
+
+    def assert_undefined_function_statistics(self, error_output):
+        # undefined functions are printed tentatively after each source file, but only once in the end
+        self.assertEqual(self.get_counter(error_output, 'Violations printed'), 1)
+        self.assertEqual(self.get_counter(error_output, 'Violations dropped by output filters'), 0)
+
+    def test_serial_undefined_function_statistics(self):
+        self.assert_undefined_function_statistics(self.run_undefined_function_rule_with_stats(['-j', '1']))
+
+    def test_parallel_undefined_function_statistics(self):
+        self.assert_undefined_function_statistics(self.run_undefined_function_rule_with_stats(['-j', '2']))
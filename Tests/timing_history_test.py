@@ -0,0 +1,64 @@
+import test_support
+import os
+
+class TimingHistoryTest(test_support.TestBase):
+    def run_with_timing_history(self, timing_history_file):
+        return test_support.run_colobot_lint_with_prepared_files(
+            source_files_data = {
+                'one.cpp': [
+                    'void one_function() {}'
+                ],
+                'two.cpp': [
+                    'void two_function() {}'
+                ],
+                'three.cpp': [
+                    'void three_function() {}'
+                ]
+            },
+            compilation_database_files = ['one.cpp', 'two.cpp', 'three.cpp'],
+            target_files = ['one.cpp', 'two.cpp', 'three.cpp'],
+            rules_selection = ['FunctionNamingRule'],
+            additional_options = ['-timing-history-file', timing_history_file, '-j', '2'])
+
+    def read_timing_history(self, timing_history_file):
+        entries = {}
+        with open(timing_history_file) as f:
+            for line in f.read().splitlines():
+                if line.startswith('#'):
+                    continue
+                wall_time, peak_memory, source_file = line.split(' ', 2)
+                entries[os.path.basename(source_file)] = (float(wall_time), int(peak_memory))
+        return entries
+
+    def test_timing_history_is_recorded(self):
+        with test_support.TempBuildDir() as history_dir:
+            timing_history_file = os.path.join(history_dir, 'timings.txt')
+            self.run_with_timing_history(timing_history_file)
+
+            entries = self.read_timing_history(timing_history_file)
+            self.assertEqual(sorted(entries.keys()), ['one.cpp', 'three.cpp', 'two.cpp'])
+            for wall_time, peak_memory in entries.values():
+                self.assertTrue(wall_time >= 0.0)
+                self.assertTrue(peak_memory > 0)
+
+    def test_output_does_not_depend_on_timing_history(self):
+        with test_support.TempBuildDir() as history_dir:
+            timing_history_file = os.path.join(history_dir, 'timings.txt')
+            with open(timing_history_file, 'w') as f:
+                f.write('1.0 1 /nonexistent/one.cpp\n')
+
+            first_output = self.run_with_timing_history(timing_history_file)
+            second_output = self.run_with_timing_history(timing_history_file)
+            self.assertEqual(first_output, second_output)
+
+            self.assert_xml_output_match(
+                second_output,
+                [
+                    {
+                        'id': 'function naming',
+                        'severity': 'style',
+                        'msg': "Function '{0}_function' should be named in UpperCamelCase style".format(name),
+                        'line': '1'
+                    }
+                    for name in ['one', 'two', 'three']
+                ])
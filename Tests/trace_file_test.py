@@ -0,0 +1,58 @@
+import test_support
+import json
+import os
+
+class TraceFileTest(test_support.TestBase):
+    def run_with_trace(self, additional_options):
+        with test_support.TempBuildDir() as trace_dir:
+            trace_file = os.path.join(trace_dir, 'trace.json')
+            test_support.run_colobot_lint_with_prepared_files(
+                source_files_data = {
+                    'one.cpp': [
+                        'void OneFunction() {}'
+                    ],
+                    'two.cpp': [
+                        'void TwoFunction() {}'
+                    ]
+                },
+                compilation_database_files = ['one.cpp', 'two.cpp'],
+                target_files = ['one.cpp', 'two.cpp'],
+                rules_selection = ['FunctionNamingRule'],
+                additional_options = ['-trace-file', trace_file] + additional_options)
+
+            with open(trace_file) as f:
+                return json.load(f)['traceEvents']
+
+    def assert_trace_content(self, events):
+        spans = [event for event in events if event['ph'] == 'X']
+        span_names = set(span['name'] for span in spans)
+        for name in ['one.cpp', 'two.cpp', 'BeginSourceFileAction', 'parsing and semantic analysis',
+                     'AST matching', 'FunctionNamingRule::onEndOfTranslationUnit', 'OutputPrinter::Save']:
+            self.assertIn(name, span_names)
+
+        for span in spans:
+            self.assertTrue(span['dur'] >= 0)
+
+        source_file_spans = [span for span in spans if span['cat'] == 'source file']
+        self.assertEqual(len(source_file_spans), 2)
+        for span in source_file_spans:
+            self.assertTrue(span['args']['file'].endswith(span['name']))
+
+        return source_file_spans
+
+    def test_serial_trace(self):
+        source_file_spans = self.assert_trace_content(self.run_with_trace(['-j', '1']))
+        self.assertEqual(set(span['tid'] for span in source_file_spans), {0})
+
+    def test_parallel_trace_has_track_for_each_worker(self):
+        events = self.run_with_trace(['-j', '2'])
+        source_file_spans = self.assert_trace_content(events)
+        # idle worker may take both source files
+        worker_tids = set(span['tid'] for span in source_file_spans)
+        self.assertTrue(worker_tids.issubset({1, 2}))
+
+        track_names = set(event['args']['name'] for event in events if event['ph'] == 'M')
+        self.assertEqual(track_names, {'main'} | set('worker %d' % tid for tid in worker_tids))
+
+    def test_worker_processes_trace(self):
+        self.assert_trace_content(self.run_with_trace(['-j', '2', '-worker-processes']))
@@ -0,0 +1,61 @@
+import test_support
+import os
+import subprocess
+import xml.etree.ElementTree as ET
+
+class TranslationUnitLimitsTest(test_support.TestBase):
+    def run_with_limits(self, limit_options):
+        with test_support.TempBuildDir() as build_dir:
+            # many declarations, so that limits are checked many times during parsing
+            heavy_lines = ['void heavy_function_{0}(int value) {{ int x = value * {0}; (void)x; }}'.format(i)
+                           for i in range(20000)]
+            test_support.write_file_lines(os.path.join(build_dir, 'heavy.cpp'), heavy_lines + [''])
+            test_support.write_file_lines(os.path.join(build_dir, 'light.cpp'), ['void light_function() {}', ''])
+
+            source_files = [os.path.join(build_dir, 'heavy.cpp'), os.path.join(build_dir, 'light.cpp')]
+            test_support.write_compilation_database(
+                build_directory = build_dir,
+                source_file_names = source_files)
+
+            command = ([test_support.colobot_lint_exectuable] +
+                       ['-p', build_dir, '-output-format', 'xml'] +
+                       ['-only-rule', 'FunctionNamingRule'] +
+                       limit_options +
+                       source_files)
+
+            process = subprocess.Popen(command, stdout = subprocess.PIPE, stderr = subprocess.PIPE)
+            output, error_output = process.communicate()
+            self.assertEqual(process.returncode, 0)
+            return output, error_output.decode('utf-8')
+
+    def get_errors(self, output):
+        errors = ET.fromstring(output).find('errors').findall('error')
+        return [(error.get('id'), os.path.basename(error.find('location').get('file'))) for error in errors]
+
+    def test_time_limit_aborts_source_file(self):
+        output, _ = self.run_with_limits(['-tu-time-limit', '0.001'])
+
+        errors = self.get_errors(output)
+        self.assertIn(('lint timeout', 'heavy.cpp'), errors)
+        self.assertNotIn(('function naming', 'heavy.cpp'), errors)
+
+    def test_memory_limit_aborts_source_file(self):
+        output, _ = self.run_with_limits(['-tu-memory-limit', '1'])
+
+        errors = self.get_errors(output)
+        self.assertIn(('lint memory limit', 'heavy.cpp'), errors)
+        self.assertNotIn(('function naming', 'heavy.cpp'), errors)
+
+    def test_source_files_within_limits_are_processed(self):
+        output, _ = self.run_with_limits(['-tu-time-limit', '1000', '-tu-memory-limit', '10000'])
+
+        errors = self.get_errors(output)
+        self.assertEqual(errors.count(('function naming', 'heavy.cpp')), 20000)
+        self.assertEqual(errors.count(('function naming', 'light.cpp')), 1)
+
+    def test_soft_time_limit_is_only_logged(self):
+        output, error_output = self.run_with_limits(['-tu-soft-time-limit', '0.001'])
+
+        self.assertIn('heavy.cpp took', error_output)
+        errors = self.get_errors(output)
+        self.assertEqual(errors.count(('function naming', 'heavy.cpp')), 20000)
@@ -85,6 +85,30 @@ class WhitespaceRuleTest(test_support.TestBase):
                 }
             ])
 
+    def test_long_lines(self):
+        self.assert_colobot_lint_result(
+            source_file_lines = [
+                '// ' + 'x' * 100 + ' ',
+                'int x = 0; // ' + 'y' * 60 + '\t' + 'z' * 70,
+                '// ' + 'w' * 200,
+                'void Foo()\r',
+                ''
+            ],
+            expected_errors = [
+                {
+                    'msg': 'Whitespace at end of line',
+                    'line': '1'
+                },
+                {
+                    'msg': 'Tab character is not allowed as whitespace',
+                    'line': '2'
+                },
+                {
+                    'msg': 'File seems to have DOS style line endings',
+                    'line': '4'
+                }
+            ])
+
     def test_whitespace_error_in_fake_header_mode(self):
         self.assert_colobot_lint_result_with_custom_files(
             source_files_data = {
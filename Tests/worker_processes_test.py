@@ -0,0 +1,127 @@
+import test_support
+import os
+import subprocess
+
+class WorkerProcessesTest(test_support.TestBase):
+    source_files_data = {
+        'header.h': [
+            'void Foo();',
+            'void Bar();'
+        ],
+        'one.cpp': [
+            '#include "header.h"',
+            'void Foo() {}',
+            'void one_function() {}'
+        ],
+        'two.cpp': [
+            '#include "header.h"',
+            'void two_function() {}'
+        ],
+        'three.cpp': [
+            'void three_function() {}'
+        ]
+    }
+
+    source_files = ['one.cpp', 'two.cpp', 'three.cpp']
+
+    rules_selection_options = ['-only-rule', 'FunctionNamingRule', '-only-rule', 'UndefinedFunctionRule']
+
+    def run_with_options(self, additional_options):
+        return test_support.run_colobot_lint_with_prepared_files(
+            source_files_data = self.source_files_data,
+            compilation_database_files = self.source_files,
+            target_files = self.source_files,
+            rules_selection = ['FunctionNamingRule', 'UndefinedFunctionRule'],
+            additional_compile_flags = ['-I$TEMP_DIR'],
+            additional_options = ['-project-local-include-path', '$TEMP_DIR'] + additional_options)
+
+    # worker process dies with SIGKILL when given source file is sent to it, which is reported as lint crash
+    def run_with_crashing_worker(self, crashing_source_file):
+        with test_support.TempBuildDir() as build_dir:
+            for file_name, lines in self.source_files_data.items():
+                test_support.write_file_lines(os.path.join(build_dir, file_name), lines)
+
+            source_paths = [os.path.join(build_dir, file_name) for file_name in self.source_files]
+            test_support.write_compilation_database(
+                build_directory = build_dir,
+                source_file_names = source_paths,
+                additional_compile_flags = ['-I' + build_dir])
+
+            command = ([test_support.colobot_lint_exectuable, '-p', build_dir, '-output-format', 'xml'] +
+                       self.rules_selection_options +
+                       ['-project-local-include-path', build_dir, '-worker-processes', '-j', '2'] +
+                       source_paths)
+
+            env = dict(os.environ)
+            env['COLOBOT_LINT_TEST_CRASH_WORKER_ON'] = crashing_source_file
+
+            process = subprocess.Popen(command, stdout = subprocess.PIPE, stderr = subprocess.PIPE, env = env)
+            output, _ = process.communicate()
+            return process.returncode, output
+
+    def test_output_is_same_as_with_threads(self):
+        thread_output = self.run_with_options(['-j', '2'])
+        for job_count in [1, 2, 4]:
+            self.assertEqual(self.run_with_options(['-worker-processes', '-j', str(job_count)]), thread_output)
+
+    def test_output_content(self):
+        self.assert_xml_output_match(
+            self.run_with_options(['-worker-processes', '-j', '2']),
+            [
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'one_function' should be named in UpperCamelCase style",
+                    'line': '3'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'two_function' should be named in UpperCamelCase style",
+                    'line': '2'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'three_function' should be named in UpperCamelCase style",
+                    'line': '1'
+                },
+                {
+                    'id': 'undefined function',
+                    'severity': 'information',
+                    'msg': "Function 'Bar' declared but never defined",
+                    'line': '2'
+                }
+            ])
+
+    def test_crashed_worker_is_reported_as_lint_crash(self):
+        return_code, output = self.run_with_crashing_worker('three.cpp')
+        self.assertEqual(return_code, 1)
+        self.assert_xml_output_match(
+            output,
+            [
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'one_function' should be named in UpperCamelCase style",
+                    'line': '3'
+                },
+                {
+                    'id': 'function naming',
+                    'severity': 'style',
+                    'msg': "Function 'two_function' should be named in UpperCamelCase style",
+                    'line': '2'
+                },
+                {
+                    'id': 'lint crash',
+                    'severity': 'error',
+                    'msg': 'Processing of source file failed: worker process killed by signal 9',
+                    'line': '1'
+                },
+                {
+                    'id': 'undefined function',
+                    'severity': 'information',
+                    'msg': "Function 'Bar' declared but never defined",
+                    'line': '2'
+                }
+            ])